@@ -265,11 +265,116 @@ ClassDB::ClassInfo::ClassInfo() {
 	inherits_ptr = NULL;
 	disabled = false;
 	exposed = false;
+	flat = NULL;
+	flat_inherited = false;
 }
 
 ClassDB::ClassInfo::~ClassInfo() {
 }
 
+Mutex *ClassDB::flat_lock = NULL;
+List<ClassDB::FlatInfo *> ClassDB::flat_retired;
+
+ClassDB::FlatInfo *ClassDB::_build_flat(ClassInfo *p_type) {
+
+	MutexLock flat_guard(flat_lock);
+
+	if (p_type->flat) //another thread got here first
+		return p_type->flat;
+
+	FlatInfo *flat = memnew(FlatInfo);
+
+	for (ClassInfo *check = p_type; check; check = check->inherits_ptr) {
+
+		const StringName *K = NULL;
+		while ((K = check->method_map.next(K))) {
+
+			MethodBind **existing = flat->method_map.getptr(*K);
+			if (!existing) {
+				flat->method_map[*K] = check->method_map[*K];
+			} else if (!*existing) {
+				*existing = check->method_map[*K]; //same as get_method(), skip NULL entries
+			}
+		}
+
+		// get_property() checks properties before constants at each level, and
+		// the closest level wins, so both are merged from the most derived class up.
+		K = NULL;
+		while ((K = check->property_setget.next(K))) {
+
+			if (!flat->property_setget.has(*K)) {
+				flat->property_setget[*K] = check->property_setget.getptr(*K);
+			}
+		}
+
+		K = NULL;
+		while ((K = check->constant_map.next(K))) {
+
+			if (!flat->property_setget.has(*K) && !flat->property_constant_map.has(*K)) {
+				flat->property_constant_map[*K] = check->constant_map[*K];
+			}
+		}
+
+		if (check != p_type) {
+			check->flat_inherited = true;
+		}
+	}
+
+	p_type->flat = flat;
+	return flat;
+}
+
+void ClassDB::_invalidate_flat(ClassInfo *p_type) {
+
+	// Called with the write lock held. Lookups that skip the lock may still hold a
+	// pointer to a stale table, so those are retired rather than freed until cleanup().
+
+	if (!p_type->flat && !p_type->flat_inherited)
+		return; //common case while registering classes
+
+	MutexLock flat_guard(flat_lock);
+
+	if (p_type->flat) {
+		flat_retired.push_back(p_type->flat);
+		p_type->flat = NULL;
+	}
+
+	if (!p_type->flat_inherited)
+		return;
+
+	const StringName *k = NULL;
+	while ((k = classes.next(k))) {
+
+		ClassInfo *ti = &classes[*k];
+		if (!ti->flat)
+			continue;
+
+		for (ClassInfo *check = ti->inherits_ptr; check; check = check->inherits_ptr) {
+			if (check == p_type) {
+				flat_retired.push_back(ti->flat);
+				ti->flat = NULL;
+				break;
+			}
+		}
+	}
+
+	p_type->flat_inherited = false;
+}
+
+MethodBind *ClassDB::_find_method(ClassInfo *p_type, const StringName &p_name) {
+
+	ClassInfo *type = p_type;
+
+	while (type) {
+
+		MethodBind **method = type->method_map.getptr(p_name);
+		if (method && *method)
+			return *method;
+		type = type->inherits_ptr;
+	}
+	return NULL;
+}
+
 bool ClassDB::is_parent_class(const StringName &p_class, const StringName &p_inherits) {
 
 	OBJTYPE_RLOCK;
@@ -656,15 +761,11 @@ MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 	OBJTYPE_RLOCK;
 
 	ClassInfo *type = classes.getptr(p_class);
+	if (!type)
+		return NULL;
 
-	while (type) {
-
-		MethodBind **method = type->method_map.getptr(p_name);
-		if (method && *method)
-			return *method;
-		type = type->inherits_ptr;
-	}
-	return NULL;
+	MethodBind **method = _get_flat(type)->method_map.getptr(p_name);
+	return method ? *method : NULL;
 }
 
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int p_constant) {
@@ -681,6 +782,7 @@ void ClassDB::bind_integer_constant(const StringName &p_class, const StringName
 	}
 
 	type->constant_map[p_name] = p_constant;
+	_invalidate_flat(type);
 
 	String enum_name = p_enum;
 	if (enum_name != String()) {
@@ -919,7 +1021,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 
 	MethodBind *mb_set = NULL;
 	if (p_setter) {
-		mb_set = get_method(p_class, p_setter);
+		mb_set = _find_method(type, p_setter); //not get_method(), avoids building lookup tables mid-registration
 #ifdef DEBUG_METHODS_ENABLED
 
 		ERR_FAIL_COND_MSG(!mb_set, "Invalid setter '" + p_class + "::" + p_setter + "' for property '" + p_pinfo.name + "'.");
@@ -932,7 +1034,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 	MethodBind *mb_get = NULL;
 	if (p_getter) {
 
-		mb_get = get_method(p_class, p_getter);
+		mb_get = _find_method(type, p_getter);
 #ifdef DEBUG_METHODS_ENABLED
 
 		ERR_FAIL_COND_MSG(!mb_get, "Invalid getter '" + p_class + "::" + p_getter + "' for property '" + p_pinfo.name + "'.");
@@ -966,6 +1068,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 	psg.type = p_pinfo.type;
 
 	type->property_setget[p_pinfo.name] = psg;
+	_invalidate_flat(type);
 }
 
 void ClassDB::set_property_default_value(StringName p_class, const StringName &p_name, const Variant &p_default) {
@@ -1002,10 +1105,10 @@ void ClassDB::get_property_list(StringName p_class, List<PropertyInfo> *p_list,
 bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
 
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
+	if (type) {
+		const PropertySetGet *const *psgp = _get_flat(type)->property_setget.getptr(p_property);
+		if (psgp) {
+			const PropertySetGet *psg = *psgp;
 
 			if (!psg->setter) {
 				if (r_valid)
@@ -1039,8 +1142,6 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 
 			return true;
 		}
-
-		check = check->inherits_ptr;
 	}
 
 	return false;
@@ -1048,10 +1149,19 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
+	if (type) {
+		FlatInfo *flat = _get_flat(type);
+
+		const int *c = flat->property_constant_map.getptr(p_property);
+		if (c) {
+
+			r_value = *c;
+			return true;
+		}
+
+		const PropertySetGet *const *psgp = flat->property_setget.getptr(p_property);
+		if (psgp) {
+			const PropertySetGet *psg = *psgp;
 			if (!psg->getter)
 				return true; //return true but do nothing
 
@@ -1073,15 +1183,6 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 			}
 			return true;
 		}
-
-		const int *c = check->constant_map.getptr(p_property);
-		if (c) {
-
-			r_value = *c;
-			return true;
-		}
-
-		check = check->inherits_ptr;
 	}
 
 	return false;
@@ -1090,18 +1191,15 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
 
 	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+	if (type) {
+		const PropertySetGet *const *psg = _get_flat(type)->property_setget.getptr(p_property);
 		if (psg) {
 
 			if (r_is_valid)
 				*r_is_valid = true;
 
-			return psg->index;
+			return (*psg)->index;
 		}
-
-		check = check->inherits_ptr;
 	}
 	if (r_is_valid)
 		*r_is_valid = false;
@@ -1112,18 +1210,15 @@ int ClassDB::get_property_index(const StringName &p_class, const StringName &p_p
 Variant::Type ClassDB::get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
 
 	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+	if (type) {
+		const PropertySetGet *const *psg = _get_flat(type)->property_setget.getptr(p_property);
 		if (psg) {
 
 			if (r_is_valid)
 				*r_is_valid = true;
 
-			return psg->type;
+			return (*psg)->type;
 		}
-
-		check = check->inherits_ptr;
 	}
 	if (r_is_valid)
 		*r_is_valid = false;
@@ -1131,6 +1226,16 @@ Variant::Type ClassDB::get_property_type(const StringName &p_class, const String
 	return Variant::NIL;
 }
 
+const ClassDB::PropertySetGet *ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property) {
+
+	ClassInfo *type = classes.getptr(p_class);
+	if (!type)
+		return NULL;
+
+	const PropertySetGet *const *psg = _get_flat(type)->property_setget.getptr(p_property);
+	return psg ? *psg : NULL;
+}
+
 StringName ClassDB::get_property_setter(StringName p_class, const StringName &p_property) {
 
 	ClassInfo *type = classes.getptr(p_class);
@@ -1168,17 +1273,13 @@ StringName ClassDB::get_property_getter(StringName p_class, const StringName &p_
 bool ClassDB::has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance) {
 
 	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		if (check->property_setget.has(p_property))
-			return true;
+	if (!type)
+		return false;
 
-		if (p_no_inheritance)
-			break;
-		check = check->inherits_ptr;
-	}
+	if (p_no_inheritance)
+		return type->property_setget.has(p_property);
 
-	return false;
+	return _get_flat(type)->property_setget.has(p_property);
 }
 
 void ClassDB::set_method_flags(StringName p_class, StringName p_method, int p_flags) {
@@ -1194,16 +1295,13 @@ void ClassDB::set_method_flags(StringName p_class, StringName p_method, int p_fl
 bool ClassDB::has_method(StringName p_class, StringName p_method, bool p_no_inheritance) {
 
 	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		if (check->method_map.has(p_method))
-			return true;
-		if (p_no_inheritance)
-			return false;
-		check = check->inherits_ptr;
-	}
+	if (!type)
+		return false;
 
-	return false;
+	if (p_no_inheritance)
+		return type->method_map.has(p_method);
+
+	return _get_flat(type)->method_map.has(p_method);
 }
 
 #ifdef DEBUG_METHODS_ENABLED
@@ -1250,6 +1348,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 #endif
 
 	type->method_map[mdname] = p_bind;
+	_invalidate_flat(type);
 
 	Vector<Variant> defvals;
 
@@ -1434,6 +1533,7 @@ RWLock *ClassDB::lock = NULL;
 void ClassDB::init() {
 
 	lock = RWLock::create();
+	flat_lock = Mutex::create();
 }
 
 void ClassDB::cleanup_defaults() {
@@ -1457,12 +1557,22 @@ void ClassDB::cleanup() {
 
 			memdelete(ti.method_map[*m]);
 		}
+
+		if (ti.flat) {
+			memdelete(ti.flat);
+		}
 	}
 	classes.clear();
+
+	for (List<FlatInfo *>::Element *E = flat_retired.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+	flat_retired.clear();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 
 	memdelete(lock);
+	memdelete(flat_lock);
 }
 
 //
@@ -33,6 +33,7 @@
 
 #include "core/method_bind.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/print_string.h"
 
 /**	To bind more then 6 parameters include this:
@@ -110,6 +111,15 @@ public:
 		Variant::Type type;
 	};
 
+	// Lookup tables merging a class with all of its ancestors, so dynamic calls and
+	// property access are a single probe instead of one per inheritance level.
+	struct FlatInfo {
+
+		HashMap<StringName, MethodBind *> method_map;
+		HashMap<StringName, const PropertySetGet *> property_setget;
+		HashMap<StringName, int> property_constant_map; //constants that shadow a property lookup (checked first by get_property)
+	};
+
 	struct ClassInfo {
 
 		APIType api;
@@ -133,6 +143,8 @@ public:
 		bool disabled;
 		bool exposed;
 		Object *(*creation_func)();
+		FlatInfo *flat; //built on demand by _get_flat()
+		bool flat_inherited; //a descendant has flat tables, so changes to this class must invalidate them
 		ClassInfo();
 		~ClassInfo();
 	};
@@ -157,6 +169,19 @@ public:
 
 	static void _add_class2(const StringName &p_class, const StringName &p_inherits);
 
+	static Mutex *flat_lock;
+	static List<FlatInfo *> flat_retired;
+	static FlatInfo *_build_flat(ClassInfo *p_type);
+	static void _invalidate_flat(ClassInfo *p_type);
+	static MethodBind *_find_method(ClassInfo *p_type, const StringName &p_name);
+
+	_FORCE_INLINE_ static FlatInfo *_get_flat(ClassInfo *p_type) {
+		FlatInfo *flat = p_type->flat;
+		if (likely(flat))
+			return flat;
+		return _build_flat(p_type);
+	}
+
 	static HashMap<StringName, HashMap<StringName, Variant> > default_values;
 	static Set<StringName> default_values_cached;
 
@@ -318,6 +343,7 @@ public:
 			ERR_FAIL_V_MSG(NULL, "Method already bound: " + instance_type + "::" + p_name + ".");
 		}
 		type->method_map[p_name] = bind;
+		_invalidate_flat(type);
 #ifdef DEBUG_METHODS_ENABLED
 		// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 		//bind->set_return_type("Variant");
@@ -341,6 +367,7 @@ public:
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = NULL);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = NULL);
+	static const PropertySetGet *get_property_setget(const StringName &p_class, const StringName &p_property);
 	static StringName get_property_setter(StringName p_class, const StringName &p_property);
 	static StringName get_property_getter(StringName p_class, const StringName &p_property);
 
@@ -3075,6 +3075,21 @@ Error Image::load_webp_from_buffer(const PoolVector<uint8_t> &p_array) {
 	return _load_from_buffer(p_array, _webp_mem_loader_func);
 }
 
+// Same as the lossless/lossy unpackers, for data that is not in a PoolVector (like a mapped file).
+Ref<Image> Image::unpack_from_memory(const uint8_t *p_data, int p_size) {
+
+	ERR_FAIL_COND_V(p_size < 4, Ref<Image>());
+
+	if (p_data[0] == 'P' && p_data[1] == 'N' && p_data[2] == 'G' && p_data[3] == ' ' && _png_mem_loader_func) {
+		return _png_mem_loader_func(p_data + 4, p_size - 4);
+	}
+	if (p_data[0] == 'W' && p_data[1] == 'E' && p_data[2] == 'B' && p_data[3] == 'P' && _webp_mem_loader_func) {
+		return _webp_mem_loader_func(p_data + 4, p_size - 4);
+	}
+
+	return Ref<Image>();
+}
+
 Error Image::_load_from_buffer(const PoolVector<uint8_t> &p_array, ImageMemLoadFunc p_loader) {
 	int buffer_size = p_array.size();
 
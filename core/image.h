@@ -147,6 +147,7 @@ public:
 	static Ref<Image> (*lossy_unpacker)(const PoolVector<uint8_t> &p_buffer);
 	static PoolVector<uint8_t> (*lossless_packer)(const Ref<Image> &p_image);
 	static Ref<Image> (*lossless_unpacker)(const PoolVector<uint8_t> &p_buffer);
+	static Ref<Image> unpack_from_memory(const uint8_t *p_data, int p_size);
 
 	PoolVector<uint8_t>::Write write_lock;
 
@@ -30,6 +30,7 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
 #include "core/print_string.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, int p_block_size) {
@@ -58,21 +59,77 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 		}                                                   \
 	}
 
+// Produces the same data close() writes to the file, magic being exactly 4 characters.
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const uint8_t *p_data, uint32_t p_size, const String &p_magic, Compression::Mode p_mode, int p_block_size) {
+
+	CharString mgc = p_magic.utf8();
+	ERR_FAIL_COND_V(mgc.length() != 4, Vector<uint8_t>());
+
+	int bc = (p_size / p_block_size) + 1;
+	int header_size = 16 + bc * 4;
+
+	Vector<uint8_t> ret;
+	ret.resize(header_size);
+	uint8_t *w = ret.ptrw();
+	copymem(w, mgc.get_data(), 4); //write header 4
+	encode_uint32(p_mode, &w[4]); //write compression mode 4
+	encode_uint32(p_block_size, &w[8]); //write block size 4
+	encode_uint32(p_size, &w[12]); //max amount of data written 4
+
+	Vector<uint8_t> cblock;
+	for (int i = 0; i < bc; i++) {
+
+		int bl = i == (bc - 1) ? p_size % p_block_size : p_block_size;
+		const uint8_t *bp = &p_data[i * p_block_size];
+
+		cblock.resize(Compression::get_max_compressed_buffer_size(bl, p_mode));
+		int s = Compression::compress(cblock.ptrw(), bp, bl, p_mode);
+
+		int ofs = ret.size();
+		ret.resize(ofs + s);
+		copymem(&ret.write[ofs], cblock.ptr(), s);
+		encode_uint32(s, &ret.write[16 + i * 4]); //compressed size of the block
+	}
+
+	int ofs = ret.size();
+	ret.resize(ofs + 4);
+	copymem(&ret.write[ofs], mgc.get_data(), 4); //magic at the end too
+
+	return ret;
+}
+
+void FileAccessCompressed::_read_block(int p_block) const {
+
+	// Decompress in place when the source can provide its bytes that way (like a mapped pack).
+	const uint8_t *src = f->get_buffer_view(read_blocks[p_block].csize);
+	if (!src) {
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+		src = comp_buffer.ptr();
+	}
+	Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, src, read_blocks[p_block].csize, cmode);
+}
+
 Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 
 	f = p_base;
-	cmode = (Compression::Mode)f->get_32();
+	uint32_t mode = f->get_32();
 	block_size = f->get_32();
 	read_total = f->get_32();
-	int bc = (read_total / block_size) + 1;
-	int acc_ofs = f->get_position() + bc * 4;
+	ERR_FAIL_COND_V_MSG(mode > Compression::MODE_GZIP || block_size == 0 || block_size > 0x7FFFFFFF, ERR_FILE_CORRUPT, "Invalid compressed file header.");
+	cmode = (Compression::Mode)mode;
+
+	// The block table and the blocks must fit in what is left of the file.
+	uint32_t bc = (read_total / block_size) + 1;
+	uint64_t acc_ofs = f->get_position() + (uint64_t)bc * 4;
+	ERR_FAIL_COND_V_MSG(acc_ofs > f->get_len(), ERR_FILE_CORRUPT, "Compressed file block table goes past the end of the file.");
 	int max_bs = 0;
-	for (int i = 0; i < bc; i++) {
+	for (uint32_t i = 0; i < bc; i++) {
 
 		ReadBlock rb;
 		rb.offset = acc_ofs;
 		rb.csize = f->get_32();
-		acc_ofs += rb.csize;
+		acc_ofs += (uint32_t)rb.csize;
+		ERR_FAIL_COND_V_MSG(rb.csize < 0 || acc_ofs > f->get_len(), ERR_FILE_CORRUPT, "Compressed file block goes past the end of the file.");
 		max_bs = MAX(max_bs, rb.csize);
 		read_blocks.push_back(rb);
 	}
@@ -80,13 +137,12 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	comp_buffer.resize(max_bs);
 	buffer.resize(block_size);
 	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
 	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
+	_read_block(0);
 	read_block = 0;
 	read_pos = 0;
 
@@ -131,7 +187,11 @@ Error FileAccessCompressed::_open(const String &p_path, int p_mode_flags) {
 			return ERR_FILE_UNRECOGNIZED;
 		}
 
-		open_after_magic(f);
+		err = open_after_magic(f);
+		if (err != OK) {
+			close();
+			return err;
+		}
 	}
 
 	return OK;
@@ -144,36 +204,8 @@ void FileAccessCompressed::close() {
 	if (writing) {
 		//save block table and all compressed blocks
 
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		int bc = (write_max / block_size) + 1;
-
-		for (int i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (int i = 0; i < bc; i++) {
-
-			int bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (int i = 0; i < bc; i++)
-			f->store_32(block_sizes[i]);
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		Vector<uint8_t> data = compress_buffer(write_ptr, write_max, magic, cmode, block_size);
+		f->store_buffer(data.ptr(), data.size());
 
 		buffer.clear();
 
@@ -215,8 +247,7 @@ void FileAccessCompressed::seek(size_t p_position) {
 
 				read_block = block_idx;
 				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+				_read_block(read_block);
 				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 			}
 
@@ -286,8 +317,7 @@ uint8_t FileAccessCompressed::get_8() const {
 
 		if (read_block < read_block_count) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+			_read_block(read_block);
 			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 			read_pos = 0;
 
@@ -309,26 +339,32 @@ int FileAccessCompressed::get_buffer(uint8_t *p_dst, int p_length) const {
 		return 0;
 	}
 
-	for (int i = 0; i < p_length; i++) {
+	int dst_idx = 0;
+	while (dst_idx < p_length) {
+
+		//copy what is left of the current block at once
+		int to_copy = MIN(p_length - dst_idx, read_block_size - read_pos);
+		if (to_copy > 0) {
+			copymem(&p_dst[dst_idx], &read_ptr[read_pos], to_copy);
+			dst_idx += to_copy;
+			read_pos += to_copy;
+		}
 
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
 		if (read_pos >= read_block_size) {
 			read_block++;
 
 			if (read_block < read_block_count) {
 				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+				_read_block(read_block);
 				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 				read_pos = 0;
 
 			} else {
 				read_block--;
 				at_end = true;
-				if (i < p_length - 1)
+				if (dst_idx < p_length)
 					read_eof = true;
-				return i;
+				return dst_idx;
 			}
 		}
 	}
@@ -64,9 +64,13 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	FileAccess *f;
 
+	void _read_block(int p_block) const;
+
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
 
+	static Vector<uint8_t> compress_buffer(const uint8_t *p_data, uint32_t p_size, const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
+
 	Error open_after_magic(FileAccess *p_base);
 
 	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
@@ -30,12 +30,14 @@
 
 #include "file_access_pack.h"
 
+#include "core/crypto/crypto_core.h"
+#include "core/io/file_access_compressed.h"
+#include "core/os/os.h"
+#include "core/project_settings.h"
 #include "core/version.h"
 
 #include <stdio.h>
 
-#define PACK_VERSION 1
-
 Error PackedData::add_pack(const String &p_path, bool p_replace_files) {
 
 	for (int i = 0; i < sources.size(); i++) {
@@ -49,12 +51,32 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files) {
 	return ERR_FILE_UNRECOGNIZED;
 };
 
-void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files) {
+PackedData::PathMD5::PathMD5(const String &p_path) {
+
+	CharString cs = p_path.utf8();
+	uint64_t hash[2];
+	CryptoCore::md5((const uint8_t *)cs.get_data(), cs.length(), (unsigned char *)hash);
+	a = hash[0];
+	b = hash[1];
+}
+
+void PackedData::reserve_paths(uint32_t p_count) {
+
+	// Keep below the map's maximum load, so adding the paths never rehashes.
+	uint64_t capacity = (uint64_t(files.get_num_elements()) + p_count) * 10 / 9 + 1;
+	ERR_FAIL_COND_MSG(capacity > 0xFFFFFFFF, "Too many paths to reserve: " + itos(p_count) + ".");
+	if (capacity > files.get_capacity()) {
+		files.reserve(capacity);
+	}
+}
+
+void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_compressed) {
 
-	PathMD5 pmd5(path.md5_buffer());
+	PathMD5 pmd5(path);
 	//printf("adding path %ls, %lli, %lli\n", path.c_str(), pmd5.a, pmd5.b);
 
-	bool exists = files.has(pmd5);
+	PackedFile *existing = files.lookup_ptr(pmd5);
+	bool exists = existing != NULL;
 
 	PackedFile pf;
 	pf.pack = pkg_path;
@@ -63,9 +85,12 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 	for (int i = 0; i < 16; i++)
 		pf.md5[i] = p_md5[i];
 	pf.src = p_src;
+	pf.compressed = p_compressed;
 
-	if (!exists || p_replace_files)
-		files[pmd5] = pf;
+	if (!exists)
+		files.insert(pmd5, pf);
+	else if (p_replace_files)
+		*existing = pf;
 
 	if (!exists) {
 		//search for dir
@@ -74,20 +99,31 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 
 		if (p.find("/") != -1) { //in a subdir
 
-			Vector<String> ds = p.get_base_dir().split("/");
+			String base_dir = p.get_base_dir();
+
+			if (last_dir && base_dir == last_dir_path) {
+				cd = last_dir;
+			} else {
 
-			for (int j = 0; j < ds.size(); j++) {
+				Vector<String> ds = base_dir.split("/");
 
-				if (!cd->subdirs.has(ds[j])) {
+				for (int j = 0; j < ds.size(); j++) {
 
-					PackedDir *pd = memnew(PackedDir);
-					pd->name = ds[j];
-					pd->parent = cd;
-					cd->subdirs[pd->name] = pd;
-					cd = pd;
-				} else {
-					cd = cd->subdirs[ds[j]];
+					Map<String, PackedDir *>::Element *E = cd->subdirs.find(ds[j]);
+					if (!E) {
+
+						PackedDir *pd = memnew(PackedDir);
+						pd->name = ds[j];
+						pd->parent = cd;
+						cd->subdirs[pd->name] = pd;
+						cd = pd;
+					} else {
+						cd = E->get();
+					}
 				}
+
+				last_dir_path = base_dir;
+				last_dir = cd;
 			}
 		}
 		String filename = path.get_file();
@@ -112,6 +148,7 @@ PackedData::PackedData() {
 	singleton = this;
 	root = memnew(PackedDir);
 	root->parent = NULL;
+	last_dir = NULL;
 	disabled = false;
 
 	add_pack_source(memnew(PackedSourcePCK));
@@ -174,7 +211,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // ver_rev
 
-	if (version != PACK_VERSION) {
+	if (version < 1 || version > PACK_FORMAT_VERSION) {
 		f->close();
 		memdelete(f);
 		ERR_FAIL_V_MSG(false, "Pack version unsupported: " + itos(version) + ".");
@@ -192,6 +229,15 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 
 	int file_count = f->get_32();
 
+	// Only trust the count for reserving when the rest of the pack can hold that many entries
+	// (length of the path, offset, size, MD5 and, since version 2, flags), so a corrupt pack can't
+	// make it allocate a huge map.
+	uint64_t min_entry_size = 4 + 8 + 8 + 16 + (version >= 2 ? 4 : 0);
+	uint64_t max_file_count = f->get_len() > f->get_position() ? (f->get_len() - f->get_position()) / min_entry_size : 0;
+	if (file_count >= 0 && uint64_t(file_count) <= max_file_count) {
+		PackedData::get_singleton()->reserve_paths(file_count);
+	}
+
 	for (int i = 0; i < file_count; i++) {
 
 		uint32_t sl = f->get_32();
@@ -207,19 +253,61 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 		uint64_t size = f->get_64();
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
-		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this, p_replace_files);
+		uint32_t flags = version >= 2 ? f->get_32() : 0;
+		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this, p_replace_files, flags & PACK_FILE_COMPRESSED);
 	};
 
 	f->close();
 	memdelete(f);
+
+	// Files are read from the mapping when the OS supports it, instead of each opening the pack.
+	if (!mappings.has(p_path)) {
+		Mapping mapping;
+		if (OS::get_singleton()->map_file(ProjectSettings::get_singleton()->globalize_path(p_path), mapping.data, mapping.size) == OK) {
+			mappings[p_path] = mapping;
+		}
+	}
+
 	return true;
 };
 
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 
-	return memnew(FileAccessPack(p_path, *p_file));
+	const uint8_t *data = NULL;
+	Map<String, Mapping>::Element *E = mappings.find(p_file->pack);
+	if (E && p_file->offset + p_file->size <= E->get().size) {
+		data = E->get().data + p_file->offset;
+	}
+
+	FileAccess *f = memnew(FileAccessPack(p_path, *p_file, data));
+	if (!p_file->compressed) {
+		return f;
+	}
+
+	// Blocks are decompressed as they are read, on the thread reading the file.
+	char magic[5] = {};
+	f->get_buffer((uint8_t *)magic, 4);
+	if (String(magic) != PACK_COMPRESSED_MAGIC) {
+		memdelete(f);
+		ERR_FAIL_V_MSG(NULL, "Corrupt compressed file in pack: " + p_path + ".");
+	}
+
+	FileAccessCompressed *fac = memnew(FileAccessCompressed);
+	Error err = fac->open_after_magic(f); // takes ownership
+	if (err != OK) {
+		memdelete(fac);
+		ERR_FAIL_V_MSG(NULL, "Corrupt compressed file in pack: " + p_path + ".");
+	}
+	return fac;
 };
 
+PackedSourcePCK::~PackedSourcePCK() {
+
+	for (Map<String, Mapping>::Element *E = mappings.front(); E; E = E->next()) {
+		OS::get_singleton()->unmap_file(E->get().data, E->get().size);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
@@ -230,11 +318,18 @@ Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 
 void FileAccessPack::close() {
 
-	f->close();
+	if (f) {
+		f->close();
+	} else {
+		data = NULL;
+	}
 }
 
 bool FileAccessPack::is_open() const {
 
+	if (!f) {
+		return data != NULL;
+	}
 	return f->is_open();
 }
 
@@ -246,7 +341,9 @@ void FileAccessPack::seek(size_t p_position) {
 		eof = false;
 	}
 
-	f->seek(pf.offset + p_position);
+	if (f) {
+		f->seek(pf.offset + p_position);
+	}
 	pos = p_position;
 }
 void FileAccessPack::seek_end(int64_t p_position) {
@@ -274,6 +371,11 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (!f) {
+		ERR_FAIL_COND_V(!data, 0);
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
@@ -293,14 +395,34 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 
 	if (to_read <= 0)
 		return 0;
+
+	if (!f) {
+		ERR_FAIL_COND_V(!data, 0);
+		copymem(p_dst, data + pos - p_length, to_read);
+		return to_read;
+	}
+
 	f->get_buffer(p_dst, to_read);
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(int p_length) const {
+
+	if (!data || eof || p_length < 0 || pos + p_length > pf.size) {
+		return NULL;
+	}
+
+	const uint8_t *view = data + pos;
+	pos += p_length;
+	return view;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f) {
+		f->set_endian_swap(p_swap);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -330,15 +452,22 @@ bool FileAccessPack::file_exists(const String &p_name) {
 	return false;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_data) :
 		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		f(NULL),
+		data(p_data) {
 
+	pos = 0;
+	eof = false;
+
+	if (data) {
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	pos = 0;
-	eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
@@ -33,10 +33,21 @@
 
 #include "core/list.h"
 #include "core/map.h"
+#include "core/oa_hash_map.h"
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "core/print_string.h"
 
+// Version 2 adds flags to each file entry, version 1 packs are still read.
+#define PACK_FORMAT_VERSION 2
+
+enum PackFileFlags {
+	PACK_FILE_COMPRESSED = 1 << 0, // stored as written by FileAccessCompressed, with PACK_COMPRESSED_MAGIC
+};
+
+#define PACK_COMPRESSED_MAGIC "GCPF"
+#define PACK_COMPRESSED_BLOCK_SIZE 65536
+
 class PackSource;
 
 class PackedData {
@@ -52,6 +63,7 @@ public:
 		uint64_t size;
 		uint8_t md5[16];
 		PackSource *src;
+		bool compressed; // size is the stored size, the file has its own length
 	};
 
 private:
@@ -86,15 +98,25 @@ private:
 			a = *((uint64_t *)&p_buf[0]);
 			b = *((uint64_t *)&p_buf[8]);
 		};
+
+		PathMD5(const String &p_path);
+	};
+
+	struct PathMD5Hasher {
+		static _FORCE_INLINE_ uint32_t hash(const PathMD5 &p_md5) { return uint32_t(p_md5.a); } // already well distributed
 	};
 
-	Map<PathMD5, PackedFile> files;
+	OAHashMap<PathMD5, PackedFile, PathMD5Hasher> files;
 
 	Vector<PackSource *> sources;
 
 	PackedDir *root;
 	//Map<String,PackedDir*> dirs;
 
+	// Packs list files grouped by directory, so the last one looked up is likely the next one too.
+	String last_dir_path;
+	PackedDir *last_dir;
+
 	static PackedData *singleton;
 	bool disabled;
 
@@ -102,7 +124,8 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files); // for PackSource
+	void reserve_paths(uint32_t p_count); // for PackSource, before adding paths
+	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_compressed = false); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -127,9 +150,18 @@ public:
 
 class PackedSourcePCK : public PackSource {
 
+	struct Mapping {
+		const uint8_t *data;
+		uint64_t size;
+	};
+
+	Map<String, Mapping> mappings;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files);
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
+
+	~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -140,6 +172,7 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 
 	FileAccess *f;
+	const uint8_t *data; // set if the pack is mapped, then f is not used
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) { return 0; }
@@ -159,6 +192,7 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_buffer_view(int p_length) const;
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -171,25 +205,24 @@ public:
 
 	virtual bool file_exists(const String &p_name);
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_data = NULL);
 	~FileAccessPack();
 };
 
 FileAccess *PackedData::try_open_path(const String &p_path) {
 
-	PathMD5 pmd5(p_path.md5_buffer());
-	Map<PathMD5, PackedFile>::Element *E = files.find(pmd5);
-	if (!E)
+	PackedFile *pf = files.lookup_ptr(PathMD5(p_path));
+	if (!pf)
 		return NULL; //not found
-	if (E->get().offset == 0)
+	if (pf->offset == 0)
 		return NULL; //was erased
 
-	return E->get().src->get_file(p_path, &E->get());
+	return pf->src->get_file(p_path, pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
 
-	return files.has(PathMD5(p_path.md5_buffer()));
+	return files.has(PathMD5(p_path));
 }
 
 class DirAccessPack : public DirAccess {
@@ -30,6 +30,8 @@
 
 #include "pck_packer.h"
 
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
 #include "core/os/file_access.h"
 #include "core/version.h"
 
@@ -56,7 +58,7 @@ static void _pad(FileAccess *p_file, int p_bytes) {
 void PCKPacker::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment"), &PCKPacker::pck_start, DEFVAL(0));
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path"), &PCKPacker::add_file);
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "compress"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 };
 
@@ -69,7 +71,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment) {
 	alignment = p_alignment;
 
 	file->store_32(0x43504447); // MAGIC
-	file->store_32(1); // # version
+	file->store_32(PACK_FORMAT_VERSION); // # version
 	file->store_32(VERSION_MAJOR); // # major
 	file->store_32(VERSION_MINOR); // # minor
 	file->store_32(0); // # revision
@@ -84,7 +86,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment) {
 	return OK;
 };
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src) {
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_compress) {
 
 	FileAccess *f = FileAccess::open(p_src, FileAccess::READ);
 	if (!f) {
@@ -96,6 +98,7 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src) {
 	pf.src_path = p_src;
 	pf.size = f->get_len();
 	pf.offset_offset = 0;
+	pf.compress = p_compress && pf.size > 0 && pf.size < 0x7FFFFFFF; // the compressed format uses 32 bits sizes
 
 	files.push_back(pf);
 
@@ -118,13 +121,15 @@ Error PCKPacker::flush(bool p_verbose) {
 		file->store_pascal_string(files[i].path);
 		files.write[i].offset_offset = file->get_position();
 		file->store_64(0); // offset
-		file->store_64(files[i].size); // size
+		file->store_64(files[i].size); // size, updated later if compressed
 
 		// # empty md5
 		file->store_32(0);
 		file->store_32(0);
 		file->store_32(0);
 		file->store_32(0);
+
+		file->store_32(files[i].compress ? PACK_FILE_COMPRESSED : 0); // flags
 	};
 
 	uint64_t ofs = file->get_position();
@@ -139,20 +144,35 @@ Error PCKPacker::flush(bool p_verbose) {
 	for (int i = 0; i < files.size(); i++) {
 
 		FileAccess *src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-		while (to_write > 0) {
+		uint64_t stored_size = files[i].size;
 
-			int read = src->get_buffer(buf, MIN(to_write, buf_max));
-			file->store_buffer(buf, read);
-			to_write -= read;
-		};
+		if (files[i].compress) {
+
+			Vector<uint8_t> data;
+			data.resize(files[i].size);
+			src->get_buffer(data.ptrw(), data.size());
+
+			Vector<uint8_t> compressed = FileAccessCompressed::compress_buffer(data.ptr(), data.size(), PACK_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PACK_COMPRESSED_BLOCK_SIZE);
+			file->store_buffer(compressed.ptr(), compressed.size());
+			stored_size = compressed.size();
+		} else {
+
+			uint64_t to_write = files[i].size;
+			while (to_write > 0) {
+
+				int read = src->get_buffer(buf, MIN(to_write, buf_max));
+				file->store_buffer(buf, read);
+				to_write -= read;
+			};
+		}
 
 		uint64_t pos = file->get_position();
-		file->seek(files[i].offset_offset); // go back to store the file's offset
+		file->seek(files[i].offset_offset); // go back to store the file's offset and stored size
 		file->store_64(ofs);
+		file->store_64(stored_size);
 		file->seek(pos);
 
-		ofs = _align(ofs + files[i].size, alignment);
+		ofs = _align(ofs + stored_size, alignment);
 		_pad(file, ofs - pos);
 
 		src->close();
@@ -111,6 +111,12 @@ StringName ResourceInteractiveLoaderBinary::_get_string() {
 		}
 		if (len == 0)
 			return StringName();
+		const uint8_t *view = f->get_buffer_view(len);
+		if (view) {
+			String s;
+			s.parse_utf8((const char *)view, len);
+			return s;
+		}
 		f->get_buffer((uint8_t *)&str_buf[0], len);
 		String s;
 		s.parse_utf8(&str_buf[0]);
@@ -307,7 +313,18 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 				case OBJECT_INTERNAL_RESOURCE: {
 					uint32_t index = f->get_32();
 					String path = res_path + "::" + itos(index);
-					RES res = ResourceLoader::load(path);
+					RES res;
+					const int *internal = internal_index.getptr(index);
+					if (internal && !ResourceCache::has(path)) {
+						//not loaded yet (only part of the file is being loaded), parse it now
+						uint64_t pos = f->get_position();
+						Error err = _load_internal(*internal, res);
+						f->seek(pos);
+						if (err != OK)
+							return err;
+					} else {
+						res = ResourceLoader::load(path);
+					}
 					if (res.is_null()) {
 						WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
 					}
@@ -442,18 +459,26 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 			PoolVector<real_t> array;
 			array.resize(len);
 			PoolVector<real_t>::Write w = array.write();
-			f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t));
+			if (sizeof(real_t) == 4 && !f->real_is_double) {
+				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t));
 #ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
+				{
+					uint32_t *ptr = (uint32_t *)w.ptr();
+					for (int i = 0; i < len; i++) {
 
-					ptr[i] = BSWAP32(ptr[i]);
+						ptr[i] = BSWAP32(ptr[i]);
+					}
 				}
-			}
 
 #endif
 
+			} else {
+				// File and engine precision differ (or real_t is double), convert one by one.
+				for (uint32_t i = 0; i < len; i++) {
+					w[i] = f->get_real();
+				}
+			}
+
 			w.release();
 			r_v = array;
 		} break;
@@ -476,7 +501,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 			PoolVector<Vector2> array;
 			array.resize(len);
 			PoolVector<Vector2>::Write w = array.write();
-			if (sizeof(Vector2) == 8) {
+			if (sizeof(Vector2) == 8 && !f->real_is_double) {
 				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t) * 2);
 #ifdef BIG_ENDIAN_ENABLED
 				{
@@ -490,7 +515,10 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 #endif
 
 			} else {
-				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector2 size is NOT 8!");
+				for (uint32_t i = 0; i < len; i++) {
+					w[i].x = f->get_real();
+					w[i].y = f->get_real();
+				}
 			}
 			w.release();
 			r_v = array;
@@ -503,7 +531,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 			PoolVector<Vector3> array;
 			array.resize(len);
 			PoolVector<Vector3>::Write w = array.write();
-			if (sizeof(Vector3) == 12) {
+			if (sizeof(Vector3) == 12 && !f->real_is_double) {
 				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t) * 3);
 #ifdef BIG_ENDIAN_ENABLED
 				{
@@ -517,7 +545,11 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 #endif
 
 			} else {
-				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector3 size is NOT 12!");
+				for (uint32_t i = 0; i < len; i++) {
+					w[i].x = f->get_real();
+					w[i].y = f->get_real();
+					w[i].z = f->get_real();
+				}
 			}
 			w.release();
 			r_v = array;
@@ -530,8 +562,9 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 			PoolVector<Color> array;
 			array.resize(len);
 			PoolVector<Color>::Write w = array.write();
-			if (sizeof(Color) == 16) {
-				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t) * 4);
+			if (sizeof(Color) == 16 && !f->real_is_double) {
+				// Color is made of floats whatever real_t is.
+				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(float) * 4);
 #ifdef BIG_ENDIAN_ENABLED
 				{
 					uint32_t *ptr = (uint32_t *)w.ptr();
@@ -544,7 +577,12 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 #endif
 
 			} else {
-				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Color size is NOT 16!");
+				for (uint32_t i = 0; i < len; i++) {
+					w[i].r = f->get_real();
+					w[i].g = f->get_real();
+					w[i].b = f->get_real();
+					w[i].a = f->get_real();
+				}
 			}
 			w.release();
 			r_v = array;
@@ -590,8 +628,17 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 			} else {
 				//compressed
+				uint32_t datalen = f->get_32();
+				const uint8_t *view = f->get_buffer_view(datalen);
+				if (view) {
+					//decode in place, no need to copy
+					r_v = Image::unpack_from_memory(view, datalen);
+					_advance_padding(datalen);
+					break;
+				}
+
 				PoolVector<uint8_t> data;
-				data.resize(f->get_32());
+				data.resize(datalen);
 				PoolVector<uint8_t>::Write w = data.write();
 				f->get_buffer(w.ptr(), data.size());
 				w.release();
@@ -622,56 +669,16 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 
 void ResourceInteractiveLoaderBinary::set_local_path(const String &p_local_path) {
 
-	res_path = p_local_path;
+	res_path = p_local_path.get_slice("::", 0);
 }
 
 Ref<Resource> ResourceInteractiveLoaderBinary::get_resource() {
 
 	return resource;
 }
-Error ResourceInteractiveLoaderBinary::poll() {
-
-	if (error != OK)
-		return error;
-
-	int s = stage;
-
-	if (s < external_resources.size()) {
-
-		String path = external_resources[s].path;
-
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
-		RES res = ResourceLoader::load(path, external_resources[s].type);
-		if (res.is_null()) {
-
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[s].type);
-			} else {
-
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
-			}
+Error ResourceInteractiveLoaderBinary::_load_internal(int p_index, RES &r_res) {
 
-		} else {
-			resource_cache.push_back(res);
-		}
-
-		stage++;
-		return error;
-	}
-
-	s -= external_resources.size();
-
-	if (s >= internal_resources.size()) {
-
-		error = ERR_BUG;
-		ERR_FAIL_COND_V(s >= internal_resources.size(), error);
-	}
-
-	bool main = s == (internal_resources.size() - 1);
+	bool main = p_index == (internal_resources.size() - 1);
 
 	//maybe it is loaded already
 	String path;
@@ -679,7 +686,7 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	if (!main) {
 
-		path = internal_resources[s].path;
+		path = internal_resources[p_index].path;
 		if (path.begins_with("local://")) {
 			path = path.replace_first("local://", "");
 			subindex = path.to_int();
@@ -688,9 +695,8 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 		if (ResourceCache::has(path)) {
 			//already loaded, don't do anything
-			stage++;
-			error = OK;
-			return error;
+			r_res = RES(ResourceCache::get(path));
+			return OK;
 		}
 	} else {
 
@@ -698,7 +704,7 @@ Error ResourceInteractiveLoaderBinary::poll() {
 			path = res_path;
 	}
 
-	uint64_t offset = internal_resources[s].offset;
+	uint64_t offset = internal_resources[p_index].offset;
 
 	f->seek(offset);
 
@@ -747,11 +753,79 @@ Error ResourceInteractiveLoaderBinary::poll() {
 #ifdef TOOLS_ENABLED
 	res->set_edited(false);
 #endif
-	stage++;
 
 	resource_cache.push_back(res);
+	r_res = res;
+
+	return OK;
+}
+
+Error ResourceInteractiveLoaderBinary::poll() {
+
+	if (error != OK)
+		return error;
+
+	if (sub_resource != -1) {
 
-	if (main) {
+		//only the requested resource, internal ones it uses are parsed as they are found
+		RES res;
+		error = _load_internal(sub_resource, res);
+		if (error)
+			return error;
+
+		stage++;
+		f->close();
+		resource = res;
+		resource->set_as_translation_remapped(translation_remapped);
+		error = ERR_FILE_EOF;
+		return OK;
+	}
+
+	int s = stage;
+
+	if (s < external_resources.size()) {
+
+		String path = external_resources[s].path;
+
+		if (remaps.has(path)) {
+			path = remaps[path];
+		}
+		RES res = ResourceLoader::load(path, external_resources[s].type);
+		if (res.is_null()) {
+
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+
+				ResourceLoader::notify_dependency_error(local_path, path, external_resources[s].type);
+			} else {
+
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
+			}
+
+		} else {
+			resource_cache.push_back(res);
+		}
+
+		stage++;
+		return error;
+	}
+
+	s -= external_resources.size();
+
+	if (s >= internal_resources.size()) {
+
+		error = ERR_BUG;
+		ERR_FAIL_COND_V(s >= internal_resources.size(), error);
+	}
+
+	RES res;
+	error = _load_internal(s, res);
+	if (error)
+		return error;
+
+	stage++;
+
+	if (s == internal_resources.size() - 1) {
 
 		f->close();
 		resource = res;
@@ -770,6 +844,9 @@ int ResourceInteractiveLoaderBinary::get_stage() const {
 }
 int ResourceInteractiveLoaderBinary::get_stage_count() const {
 
+	if (sub_resource != -1)
+		return 1;
+
 	return external_resources.size() + internal_resources.size();
 }
 
@@ -804,6 +881,12 @@ String ResourceInteractiveLoaderBinary::get_unicode_string() {
 	}
 	if (len == 0)
 		return String();
+	const uint8_t *view = f->get_buffer_view(len);
+	if (view) {
+		String s;
+		s.parse_utf8((const char *)view, len);
+		return s;
+	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
 	s.parse_utf8(&str_buf[0]);
@@ -838,8 +921,11 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
 	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
 		//compressed
 		FileAccessCompressed *fac = memnew(FileAccessCompressed);
-		fac->open_after_magic(f);
+		error = fac->open_after_magic(f);
 		f = fac;
+		if (error != OK) {
+			ERR_FAIL_MSG("Corrupt compressed binary resource file: " + local_path + ".");
+		}
 
 	} else if (header[0] != 'R' || header[1] != 'S' || header[2] != 'R' || header[3] != 'C') {
 		//not normal
@@ -852,6 +938,7 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
 	bool use_real64 = f->get_32();
 
 	f->set_endian_swap(big_endian != 0); //read big endian if saved as big endian
+	f->real_is_double = use_real64; //reals are stored with the precision of the engine that saved the file
 
 	uint32_t ver_major = f->get_32();
 	uint32_t ver_minor = f->get_32();
@@ -911,6 +998,9 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
 		IntResource ir;
 		ir.path = get_unicode_string();
 		ir.offset = f->get_64();
+		if (ir.path.begins_with("local://")) {
+			internal_index[ir.path.replace_first("local://", "").to_int()] = internal_resources.size();
+		}
 		internal_resources.push_back(ir);
 	}
 
@@ -933,8 +1023,11 @@ String ResourceInteractiveLoaderBinary::recognize(FileAccess *p_f) {
 	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
 		//compressed
 		FileAccessCompressed *fac = memnew(FileAccessCompressed);
-		fac->open_after_magic(f);
+		error = fac->open_after_magic(f);
 		f = fac;
+		if (error != OK) {
+			return "";
+		}
 
 	} else if (header[0] != 'R' || header[1] != 'S' || header[2] != 'R' || header[3] != 'C') {
 		//not normal
@@ -966,7 +1059,8 @@ ResourceInteractiveLoaderBinary::ResourceInteractiveLoaderBinary() :
 		translation_remapped(false),
 		f(NULL),
 		error(OK),
-		stage(0) {
+		stage(0),
+		sub_resource(-1) {
 }
 
 ResourceInteractiveLoaderBinary::~ResourceInteractiveLoaderBinary() {
@@ -980,21 +1074,49 @@ Ref<ResourceInteractiveLoader> ResourceFormatLoaderBinary::load_interactive(cons
 	if (r_error)
 		*r_error = ERR_FILE_CANT_OPEN;
 
+	//"file.res::subindex" loads a single built-in resource, without the rest of the file
+	String file_path = p_path;
+	String path = p_original_path != "" ? p_original_path : p_path;
+	int subindex = -1;
+	int sub_split = p_path.find("::");
+	if (sub_split != -1) {
+		subindex = p_path.substr(sub_split + 2, p_path.length()).to_int();
+		file_path = p_path.substr(0, sub_split);
+		path = path.get_slice("::", 0);
+	}
+
 	Error err;
-	FileAccess *f = FileAccess::open(p_path, FileAccess::READ, &err);
+	FileAccess *f = FileAccess::open(file_path, FileAccess::READ, &err);
 
-	ERR_FAIL_COND_V_MSG(err != OK, Ref<ResourceInteractiveLoader>(), "Cannot open file '" + p_path + "'.");
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<ResourceInteractiveLoader>(), "Cannot open file '" + file_path + "'.");
 
 	Ref<ResourceInteractiveLoaderBinary> ria = memnew(ResourceInteractiveLoaderBinary);
-	String path = p_original_path != "" ? p_original_path : p_path;
 	ria->local_path = ProjectSettings::get_singleton()->localize_path(path);
 	ria->res_path = ria->local_path;
 	//ria->set_local_path( Globals::get_singleton()->localize_path(p_path) );
 	ria->open(f);
 
+	if (subindex != -1 && ria->error == OK) {
+
+		const int *internal = ria->internal_index.getptr(subindex);
+		ERR_FAIL_COND_V_MSG(!internal, Ref<ResourceInteractiveLoader>(), "No built-in resource with subindex " + itos(subindex) + " in file '" + file_path + "'.");
+		ria->sub_resource = *internal;
+	}
+
 	return ria;
 }
 
+bool ResourceFormatLoaderBinary::recognize_path(const String &p_path, const String &p_for_type) const {
+
+	int sub_split = p_path.find("::");
+	if (sub_split == -1) {
+		return ResourceFormatLoader::recognize_path(p_path, p_for_type);
+	}
+
+	//built-in resources are of any type, whatever the file holds
+	return ResourceFormatLoader::recognize_path(p_path.substr(0, sub_split), String());
+}
+
 void ResourceFormatLoaderBinary::get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const {
 
 	if (p_type == "") {
@@ -1057,12 +1179,16 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
 		//compressed
 		FileAccessCompressed *fac = memnew(FileAccessCompressed);
-		fac->open_after_magic(f);
+		Error err = fac->open_after_magic(f);
+		if (err) {
+			memdelete(fac);
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Corrupt compressed binary resource file '" + p_path + "'.");
+		}
 		f = fac;
 
 		FileAccessCompressed *facw = memnew(FileAccessCompressed);
 		facw->configure("RSCC");
-		Error err = facw->_open(p_path + ".depren", FileAccess::WRITE);
+		err = facw->_open(p_path + ".depren", FileAccess::WRITE);
 		if (err) {
 			memdelete(fac);
 			memdelete(facw);
@@ -1779,7 +1905,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const RES &p
 	} else
 		f->store_32(0);
 
-	f->store_32(0); //64 bits file, false for now
+	f->store_32(sizeof(real_t) == 8); //64 bits file, store_real() writes doubles when real_t is double
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(FORMAT_VERSION);
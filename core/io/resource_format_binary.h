@@ -69,6 +69,8 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	};
 
 	Vector<IntResource> internal_resources;
+	HashMap<int, int> internal_index; // subindex -> internal_resources
+	int sub_resource; // loading only "path::subindex", -1 loads the whole file
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
@@ -81,6 +83,7 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	friend class ResourceFormatLoaderBinary;
 
 	Error parse_variant(Variant &r_v);
+	Error _load_internal(int p_index, RES &r_res);
 
 public:
 	virtual void set_local_path(const String &p_local_path);
@@ -102,6 +105,7 @@ public:
 class ResourceFormatLoaderBinary : public ResourceFormatLoader {
 public:
 	virtual Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_original_path = "", Error *r_error = NULL);
+	virtual bool recognize_path(const String &p_path, const String &p_for_type = String()) const;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
 	virtual bool handles_type(const String &p_type) const;
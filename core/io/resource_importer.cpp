@@ -201,6 +201,34 @@ bool ResourceFormatImporter::can_be_imported(const String &p_path) const {
 	return ResourceFormatLoader::recognize_path(p_path);
 }
 
+void ResourceFormatImporter::get_import_order_threads_and_importer(const String &p_path, int &r_order, bool &r_can_threads, String &r_importer) const {
+
+	Ref<ResourceImporter> importer;
+
+	if (FileAccess::exists(p_path + ".import")) {
+
+		PathAndType pat;
+		Error err = _get_path_and_type(p_path, pat);
+
+		if (err == OK) {
+			importer = get_importer_by_name(pat.importer);
+		}
+	} else {
+
+		importer = get_importer_by_extension(p_path.get_extension().to_lower());
+	}
+
+	if (importer.is_valid()) {
+		r_order = importer->get_import_order();
+		r_can_threads = importer->can_import_threaded();
+		r_importer = importer->get_importer_name();
+	} else {
+		r_order = 0;
+		r_can_threads = false;
+		r_importer = String();
+	}
+}
+
 int ResourceFormatImporter::get_import_order(const String &p_path) const {
 
 	Ref<ResourceImporter> importer;
@@ -73,6 +73,7 @@ public:
 
 	virtual bool can_be_imported(const String &p_path) const;
 	virtual int get_import_order(const String &p_path) const;
+	void get_import_order_threads_and_importer(const String &p_path, int &r_order, bool &r_can_threads, String &r_importer) const;
 
 	String get_internal_resource_path(const String &p_path) const;
 	void get_internal_resource_path_list(const String &p_path, List<String> *r_paths);
@@ -104,6 +105,11 @@ public:
 	virtual String get_resource_type() const = 0;
 	virtual float get_priority() const { return 1.0; }
 	virtual int get_import_order() const { return 0; }
+	virtual int get_format_version() const { return 0; } // increase when the imported files change for the same source and options
+	// Return true only if import() may run on several threads at once. Besides the importer's own
+	// code, that includes everything it calls: the image loaders for its sources (SVG, for example)
+	// and the compressors and savers it uses.
+	virtual bool can_import_threaded() const { return false; }
 
 	struct ImportOption {
 		PropertyInfo option;
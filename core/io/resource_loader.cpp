@@ -428,6 +428,326 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 	return res;
 }
 
+String ResourceLoader::_validate_local_path(const String &p_path) {
+
+	if (p_path.is_rel_path())
+		return "res://" + p_path;
+	else
+		return ProjectSettings::get_singleton()->localize_path(p_path);
+}
+
+void ResourceLoader::_thread_load_worker(void *p_userdata) {
+
+	while (true) {
+
+		thread_load_semaphore->wait();
+
+		thread_load_mutex->lock();
+		if (thread_load_exit) {
+			thread_load_mutex->unlock();
+			break;
+		}
+		String path;
+		if (thread_load_queue.size()) {
+			path = thread_load_queue.front()->get();
+			thread_load_queue.pop_front();
+		}
+		thread_load_mutex->unlock();
+
+		if (path != String()) {
+			_thread_load_run(path);
+		}
+	}
+}
+
+bool ResourceLoader::_thread_load_reaches(const String &p_from, const String &p_to) {
+
+	if (p_from == p_to) {
+		return true;
+	}
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_from);
+	if (task) {
+		for (List<String>::Element *E = task->sub_tasks.front(); E; E = E->next()) {
+			if (_thread_load_reaches(E->get(), p_to)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void ResourceLoader::_thread_load_request(const String &p_local_path, const String &p_type_hint, bool p_use_sub_threads) {
+
+	ThreadLoadTask *existing = thread_load_tasks.getptr(p_local_path);
+	if (existing) {
+		existing->requests++;
+		return;
+	}
+
+	ThreadLoadTask task;
+	task.type_hint = p_type_hint;
+	task.use_sub_threads = p_use_sub_threads;
+	task.started = false;
+	task.status = THREAD_LOAD_IN_PROGRESS;
+	task.error = OK;
+	task.requests = 1;
+
+	Resource *cached = ResourceCache::get(p_local_path);
+	if (cached) {
+		task.resource = RES(cached);
+	}
+
+	if (task.resource.is_valid()) {
+		task.started = true;
+		task.status = THREAD_LOAD_LOADED;
+		thread_load_tasks[p_local_path] = task;
+		return;
+	}
+
+	thread_load_tasks[p_local_path] = task;
+	thread_load_queue.push_back(p_local_path);
+	if (thread_load_semaphore) {
+		thread_load_semaphore->post();
+	}
+}
+
+void ResourceLoader::_thread_load_release(const String &p_local_path) {
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	ERR_FAIL_COND(!task);
+
+	task->requests--;
+	if (task->requests == 0) {
+		thread_load_tasks.erase(p_local_path);
+	}
+}
+
+bool ResourceLoader::_thread_load_run(const String &p_local_path) {
+
+	if (thread_load_mutex) {
+		thread_load_mutex->lock();
+	}
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (!task || task->started) {
+		if (thread_load_mutex) {
+			thread_load_mutex->unlock();
+		}
+		return false; //picked by another thread
+	}
+	task->started = true;
+	String type_hint = task->type_hint;
+	bool use_sub_threads = task->use_sub_threads;
+
+	if (thread_load_mutex) {
+		thread_load_mutex->unlock();
+	}
+
+	if (use_sub_threads) {
+
+		// Load the dependencies in parallel first, the resource then finds them in the cache.
+		List<String> dependencies;
+		get_dependencies(p_local_path, &dependencies);
+
+		List<String> sub_tasks;
+
+		if (thread_load_mutex) {
+			thread_load_mutex->lock();
+		}
+
+		for (List<String>::Element *E = dependencies.front(); E; E = E->next()) {
+
+			String dependency = _validate_local_path(E->get().get_slice("::", 0));
+			if (sub_tasks.find(dependency) || _thread_load_reaches(dependency, p_local_path)) {
+				continue; //waiting for it would never end
+			}
+			_thread_load_request(dependency, "", true);
+			sub_tasks.push_back(dependency);
+		}
+		thread_load_tasks.getptr(p_local_path)->sub_tasks = sub_tasks;
+
+		if (thread_load_mutex) {
+			thread_load_mutex->unlock();
+		}
+
+		for (List<String>::Element *E = sub_tasks.front(); E; E = E->next()) {
+			_thread_load_wait(E->get());
+		}
+	}
+
+	Error err = OK;
+	RES res = load(p_local_path, type_hint, false, &err);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->lock();
+	}
+
+	task = thread_load_tasks.getptr(p_local_path);
+	task->resource = res;
+	task->error = res.is_valid() ? OK : (err != OK ? err : ERR_CANT_OPEN);
+	task->status = res.is_valid() ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+
+	// The resource references what it needs now.
+	for (List<String>::Element *E = task->sub_tasks.front(); E; E = E->next()) {
+		_thread_load_release(E->get());
+	}
+	thread_load_tasks.getptr(p_local_path)->sub_tasks.clear();
+
+	if (thread_load_mutex) {
+		thread_load_mutex->unlock();
+	}
+
+	return true;
+}
+
+void ResourceLoader::_thread_load_wait(const String &p_local_path) {
+
+	while (true) {
+
+		if (thread_load_mutex) {
+			thread_load_mutex->lock();
+		}
+
+		ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+		bool done = !task || task->status != THREAD_LOAD_IN_PROGRESS;
+		bool run_here = !done && !task->started;
+
+		if (thread_load_mutex) {
+			thread_load_mutex->unlock();
+		}
+
+		if (done) {
+			return;
+		}
+
+		// Rather than waiting for a worker to get to it, load it right away.
+		if (!run_here || !_thread_load_run(p_local_path)) {
+			OS::get_singleton()->delay_usec(1000);
+		}
+	}
+}
+
+float ResourceLoader::_thread_load_get_progress(const String &p_local_path) {
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (!task) {
+		return 0;
+	}
+	if (task->status != THREAD_LOAD_IN_PROGRESS) {
+		return 1.0;
+	}
+
+	// The resource itself counts as one more part, done once it's loaded.
+	float progress = 0;
+	for (List<String>::Element *E = task->sub_tasks.front(); E; E = E->next()) {
+		progress += _thread_load_get_progress(E->get());
+	}
+	return progress / (task->sub_tasks.size() + 1);
+}
+
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads) {
+
+	String local_path = _validate_local_path(p_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->lock();
+
+		if (thread_load_workers.empty() && !thread_load_exit) {
+			int count = MAX(1, OS::get_singleton()->get_processor_count() - 1);
+			for (int i = 0; i < count; i++) {
+				thread_load_workers.push_back(Thread::create(_thread_load_worker, NULL));
+			}
+		}
+	}
+
+	_thread_load_request(local_path, p_type_hint, p_use_sub_threads);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->unlock();
+	} else {
+		_thread_load_run(local_path); //no threads, load right away
+	}
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+
+	String local_path = _validate_local_path(p_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->lock();
+	}
+
+	ThreadLoadStatus status = THREAD_LOAD_INVALID_RESOURCE;
+	ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (task) {
+		status = task->status;
+		if (r_progress) {
+			*r_progress = _thread_load_get_progress(local_path);
+		}
+	}
+
+	if (thread_load_mutex) {
+		thread_load_mutex->unlock();
+	}
+
+	return status;
+}
+
+RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
+
+	String local_path = _validate_local_path(p_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->lock();
+	}
+
+	bool requested = thread_load_tasks.has(local_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->unlock();
+	}
+
+	if (!requested) {
+		if (r_error) {
+			*r_error = ERR_INVALID_PARAMETER;
+		}
+		ERR_FAIL_V_MSG(RES(), "Attempted to get a resource that was not requested to load in a thread: " + local_path + ".");
+	}
+
+	_thread_load_wait(local_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->lock();
+	}
+
+	// Another thread getting the same request may have released it meanwhile.
+	ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (!task) {
+		if (thread_load_mutex) {
+			thread_load_mutex->unlock();
+		}
+		if (r_error) {
+			*r_error = ERR_INVALID_PARAMETER;
+		}
+		ERR_FAIL_V_MSG(RES(), "Attempted to get a resource whose threaded load was already retrieved: " + local_path + ".");
+	}
+
+	RES res = task->resource;
+	if (r_error) {
+		*r_error = task->error;
+	}
+	_thread_load_release(local_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->unlock();
+	}
+
+	return res;
+}
+
 bool ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 
 	String local_path;
@@ -998,9 +1318,18 @@ void ResourceLoader::remove_custom_loaders() {
 Mutex *ResourceLoader::loading_map_mutex = NULL;
 HashMap<ResourceLoader::LoadingMapKey, int, ResourceLoader::LoadingMapKeyHasher> ResourceLoader::loading_map;
 
+Mutex *ResourceLoader::thread_load_mutex = NULL;
+Semaphore *ResourceLoader::thread_load_semaphore = NULL;
+HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
+List<String> ResourceLoader::thread_load_queue;
+Vector<Thread *> ResourceLoader::thread_load_workers;
+bool ResourceLoader::thread_load_exit = false;
+
 void ResourceLoader::initialize() {
 #ifndef NO_THREADS
 	loading_map_mutex = Mutex::create();
+	thread_load_mutex = Mutex::create();
+	thread_load_semaphore = Semaphore::create();
 #endif
 }
 
@@ -1013,6 +1342,24 @@ void ResourceLoader::finalize() {
 	loading_map.clear();
 	memdelete(loading_map_mutex);
 	loading_map_mutex = NULL;
+
+	thread_load_mutex->lock();
+	thread_load_exit = true;
+	thread_load_mutex->unlock();
+	for (int i = 0; i < thread_load_workers.size(); i++) {
+		thread_load_semaphore->post();
+	}
+	for (int i = 0; i < thread_load_workers.size(); i++) {
+		Thread::wait_to_finish(thread_load_workers[i]);
+		memdelete(thread_load_workers[i]);
+	}
+	thread_load_workers.clear();
+	thread_load_queue.clear();
+	thread_load_tasks.clear();
+	memdelete(thread_load_semaphore);
+	thread_load_semaphore = NULL;
+	memdelete(thread_load_mutex);
+	thread_load_mutex = NULL;
 #endif
 }
 
@@ -31,6 +31,7 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/resource.h"
 
@@ -95,6 +96,15 @@ class ResourceLoader {
 		MAX_LOADERS = 64
 	};
 
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
+private:
 	static Ref<ResourceFormatLoader> loader[MAX_LOADERS];
 	static int loader_count;
 	static bool timestamp_on_load;
@@ -141,11 +151,45 @@ class ResourceLoader {
 	static void _remove_from_loading_map(const String &p_path);
 	static void _remove_from_loading_map_and_thread(const String &p_path, Thread::ID p_thread);
 
+	//threaded loading, a task per path shared by all its requests
+	struct ThreadLoadTask {
+		String type_hint;
+		bool use_sub_threads;
+		bool started;
+		ThreadLoadStatus status;
+		Error error;
+		RES resource;
+		int requests; //requests not collected yet, including those of the tasks waiting for it
+		List<String> sub_tasks; //dependencies loaded by other tasks before this one
+	};
+
+	static Mutex *thread_load_mutex;
+	static Semaphore *thread_load_semaphore;
+	static HashMap<String, ThreadLoadTask> thread_load_tasks;
+	static List<String> thread_load_queue;
+	static Vector<Thread *> thread_load_workers;
+	static bool thread_load_exit;
+
+	static void _thread_load_worker(void *p_userdata);
+	static bool _thread_load_run(const String &p_local_path);
+	static void _thread_load_wait(const String &p_local_path);
+	//these need thread_load_mutex locked
+	static void _thread_load_request(const String &p_local_path, const String &p_type_hint, bool p_use_sub_threads);
+	static void _thread_load_release(const String &p_local_path);
+	static bool _thread_load_reaches(const String &p_from, const String &p_to);
+	static float _thread_load_get_progress(const String &p_local_path);
+
+	static String _validate_local_path(const String &p_path);
+
 public:
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false);
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = NULL);
+	static RES load_threaded_get(const String &p_path, Error *r_error = NULL);
+
 	static void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions);
 	static void add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front = false);
 	static void remove_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader);
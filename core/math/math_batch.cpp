@@ -0,0 +1,457 @@
+/*************************************************************************/
+/*  math_batch.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "math_batch.h"
+
+#if !defined(REAL_T_IS_DOUBLE) && !defined(MATH_BATCH_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_BATCH_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MATH_BATCH_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+/* The kernels below evaluate the same operations in the same order as the scalar
+ * Transform/AABB code, so results match it exactly (no fused multiply-add). */
+
+#if defined(MATH_BATCH_SSE)
+
+/* SSE */
+
+#define MATH_BATCH_SIMD
+typedef __m128 simd4f;
+
+static _FORCE_INLINE_ simd4f _splat(float p_v) { return _mm_set1_ps(p_v); }
+static _FORCE_INLINE_ simd4f _make(float p_x, float p_y, float p_z, float p_w) { return _mm_set_ps(p_w, p_z, p_y, p_x); }
+static _FORCE_INLINE_ simd4f _load(const float *p_src) { return _mm_loadu_ps(p_src); }
+static _FORCE_INLINE_ void _store(float *r_dst, simd4f p_v) { _mm_storeu_ps(r_dst, p_v); }
+static _FORCE_INLINE_ simd4f _add(simd4f a, simd4f b) { return _mm_add_ps(a, b); }
+static _FORCE_INLINE_ simd4f _mul(simd4f a, simd4f b) { return _mm_mul_ps(a, b); }
+static _FORCE_INLINE_ simd4f _min(simd4f a, simd4f b) { return _mm_min_ps(a, b); }
+static _FORCE_INLINE_ simd4f _max(simd4f a, simd4f b) { return _mm_max_ps(a, b); }
+static _FORCE_INLINE_ simd4f _negate_where_positive(simd4f p_v, simd4f p_sign) { return _mm_xor_ps(p_v, _mm_and_ps(_mm_cmpgt_ps(p_sign, _mm_setzero_ps()), _mm_set1_ps(-0.0f))); }
+static _FORCE_INLINE_ bool _any_greater(simd4f a, simd4f b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)) != 0; }
+
+// 4 packed Vector3 (12 floats) <-> one register per component.
+
+static _FORCE_INLINE_ void _load_xyz4(const float *p_src, simd4f &r_x, simd4f &r_y, simd4f &r_z) {
+
+	__m128 a = _mm_loadu_ps(p_src); // x0 y0 z0 x1
+	__m128 b = _mm_loadu_ps(p_src + 4); // y1 z1 x2 y2
+	__m128 c = _mm_loadu_ps(p_src + 8); // z2 x3 y3 z3
+
+	r_x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 2)), _MM_SHUFFLE(3, 0, 3, 0));
+	r_y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+static _FORCE_INLINE_ void _store_xyz4(float *r_dst, simd4f p_x, simd4f p_y, simd4f p_z) {
+
+	_mm_storeu_ps(r_dst, _mm_shuffle_ps(_mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(r_dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(r_dst + 8, _mm_shuffle_ps(_mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// 3x4 row-major matrix -> basis columns and origin.
+static _FORCE_INLINE_ void _load_rows(const float *p_rows, simd4f &r_col0, simd4f &r_col1, simd4f &r_col2, simd4f &r_origin) {
+
+	r_col0 = _mm_loadu_ps(p_rows);
+	r_col1 = _mm_loadu_ps(p_rows + 4);
+	r_col2 = _mm_loadu_ps(p_rows + 8);
+	r_origin = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(r_col0, r_col1, r_col2, r_origin);
+}
+
+#elif defined(MATH_BATCH_NEON)
+
+/* NEON */
+
+#define MATH_BATCH_SIMD
+typedef float32x4_t simd4f;
+
+static _FORCE_INLINE_ simd4f _splat(float p_v) { return vdupq_n_f32(p_v); }
+static _FORCE_INLINE_ simd4f _make(float p_x, float p_y, float p_z, float p_w) {
+	const float f[4] = { p_x, p_y, p_z, p_w };
+	return vld1q_f32(f);
+}
+static _FORCE_INLINE_ simd4f _load(const float *p_src) { return vld1q_f32(p_src); }
+static _FORCE_INLINE_ void _store(float *r_dst, simd4f p_v) { vst1q_f32(r_dst, p_v); }
+static _FORCE_INLINE_ simd4f _add(simd4f a, simd4f b) { return vaddq_f32(a, b); }
+static _FORCE_INLINE_ simd4f _mul(simd4f a, simd4f b) { return vmulq_f32(a, b); }
+static _FORCE_INLINE_ simd4f _min(simd4f a, simd4f b) { return vminq_f32(a, b); }
+static _FORCE_INLINE_ simd4f _max(simd4f a, simd4f b) { return vmaxq_f32(a, b); }
+static _FORCE_INLINE_ simd4f _negate_where_positive(simd4f p_v, simd4f p_sign) {
+	uint32x4_t mask = vandq_u32(vcgtq_f32(p_sign, vdupq_n_f32(0)), vdupq_n_u32(0x80000000));
+	return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(p_v), mask));
+}
+static _FORCE_INLINE_ bool _any_greater(simd4f a, simd4f b) {
+	uint32x4_t m = vcgtq_f32(a, b);
+	uint32x2_t r = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+	return (vget_lane_u32(r, 0) | vget_lane_u32(r, 1)) != 0;
+}
+
+static _FORCE_INLINE_ void _load_xyz4(const float *p_src, simd4f &r_x, simd4f &r_y, simd4f &r_z) {
+
+	float32x4x3_t v = vld3q_f32(p_src);
+	r_x = v.val[0];
+	r_y = v.val[1];
+	r_z = v.val[2];
+}
+
+static _FORCE_INLINE_ void _store_xyz4(float *r_dst, simd4f p_x, simd4f p_y, simd4f p_z) {
+
+	float32x4x3_t v;
+	v.val[0] = p_x;
+	v.val[1] = p_y;
+	v.val[2] = p_z;
+	vst3q_f32(r_dst, v);
+}
+
+static _FORCE_INLINE_ void _load_rows(const float *p_rows, simd4f &r_col0, simd4f &r_col1, simd4f &r_col2, simd4f &r_origin) {
+
+	r_col0 = _make(p_rows[0], p_rows[4], p_rows[8], 0);
+	r_col1 = _make(p_rows[1], p_rows[5], p_rows[9], 0);
+	r_col2 = _make(p_rows[2], p_rows[6], p_rows[10], 0);
+	r_origin = _make(p_rows[3], p_rows[7], p_rows[11], 0);
+}
+
+#endif
+
+#ifdef MATH_BATCH_SIMD
+
+static _FORCE_INLINE_ Vector3 _to_vector3(simd4f p_v) {
+
+	float f[4];
+	_store(f, p_v);
+	return Vector3(f[0], f[1], f[2]);
+}
+
+static _FORCE_INLINE_ int _xform_points_simd(const Transform &p_xform, const Vector3 *p_src, Vector3 *r_dst, int p_count, bool p_translate) {
+
+	simd4f m[3][3];
+	simd4f o[3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			m[i][j] = _splat(p_xform.basis.elements[i][j]);
+		}
+		o[i] = _splat(p_xform.origin[i]);
+	}
+
+	int i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+
+		simd4f x, y, z;
+		_load_xyz4(&p_src[i].x, x, y, z); // all loads happen before the stores, so in-place is fine
+
+		simd4f r[3];
+		for (int k = 0; k < 3; k++) {
+			r[k] = _add(_add(_mul(m[k][0], x), _mul(m[k][1], y)), _mul(m[k][2], z));
+			if (p_translate) {
+				r[k] = _add(r[k], o[k]);
+			}
+		}
+
+		_store_xyz4(&r_dst[i].x, r[0], r[1], r[2]);
+	}
+
+	return i;
+}
+
+// Transform::xform(const AABB &) for a basis given by columns, one lane per axis.
+static _FORCE_INLINE_ void _xform_aabb_simd(simd4f p_col0, simd4f p_col1, simd4f p_col2, simd4f p_origin, const Vector3 &p_min, const Vector3 &p_max, simd4f &r_min, simd4f &r_max) {
+
+	simd4f e0 = _mul(p_col0, _splat(p_min.x));
+	simd4f f0 = _mul(p_col0, _splat(p_max.x));
+	simd4f e1 = _mul(p_col1, _splat(p_min.y));
+	simd4f f1 = _mul(p_col1, _splat(p_max.y));
+	simd4f e2 = _mul(p_col2, _splat(p_min.z));
+	simd4f f2 = _mul(p_col2, _splat(p_max.z));
+
+	r_min = _add(_add(_add(p_origin, _min(e0, f0)), _min(e1, f1)), _min(e2, f2));
+	r_max = _add(_add(_add(p_origin, _max(e0, f0)), _max(e1, f1)), _max(e2, f2));
+}
+
+#endif
+
+#ifndef MATH_BATCH_SIMD
+
+/* SCALAR */
+
+static _FORCE_INLINE_ void _xform_aabb_scalar(const Transform &p_xform, const Vector3 &p_min, const Vector3 &p_max, Vector3 &r_min, Vector3 &r_max) {
+
+	// Same as Transform::xform(const AABB &), with the corners already computed.
+	for (int i = 0; i < 3; i++) {
+		r_min[i] = r_max[i] = p_xform.origin[i];
+		for (int j = 0; j < 3; j++) {
+			real_t e = p_xform.basis[i][j] * p_min[j];
+			real_t f = p_xform.basis[i][j] * p_max[j];
+			if (e < f) {
+				r_min[i] += e;
+				r_max[i] += f;
+			} else {
+				r_min[i] += f;
+				r_max[i] += e;
+			}
+		}
+	}
+}
+
+static _FORCE_INLINE_ Transform _rows_to_transform(const float *p_rows) {
+
+	return Transform(
+			p_rows[0], p_rows[1], p_rows[2],
+			p_rows[4], p_rows[5], p_rows[6],
+			p_rows[8], p_rows[9], p_rows[10],
+			p_rows[3], p_rows[7], p_rows[11]);
+}
+
+#endif
+
+/* API */
+
+void MathBatch::xform_points(const Transform &p_xform, const Vector3 *p_src, Vector3 *r_dst, int p_count) {
+
+	int i = 0;
+#ifdef MATH_BATCH_SIMD
+	i = _xform_points_simd(p_xform, p_src, r_dst, p_count, true);
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+void MathBatch::xform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count) {
+
+	int i = 0;
+#ifdef MATH_BATCH_SIMD
+	i = _xform_points_simd(Transform(p_basis), p_src, r_dst, p_count, false);
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_basis.xform(p_src[i]);
+	}
+}
+
+void MathBatch::xform_aabbs(const Transform &p_xform, const AABB *p_src, AABB *r_dst, int p_count) {
+
+#ifdef MATH_BATCH_SIMD
+
+	const Basis &b = p_xform.basis;
+	simd4f col0 = _make(b.elements[0][0], b.elements[1][0], b.elements[2][0], 0);
+	simd4f col1 = _make(b.elements[0][1], b.elements[1][1], b.elements[2][1], 0);
+	simd4f col2 = _make(b.elements[0][2], b.elements[1][2], b.elements[2][2], 0);
+	simd4f origin = _make(p_xform.origin.x, p_xform.origin.y, p_xform.origin.z, 0);
+
+	for (int i = 0; i < p_count; i++) {
+
+		Vector3 min = p_src[i].position;
+		Vector3 max = p_src[i].position + p_src[i].size;
+
+		simd4f tmin, tmax;
+		_xform_aabb_simd(col0, col1, col2, origin, min, max, tmin, tmax);
+
+		r_dst[i].position = _to_vector3(tmin);
+		r_dst[i].size = _to_vector3(tmax) - r_dst[i].position;
+	}
+#else
+
+	for (int i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+#endif
+}
+
+AABB MathBatch::xform_aabb_merged(const AABB &p_aabb, const float *p_rows, int p_stride, int p_count) {
+
+	if (p_count <= 0)
+		return AABB();
+
+	Vector3 min = p_aabb.position;
+	Vector3 max = p_aabb.position + p_aabb.size;
+
+#ifdef MATH_BATCH_SIMD
+
+	simd4f rmin = _splat(Math_INF);
+	simd4f rmax = _splat(-Math_INF);
+
+	for (int i = 0; i < p_count; i++) {
+
+		simd4f col0, col1, col2, origin;
+		_load_rows(p_rows + i * p_stride, col0, col1, col2, origin);
+
+		simd4f tmin, tmax;
+		_xform_aabb_simd(col0, col1, col2, origin, min, max, tmin, tmax);
+
+		rmin = _min(rmin, tmin);
+		rmax = _max(rmax, tmax);
+	}
+
+	Vector3 rpos = _to_vector3(rmin);
+	return AABB(rpos, _to_vector3(rmax) - rpos);
+#else
+
+	Vector3 rmin, rmax;
+	for (int i = 0; i < p_count; i++) {
+
+		Vector3 tmin, tmax;
+		_xform_aabb_scalar(_rows_to_transform(p_rows + i * p_stride), min, max, tmin, tmax);
+
+		if (i == 0) {
+			rmin = tmin;
+			rmax = tmax;
+		} else {
+			for (int j = 0; j < 3; j++) {
+				rmin[j] = MIN(rmin[j], tmin[j]);
+				rmax[j] = MAX(rmax[j], tmax[j]);
+			}
+		}
+	}
+
+	return AABB(rmin, rmax - rmin);
+#endif
+}
+
+void MathBatch::xform_to_rows(const Transform &p_xform, const Transform &p_transform, float *r_rows) {
+
+#ifdef MATH_BATCH_SIMD
+
+	// Row i of the product is the rows of p_transform (origin in the last lane)
+	// weighted by row i of p_xform, plus p_xform's origin in the last lane.
+	const Basis &l = p_xform.basis;
+	const Basis &t = p_transform.basis;
+
+	simd4f t0 = _make(t.elements[0][0], t.elements[0][1], t.elements[0][2], p_transform.origin.x);
+	simd4f t1 = _make(t.elements[1][0], t.elements[1][1], t.elements[1][2], p_transform.origin.y);
+	simd4f t2 = _make(t.elements[2][0], t.elements[2][1], t.elements[2][2], p_transform.origin.z);
+
+	for (int i = 0; i < 3; i++) {
+		simd4f row = _add(_add(_mul(t0, _splat(l.elements[i][0])), _mul(t1, _splat(l.elements[i][1]))), _mul(t2, _splat(l.elements[i][2])));
+		row = _add(row, _make(0, 0, 0, p_xform.origin[i]));
+		_store(r_rows + i * 4, row);
+	}
+#else
+
+	Transform t = p_xform * p_transform;
+
+	for (int i = 0; i < 3; i++) {
+		r_rows[i * 4 + 0] = t.basis.elements[i][0];
+		r_rows[i * 4 + 1] = t.basis.elements[i][1];
+		r_rows[i * 4 + 2] = t.basis.elements[i][2];
+		r_rows[i * 4 + 3] = t.origin[i];
+	}
+#endif
+}
+
+int MathBatch::cull_aabbs_convex(const Plane *p_planes, int p_plane_count, const AABB *p_aabbs, int p_count, int *r_indices) {
+
+	int found = 0;
+
+#ifdef MATH_BATCH_SIMD
+
+	enum {
+		MAX_PLANE_GROUPS = 8
+	};
+
+	if (p_plane_count <= MAX_PLANE_GROUPS * 4) {
+
+		// Planes are tested four at a time. Padding planes (zero normal, infinite
+		// distance) never reject anything.
+		int group_count = (p_plane_count + 3) / 4;
+		simd4f nx[MAX_PLANE_GROUPS], ny[MAX_PLANE_GROUPS], nz[MAX_PLANE_GROUPS], d[MAX_PLANE_GROUPS];
+
+		for (int g = 0; g < group_count; g++) {
+			float pn[3][4], pd[4];
+			for (int k = 0; k < 4; k++) {
+				int p = g * 4 + k;
+				if (p < p_plane_count) {
+					pn[0][k] = p_planes[p].normal.x;
+					pn[1][k] = p_planes[p].normal.y;
+					pn[2][k] = p_planes[p].normal.z;
+					pd[k] = p_planes[p].d;
+				} else {
+					pn[0][k] = pn[1][k] = pn[2][k] = 0;
+					pd[k] = Math_INF;
+				}
+			}
+			nx[g] = _load(pn[0]);
+			ny[g] = _load(pn[1]);
+			nz[g] = _load(pn[2]);
+			d[g] = _load(pd);
+		}
+
+		for (int i = 0; i < p_count; i++) {
+
+			// Same support point as AABB::intersects_convex_shape().
+			const AABB &aabb = p_aabbs[i];
+			Vector3 half_extents = aabb.size * 0.5;
+			Vector3 ofs = aabb.position + half_extents;
+
+			simd4f hx = _splat(half_extents.x), hy = _splat(half_extents.y), hz = _splat(half_extents.z);
+			simd4f ox = _splat(ofs.x), oy = _splat(ofs.y), oz = _splat(ofs.z);
+
+			bool outside = false;
+			for (int g = 0; g < group_count; g++) {
+				simd4f px = _add(_negate_where_positive(hx, nx[g]), ox);
+				simd4f py = _add(_negate_where_positive(hy, ny[g]), oy);
+				simd4f pz = _add(_negate_where_positive(hz, nz[g]), oz);
+				simd4f dist = _add(_add(_mul(nx[g], px), _mul(ny[g], py)), _mul(nz[g], pz));
+				if (_any_greater(dist, d[g])) {
+					outside = true;
+					break;
+				}
+			}
+
+			if (!outside)
+				r_indices[found++] = i;
+		}
+
+		return found;
+	}
+#endif
+
+	for (int i = 0; i < p_count; i++) {
+		if (p_aabbs[i].intersects_convex_shape(p_planes, p_plane_count))
+			r_indices[found++] = i;
+	}
+
+	return found;
+}
+
+const char *MathBatch::get_backend_name() {
+
+#if defined(MATH_BATCH_SSE)
+	return "SSE";
+#elif defined(MATH_BATCH_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
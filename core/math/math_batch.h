@@ -0,0 +1,67 @@
+/*************************************************************************/
+/*  math_batch.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MATH_BATCH_H
+#define MATH_BATCH_H
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/math/transform.h"
+
+/**
+ * Transform and culling operations over arrays, for code that would otherwise call
+ * Transform::xform() and friends once per element (particles, multimesh instances,
+ * spatial partitioning). Uses SSE or NEON when real_t is float and the target
+ * supports it, and falls back to scalar code with the same results otherwise.
+ */
+class MathBatch {
+	MathBatch();
+
+public:
+	/* p_src and r_dst may be the same array in all the functions below */
+
+	static void xform_points(const Transform &p_xform, const Vector3 *p_src, Vector3 *r_dst, int p_count);
+	static void xform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count); ///< no translation, use for directions and normals
+	static void xform_aabbs(const Transform &p_xform, const AABB *p_src, AABB *r_dst, int p_count);
+
+	/* MultiMesh/CPUParticles instance buffers store a transform as 12 floats, a 3x4 row-major
+	 * matrix (basis row followed by the origin component), every p_stride floats. */
+
+	static AABB xform_aabb_merged(const AABB &p_aabb, const float *p_rows, int p_stride, int p_count); ///< p_aabb transformed by every matrix in the buffer, merged
+	static void xform_to_rows(const Transform &p_xform, const Transform &p_transform, float *r_rows); ///< writes p_xform * p_transform as one 3x4 row-major matrix
+
+	// Writes the index of every AABB touching the convex shape (same test as
+	// AABB::intersects_convex_shape) to r_indices, returns how many were written.
+	static int cull_aabbs_convex(const Plane *p_planes, int p_plane_count, const AABB *p_aabbs, int p_count, int *r_indices);
+
+	static const char *get_backend_name();
+};
+
+#endif // MATH_BATCH_H
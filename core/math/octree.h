@@ -34,6 +34,7 @@
 #include "core/list.h"
 #include "core/map.h"
 #include "core/math/aabb.h"
+#include "core/math/math_batch.h"
 #include "core/math/vector3.h"
 #include "core/print_string.h"
 #include "core/variant.h"
@@ -348,6 +349,7 @@ private:
 	};
 
 	void _cull_convex(Octant *p_octant, _CullConvexData *p_cull);
+	bool _cull_convex_elements(List<Element *, AL> &p_elements, _CullConvexData *p_cull);
 	void _cull_aabb(Octant *p_octant, const AABB &p_aabb, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
 	void _cull_segment(Octant *p_octant, const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
 	void _cull_point(Octant *p_octant, const Vector3 &p_point, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
@@ -999,17 +1001,23 @@ void Octree<T, use_pairs, AL>::erase(OctreeElementID p_id) {
 }
 
 template <class T, bool use_pairs, class AL>
-void Octree<T, use_pairs, AL>::_cull_convex(Octant *p_octant, _CullConvexData *p_cull) {
+bool Octree<T, use_pairs, AL>::_cull_convex_elements(List<Element *, AL> &p_elements, _CullConvexData *p_cull) {
 
-	if (*p_cull->result_idx == p_cull->result_max)
-		return; //pointless
+	// Elements are tested against the planes in batches, returns false once the result array is full.
+	enum {
+		BATCH_SIZE = 64
+	};
 
-	if (!p_octant->elements.empty()) {
+	Element *batch[BATCH_SIZE];
+	AABB aabbs[BATCH_SIZE];
+	int inside[BATCH_SIZE];
 
-		typename List<Element *, AL>::Element *I;
-		I = p_octant->elements.front();
+	typename List<Element *, AL>::Element *I = p_elements.front();
 
-		for (; I; I = I->next()) {
+	while (I) {
+
+		int count = 0;
+		for (; I && count < BATCH_SIZE; I = I->next()) {
 
 			Element *e = I->get();
 
@@ -1017,51 +1025,64 @@ void Octree<T, use_pairs, AL>::_cull_convex(Octant *p_octant, _CullConvexData *p
 				continue;
 			e->last_pass = pass;
 
-			if (e->aabb.intersects_convex_shape(p_cull->planes, p_cull->plane_count)) {
+			batch[count] = e;
+			aabbs[count] = e->aabb;
+			count++;
+		}
+
+		int inside_count = MathBatch::cull_aabbs_convex(p_cull->planes, p_cull->plane_count, aabbs, count, inside);
 
-				if (*p_cull->result_idx < p_cull->result_max) {
-					p_cull->result_array[*p_cull->result_idx] = e->userdata;
-					(*p_cull->result_idx)++;
-				} else {
+		for (int i = 0; i < inside_count; i++) {
 
-					return; // pointless to continue
-				}
+			if (*p_cull->result_idx < p_cull->result_max) {
+				p_cull->result_array[*p_cull->result_idx] = batch[inside[i]]->userdata;
+				(*p_cull->result_idx)++;
+			} else {
+
+				return false; // pointless to continue
 			}
 		}
 	}
 
-	if (use_pairs && !p_octant->pairable_elements.empty()) {
+	return true;
+}
 
-		typename List<Element *, AL>::Element *I;
-		I = p_octant->pairable_elements.front();
+template <class T, bool use_pairs, class AL>
+void Octree<T, use_pairs, AL>::_cull_convex(Octant *p_octant, _CullConvexData *p_cull) {
 
-		for (; I; I = I->next()) {
+	if (*p_cull->result_idx == p_cull->result_max)
+		return; //pointless
 
-			Element *e = I->get();
+	if (!p_octant->elements.empty()) {
 
-			if (e->last_pass == pass || (use_pairs && !(e->pairable_type & p_cull->mask)))
-				continue;
-			e->last_pass = pass;
+		if (!_cull_convex_elements(p_octant->elements, p_cull))
+			return;
+	}
 
-			if (e->aabb.intersects_convex_shape(p_cull->planes, p_cull->plane_count)) {
+	if (use_pairs && !p_octant->pairable_elements.empty()) {
 
-				if (*p_cull->result_idx < p_cull->result_max) {
+		if (!_cull_convex_elements(p_octant->pairable_elements, p_cull))
+			return;
+	}
 
-					p_cull->result_array[*p_cull->result_idx] = e->userdata;
-					(*p_cull->result_idx)++;
-				} else {
+	Octant *children[8];
+	AABB children_aabb[8];
+	int children_inside[8];
+	int child_count = 0;
 
-					return; // pointless to continue
-				}
-			}
+	for (int i = 0; i < 8; i++) {
+
+		if (p_octant->children[i]) {
+			children[child_count] = p_octant->children[i];
+			children_aabb[child_count] = p_octant->children[i]->aabb;
+			child_count++;
 		}
 	}
 
-	for (int i = 0; i < 8; i++) {
+	int inside_count = MathBatch::cull_aabbs_convex(p_cull->planes, p_cull->plane_count, children_aabb, child_count, children_inside);
 
-		if (p_octant->children[i] && p_octant->children[i]->aabb.intersects_convex_shape(p_cull->planes, p_cull->plane_count)) {
-			_cull_convex(p_octant->children[i], p_cull);
-		}
+	for (int i = 0; i < inside_count; i++) {
+		_cull_convex(children[children_inside[i]], p_cull);
 	}
 }
 
@@ -261,7 +261,12 @@ struct PtrToArg<const T *> {
 MAKE_VECARG(String);
 MAKE_VECARG(uint8_t);
 MAKE_VECARG(int);
+#ifdef REAL_T_IS_DOUBLE
+MAKE_VECARG(real_t);
+MAKE_VECARG_ALT(real_t, float);
+#else
 MAKE_VECARG(float);
+#endif
 MAKE_VECARG(Vector2);
 MAKE_VECARG(Vector3);
 MAKE_VECARG(Color);
@@ -454,5 +459,44 @@ struct PtrToArg<const PoolVector<Face3> &> {
 	}
 };
 
+#ifdef REAL_T_IS_DOUBLE
+// PoolRealArray holds doubles, float pools are converted on the way in and out.
+template <>
+struct PtrToArg<PoolVector<float> > {
+	_FORCE_INLINE_ static PoolVector<float> convert(const void *p_ptr) {
+		const PoolVector<real_t> *dvs = reinterpret_cast<const PoolVector<real_t> *>(p_ptr);
+		PoolVector<float> ret;
+		int len = dvs->size();
+		ret.resize(len);
+		{
+			PoolVector<real_t>::Read r = dvs->read();
+			PoolVector<float>::Write w = ret.write();
+			for (int i = 0; i < len; i++) {
+				w[i] = r[i];
+			}
+		}
+		return ret;
+	}
+	_FORCE_INLINE_ static void encode(PoolVector<float> p_vec, void *p_ptr) {
+		PoolVector<real_t> *arr = reinterpret_cast<PoolVector<real_t> *>(p_ptr);
+		int len = p_vec.size();
+		arr->resize(len);
+		{
+			PoolVector<float>::Read r = p_vec.read();
+			PoolVector<real_t>::Write w = arr->write();
+			for (int i = 0; i < len; i++) {
+				w[i] = r[i];
+			}
+		}
+	}
+};
+template <>
+struct PtrToArg<const PoolVector<float> &> {
+	_FORCE_INLINE_ static PoolVector<float> convert(const void *p_ptr) {
+		return PtrToArg<PoolVector<float> >::convert(p_ptr);
+	}
+};
+#endif
+
 #endif // METHOD_PTRCALL_H
 #endif
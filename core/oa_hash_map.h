@@ -240,6 +240,21 @@ public:
 		return false;
 	}
 
+	/**
+	 * returns a pointer to the value if found, NULL otherwise.
+	 *
+	 * the pointer is only valid until the map is modified.
+	 */
+	TValue *lookup_ptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &values[pos];
+		}
+		return NULL;
+	}
+
 	_FORCE_INLINE_ bool has(const TKey &p_key) const {
 		uint32_t _pos = 0;
 		return _lookup_pos(p_key, _pos);
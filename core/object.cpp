@@ -41,19 +41,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-
-	Object *obj;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj = p_obj;
-		obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		obj->_lock_index.unref();
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -549,13 +536,21 @@ Variant Object::get(const StringName &p_name, bool *r_valid) const {
 }
 
 void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid) {
+
+	_set_indexed(NULL, p_names, p_value, r_valid);
+}
+
+void Object::_set_indexed(const PropertyHandle *p_handle, const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid) {
 	if (p_names.empty()) {
 		if (r_valid)
 			*r_valid = false;
 		return;
 	}
 	if (p_names.size() == 1) {
-		set(p_names[0], p_value, r_valid);
+		if (p_handle)
+			_set_direct(*p_handle, p_value, r_valid);
+		else
+			set(p_names[0], p_value, r_valid);
 		return;
 	}
 
@@ -564,7 +559,7 @@ void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_val
 
 	List<Variant> value_stack;
 
-	value_stack.push_back(get(p_names[0], r_valid));
+	value_stack.push_back(p_handle ? _get_direct(*p_handle, r_valid) : get(p_names[0], r_valid));
 
 	if (!*r_valid) {
 		value_stack.clear();
@@ -593,7 +588,10 @@ void Object::set_indexed(const Vector<StringName> &p_names, const Variant &p_val
 		}
 	}
 
-	set(p_names[0], value_stack.back()->get(), r_valid);
+	if (p_handle)
+		_set_direct(*p_handle, value_stack.back()->get(), r_valid);
+	else
+		set(p_names[0], value_stack.back()->get(), r_valid);
 	value_stack.pop_back();
 
 	ERR_FAIL_COND(!value_stack.empty());
@@ -620,6 +618,93 @@ Variant Object::get_indexed(const Vector<StringName> &p_names, bool *r_valid) co
 	return current_value;
 }
 
+Object::PropertyHandle Object::get_property_handle(const Vector<StringName> &p_names) const {
+
+	PropertyHandle handle;
+	handle.path = p_names;
+
+	if (p_names.empty())
+		return handle;
+
+	const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(get_class_name(), p_names[0]);
+	if (psg && psg->_setptr && psg->_getptr) {
+		handle.setter = psg->_setptr;
+		handle.getter = psg->_getptr;
+		handle.index = psg->index;
+	}
+
+	return handle;
+}
+
+void Object::_set_direct(const PropertyHandle &p_handle, const Variant &p_value, bool *r_valid) {
+
+#ifdef TOOLS_ENABLED
+
+	_edited = true;
+#endif
+
+	Variant::CallError ce;
+
+	if (p_handle.index >= 0) {
+		Variant index = p_handle.index;
+		const Variant *arg[2] = { &index, &p_value };
+		p_handle.setter->call(this, arg, 2, ce);
+	} else {
+		const Variant *arg[1] = { &p_value };
+		p_handle.setter->call(this, arg, 1, ce);
+	}
+
+	if (r_valid)
+		*r_valid = ce.error == Variant::CallError::CALL_OK;
+}
+
+Variant Object::_get_direct(const PropertyHandle &p_handle, bool *r_valid) const {
+
+	Variant::CallError ce;
+	Variant ret;
+
+	if (p_handle.index >= 0) {
+		Variant index = p_handle.index;
+		const Variant *arg[1] = { &index };
+		ret = p_handle.getter->call(const_cast<Object *>(this), arg, 1, ce);
+	} else {
+		ret = p_handle.getter->call(const_cast<Object *>(this), NULL, 0, ce);
+	}
+
+	if (r_valid)
+		*r_valid = ce.error == Variant::CallError::CALL_OK;
+	return ret;
+}
+
+void Object::set_by_handle(const PropertyHandle &p_handle, const Variant &p_value, bool *r_valid) {
+
+	// A script may shadow the property or take it over through _set(), so only
+	// script-less objects can skip the regular lookup.
+	if (!p_handle.is_direct() || script_instance) {
+		_set_indexed(NULL, p_handle.path, p_value, r_valid);
+		return;
+	}
+
+	_set_indexed(&p_handle, p_handle.path, p_value, r_valid);
+}
+
+Variant Object::get_by_handle(const PropertyHandle &p_handle, bool *r_valid) const {
+
+	if (!p_handle.is_direct() || script_instance) {
+		return get_indexed(p_handle.path, r_valid);
+	}
+
+	bool valid = false;
+	Variant current_value = _get_direct(p_handle, &valid);
+	for (int i = 1; valid && i < p_handle.path.size(); i++) {
+		current_value = current_value.get_named(p_handle.path[i], &valid);
+	}
+	if (r_valid)
+		*r_valid = valid;
+
+	return current_value;
+}
+
 void Object::get_property_list(List<PropertyInfo> *p_list, bool p_reversed) const {
 
 	if (script_instance && p_reversed) {
@@ -926,6 +1011,14 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
 	return ret;
 }
 
+Variant Object::call_method_bind(MethodBind *p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+
+	r_error.error = Variant::CallError::CALL_OK;
+
+	OBJ_DEBUG_LOCK
+	return p_method->call(this, p_args, p_argcount, r_error);
+}
+
 void Object::notification(int p_notification, bool p_reversed) {
 
 	_notificationv(p_notification, p_reversed);
@@ -397,6 +397,7 @@ public:                                                        \
 private:
 
 class ScriptInstance;
+class MethodBind;
 typedef uint64_t ObjectID;
 
 class Object {
@@ -428,6 +429,26 @@ public:
 		Connection(const Variant &p_variant);
 	};
 
+	// A property path resolved once against an object's class, for code that writes
+	// the same property many times (animation tracks, tweens). When the first name is
+	// a bound property, set_by_handle()/get_by_handle() call its setter/getter directly
+	// instead of going through the script instance, ClassDB lookup and _set/_get chain.
+	struct PropertyHandle {
+
+		Vector<StringName> path;
+		MethodBind *setter;
+		MethodBind *getter;
+		int index;
+
+		_FORCE_INLINE_ bool is_direct() const { return setter && getter; }
+
+		PropertyHandle() {
+			setter = NULL;
+			getter = NULL;
+			index = -1;
+		}
+	};
+
 private:
 	enum {
 		MAX_SCRIPT_INSTANCE_BINDINGS = 8
@@ -502,6 +523,9 @@ private:
 	Variant _get_bind(const String &p_name) const;
 	void _set_indexed_bind(const NodePath &p_name, const Variant &p_value);
 	Variant _get_indexed_bind(const NodePath &p_name) const;
+	void _set_direct(const PropertyHandle &p_handle, const Variant &p_value, bool *r_valid);
+	Variant _get_direct(const PropertyHandle &p_handle, bool *r_valid) const;
+	void _set_indexed(const PropertyHandle *p_handle, const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid);
 
 	void property_list_changed_notify();
 
@@ -579,8 +603,10 @@ public:
 		for (Set<Object *>::Element *E = change_receptors.front(); E; E = E->next())
 			((Object *)(E->get()))->_changed_callback(this, p_property);
 	}
+	_FORCE_INLINE_ void _mark_edited() { _edited = true; }
 #else
 	_FORCE_INLINE_ void _change_notify(const char *p_what = "") {}
+	_FORCE_INLINE_ void _mark_edited() {}
 #endif
 	static void *get_class_ptr_static() {
 		static int ptr;
@@ -658,6 +684,9 @@ public:
 	Variant get(const StringName &p_name, bool *r_valid = NULL) const;
 	void set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid = NULL);
 	Variant get_indexed(const Vector<StringName> &p_names, bool *r_valid = NULL) const;
+	PropertyHandle get_property_handle(const Vector<StringName> &p_names) const;
+	void set_by_handle(const PropertyHandle &p_handle, const Variant &p_value, bool *r_valid = NULL);
+	Variant get_by_handle(const PropertyHandle &p_handle, bool *r_valid = NULL) const;
 
 	void get_property_list(List<PropertyInfo> *p_list, bool p_reversed = false) const;
 
@@ -665,6 +694,7 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	Variant call_method_bind(MethodBind *p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error); // bind already resolved by caller, skips script instance and ClassDB lookup
 	virtual void call_multilevel(const StringName &p_method, const Variant **p_args, int p_argcount);
 	virtual void call_multilevel_reversed(const StringName &p_method, const Variant **p_args, int p_argcount);
 	Variant call(const StringName &p_name, VARIANT_ARG_LIST); // C++ helper
@@ -754,6 +784,24 @@ public:
 	virtual ~Object();
 };
 
+#ifdef DEBUG_ENABLED
+
+// Keeps an object from being freed while one of its methods runs, for callers bypassing Object::call().
+struct _ObjectDebugLock {
+
+	Object *obj;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj = p_obj;
+		obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		obj->_lock_index.unref();
+	}
+};
+
+#endif
+
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
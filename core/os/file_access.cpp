@@ -31,9 +31,13 @@
 #include "file_access.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/hash_map.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
+#include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/project_settings.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = { 0, 0 };
@@ -716,6 +720,300 @@ String FileAccess::get_sha256(const String &p_file) {
 	return String::hex_encode_buffer(hash, 32);
 }
 
+/* ASYNC READS */
+
+// I/O bound, so this doesn't depend on the amount of cores.
+#define ASYNC_READ_THREADS 4
+
+struct AsyncRead {
+	String path;
+	uint64_t offset;
+	uint8_t *dst;
+	int length;
+	FileAccess::AsyncReadCallback callback;
+	void *userdata;
+	bool started;
+	FileAccess::AsyncReadStatus status;
+	Error error;
+	int read;
+	Semaphore *done; // created by wait_async_read() when it has to block, posted once the read finished
+};
+
+static Mutex *async_read_mutex = NULL;
+static Semaphore *async_read_semaphore = NULL;
+static HashMap<int, AsyncRead> async_reads;
+static List<int> async_read_queue;
+static Vector<Thread *> async_read_threads;
+static int async_read_last_id = 0;
+static bool async_read_exit = false;
+
+// Runs a request, reusing the file the thread has open when it's the same one.
+static void _async_read_run(int p_request, FileAccess *&r_file, String &r_file_path) {
+
+	if (async_read_mutex) {
+		async_read_mutex->lock();
+	}
+
+	AsyncRead *rr = async_reads.getptr(p_request);
+	if (!rr || rr->started) {
+		if (async_read_mutex) {
+			async_read_mutex->unlock();
+		}
+		return; //picked by another thread
+	}
+	rr->started = true;
+	AsyncRead request = *rr;
+
+	if (async_read_mutex) {
+		async_read_mutex->unlock();
+	}
+
+	if (r_file && r_file_path != request.path) {
+		memdelete(r_file);
+		r_file = NULL;
+	}
+	Error err = OK;
+	if (!r_file) {
+		r_file = FileAccess::open(request.path, FileAccess::READ, &err);
+		r_file_path = r_file ? request.path : String();
+	}
+
+	int read = 0;
+	if (r_file) {
+		r_file->seek(request.offset);
+		read = r_file->get_buffer(request.dst, request.length);
+		err = read < request.length ? ERR_FILE_EOF : OK;
+	}
+
+	if (async_read_mutex) {
+		async_read_mutex->lock();
+	}
+
+	rr = async_reads.getptr(p_request);
+	rr->read = read;
+	rr->error = err;
+	rr->status = r_file ? FileAccess::ASYNC_READ_DONE : FileAccess::ASYNC_READ_FAILED;
+	if (rr->done) {
+		rr->done->post();
+	}
+
+	if (async_read_mutex) {
+		async_read_mutex->unlock();
+	}
+
+	if (request.callback) {
+		request.callback(request.userdata, p_request);
+	}
+}
+
+static void _async_read_thread(void *p_userdata) {
+
+	FileAccess *file = NULL;
+	String file_path;
+
+	while (true) {
+
+		async_read_semaphore->wait();
+
+		async_read_mutex->lock();
+		if (async_read_exit) {
+			async_read_mutex->unlock();
+			break;
+		}
+		int request = -1;
+		if (async_read_queue.size()) {
+			request = async_read_queue.front()->get();
+			async_read_queue.pop_front();
+		}
+		bool idle = async_read_queue.empty();
+		async_read_mutex->unlock();
+
+		if (request != -1) {
+			_async_read_run(request, file, file_path);
+		}
+
+		// Don't hold on to files between bursts of reads, they may be rewritten (like save games).
+		if (idle && file) {
+			memdelete(file);
+			file = NULL;
+			file_path = String();
+		}
+	}
+
+	if (file) {
+		memdelete(file);
+	}
+}
+
+int FileAccess::read_async(const String &p_path, uint64_t p_offset, uint8_t *p_dst, int p_length, AsyncReadCallback p_callback, void *p_userdata) {
+
+	ERR_FAIL_COND_V(!p_dst || p_length < 0, -1);
+
+	AsyncRead request;
+	request.path = p_path;
+	request.offset = p_offset;
+	request.dst = p_dst;
+	request.length = p_length;
+	request.callback = p_callback;
+	request.userdata = p_userdata;
+	request.started = false;
+	request.status = ASYNC_READ_PENDING;
+	request.error = OK;
+	request.read = 0;
+	request.done = NULL;
+
+	if (async_read_mutex) {
+		async_read_mutex->lock();
+
+		if (async_read_threads.empty() && !async_read_exit) {
+			for (int i = 0; i < ASYNC_READ_THREADS; i++) {
+				async_read_threads.push_back(Thread::create(_async_read_thread, NULL));
+			}
+		}
+	}
+
+	int id = ++async_read_last_id;
+	async_reads[id] = request;
+
+	if (async_read_mutex) {
+		async_read_queue.push_back(id);
+		async_read_mutex->unlock();
+		async_read_semaphore->post();
+	} else {
+		//no threads, read right away
+		FileAccess *file = NULL;
+		String file_path;
+		_async_read_run(id, file, file_path);
+		if (file) {
+			memdelete(file);
+		}
+	}
+
+	return id;
+}
+
+FileAccess::AsyncReadStatus FileAccess::get_async_read_status(int p_request) {
+
+	if (async_read_mutex) {
+		async_read_mutex->lock();
+	}
+
+	AsyncReadStatus status = ASYNC_READ_INVALID;
+	AsyncRead *rr = async_reads.getptr(p_request);
+	if (rr) {
+		status = rr->status;
+	}
+
+	if (async_read_mutex) {
+		async_read_mutex->unlock();
+	}
+
+	return status;
+}
+
+int FileAccess::wait_async_read(int p_request, Error *r_error) {
+
+	FileAccess *file = NULL;
+	String file_path;
+
+	while (true) {
+
+		if (async_read_mutex) {
+			async_read_mutex->lock();
+		}
+
+		AsyncRead *rr = async_reads.getptr(p_request);
+		if (!rr) {
+			if (async_read_mutex) {
+				async_read_mutex->unlock();
+			}
+			if (r_error) {
+				*r_error = ERR_INVALID_PARAMETER;
+			}
+			ERR_FAIL_V_MSG(0, "Invalid asynchronous read request: " + itos(p_request) + ".");
+		}
+
+		if (rr->status != ASYNC_READ_PENDING) {
+			int read = rr->read;
+			if (r_error) {
+				*r_error = rr->error;
+			}
+			if (rr->done) {
+				memdelete(rr->done);
+			}
+			async_reads.erase(p_request);
+
+			if (async_read_mutex) {
+				async_read_mutex->unlock();
+			}
+			if (file) {
+				memdelete(file);
+			}
+			return read;
+		}
+
+		// Rather than waiting for the I/O threads to get to it, read it right away.
+		// Otherwise sleep until the thread reading it is done.
+		Semaphore *done = NULL;
+		if (rr->started) {
+			if (!rr->done) {
+				rr->done = Semaphore::create();
+			}
+			done = rr->done;
+		}
+
+		if (async_read_mutex) {
+			async_read_mutex->unlock();
+		}
+
+		if (done) {
+			done->wait();
+		} else {
+			_async_read_run(p_request, file, file_path);
+		}
+	}
+}
+
+void FileAccess::initialize_async_reads() {
+
+#ifndef NO_THREADS
+	async_read_mutex = Mutex::create();
+	async_read_semaphore = Semaphore::create();
+#endif
+}
+
+void FileAccess::finalize_async_reads() {
+
+	if (!async_read_mutex) {
+		return;
+	}
+
+	async_read_mutex->lock();
+	async_read_exit = true;
+	async_read_mutex->unlock();
+	for (int i = 0; i < async_read_threads.size(); i++) {
+		async_read_semaphore->post();
+	}
+	for (int i = 0; i < async_read_threads.size(); i++) {
+		Thread::wait_to_finish(async_read_threads[i]);
+		memdelete(async_read_threads[i]);
+	}
+	async_read_threads.clear();
+	async_read_queue.clear();
+	const int *K = NULL;
+	while ((K = async_reads.next(K))) {
+		if (async_reads[*K].done) {
+			memdelete(async_reads[*K].done);
+		}
+	}
+	async_reads.clear();
+
+	memdelete(async_read_semaphore);
+	async_read_semaphore = NULL;
+	memdelete(async_read_mutex);
+	async_read_mutex = NULL;
+}
+
 FileAccess::FileAccess() {
 
 	endian_swap = false;
@@ -52,6 +52,15 @@ public:
 
 	typedef void (*FileCloseFailNotify)(const String &);
 
+	enum AsyncReadStatus {
+		ASYNC_READ_INVALID,
+		ASYNC_READ_PENDING,
+		ASYNC_READ_DONE,
+		ASYNC_READ_FAILED,
+	};
+
+	typedef void (*AsyncReadCallback)(void *p_userdata, int p_request);
+
 	typedef FileAccess *(*CreateFunc)();
 	bool endian_swap;
 	bool real_is_double;
@@ -113,6 +122,7 @@ public:
 	virtual real_t get_real() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const; ///< get an array of bytes
+	virtual const uint8_t *get_buffer_view(int p_length) const { return NULL; } ///< get an array of bytes in place, valid while the file is open, NULL if unsupported (use get_buffer)
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -170,6 +180,12 @@ public:
 	static Vector<uint8_t> get_file_as_array(const String &p_path, Error *r_error = NULL);
 	static String get_file_as_string(const String &p_path, Error *r_error = NULL);
 
+	static int read_async(const String &p_path, uint64_t p_offset, uint8_t *p_dst, int p_length, AsyncReadCallback p_callback = NULL, void *p_userdata = NULL); ///< queue a read on the I/O threads, the callback is called from one of them when done
+	static AsyncReadStatus get_async_read_status(int p_request);
+	static int wait_async_read(int p_request, Error *r_error = NULL); ///< every request must be waited for, returns the amount of bytes read
+	static void initialize_async_reads();
+	static void finalize_async_reads();
+
 	template <class T>
 	static void make_default(AccessType p_access) {
 
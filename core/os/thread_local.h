@@ -63,6 +63,7 @@
 #define _THREAD_LOCAL_(m_t) ThreadLocal<m_t>
 #endif
 
+#include "core/os/memory.h"
 #include "core/typedefs.h"
 
 #ifdef WINDOWS_ENABLED
@@ -104,6 +104,7 @@ void register_core_types() {
 
 	StringName::setup();
 	ResourceLoader::initialize();
+	FileAccess::initialize_async_reads();
 
 	register_global_constants();
 	register_variant_methods();
@@ -299,6 +300,7 @@ void unregister_core_types() {
 	if (ip)
 		memdelete(ip);
 
+	FileAccess::finalize_async_reads();
 	ResourceLoader::finalize();
 
 	ClassDB::cleanup_defaults();
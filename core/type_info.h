@@ -226,6 +226,9 @@ struct GetTypeInfo<const Variant &> {
 
 MAKE_TEMPLATE_TYPE_INFO(Vector, uint8_t, Variant::POOL_BYTE_ARRAY)
 MAKE_TEMPLATE_TYPE_INFO(Vector, int, Variant::POOL_INT_ARRAY)
+#ifdef REAL_T_IS_DOUBLE
+MAKE_TEMPLATE_TYPE_INFO(Vector, real_t, Variant::POOL_REAL_ARRAY)
+#endif
 MAKE_TEMPLATE_TYPE_INFO(Vector, float, Variant::POOL_REAL_ARRAY)
 MAKE_TEMPLATE_TYPE_INFO(Vector, String, Variant::POOL_STRING_ARRAY)
 MAKE_TEMPLATE_TYPE_INFO(Vector, Vector2, Variant::POOL_VECTOR2_ARRAY)
@@ -239,6 +242,9 @@ MAKE_TEMPLATE_TYPE_INFO(Vector, StringName, Variant::POOL_STRING_ARRAY)
 
 MAKE_TEMPLATE_TYPE_INFO(PoolVector, Plane, Variant::ARRAY)
 MAKE_TEMPLATE_TYPE_INFO(PoolVector, Face3, Variant::POOL_VECTOR3_ARRAY)
+#ifdef REAL_T_IS_DOUBLE
+MAKE_TEMPLATE_TYPE_INFO(PoolVector, float, Variant::POOL_REAL_ARRAY)
+#endif
 
 template <typename T>
 struct GetTypeInfo<T *, typename EnableIf<TypeInherits<Object, T>::value>::type> {
@@ -1965,6 +1965,26 @@ Variant::operator PoolVector<Face3>() const {
 	return faces;
 }
 
+#ifdef REAL_T_IS_DOUBLE
+Variant::operator PoolVector<float>() const {
+
+	PoolVector<real_t> from = operator PoolVector<real_t>();
+	PoolVector<float> to;
+	int len = from.size();
+	if (len == 0)
+		return to;
+
+	to.resize(len);
+	PoolVector<float>::Write w = to.write();
+	PoolVector<real_t>::Read r = from.read();
+
+	for (int i = 0; i < len; i++)
+		w[i] = r[i];
+
+	return to;
+}
+
+#endif
 Variant::operator Vector<Plane>() const {
 
 	Array va = operator Array();
@@ -2031,6 +2051,21 @@ Variant::operator Vector<real_t>() const {
 	return to;
 }
 
+#ifdef REAL_T_IS_DOUBLE
+Variant::operator Vector<float>() const {
+
+	PoolVector<real_t> from = operator PoolVector<real_t>();
+	Vector<float> to;
+	int len = from.size();
+	to.resize(len);
+	for (int i = 0; i < len; i++) {
+
+		to.write[i] = from[i];
+	}
+	return to;
+}
+#endif
+
 Variant::operator Vector<String>() const {
 
 	PoolVector<String> from = operator PoolVector<String>();
@@ -2428,6 +2463,27 @@ Variant::Variant(const PoolVector<Face3> &p_face_array) {
 	*this = vertices;
 }
 
+#ifdef REAL_T_IS_DOUBLE
+Variant::Variant(const PoolVector<float> &p_float_array) {
+
+	PoolVector<real_t> reals;
+	int len = p_float_array.size();
+	reals.resize(len);
+
+	if (len) {
+		PoolVector<float>::Read r = p_float_array.read();
+		PoolVector<real_t>::Write w = reals.write();
+
+		for (int i = 0; i < len; i++)
+			w[i] = r[i];
+	}
+
+	type = NIL;
+
+	*this = reals;
+}
+#endif
+
 /* helpers */
 
 Variant::Variant(const Vector<Variant> &p_array) {
@@ -2474,6 +2530,19 @@ Variant::Variant(const Vector<real_t> &p_array) {
 	*this = v;
 }
 
+#ifdef REAL_T_IS_DOUBLE
+Variant::Variant(const Vector<float> &p_array) {
+
+	type = NIL;
+	PoolVector<real_t> v;
+	int len = p_array.size();
+	v.resize(len);
+	for (int i = 0; i < len; i++)
+		v.set(i, p_array[i]);
+	*this = v;
+}
+#endif
+
 Variant::Variant(const Vector<String> &p_array) {
 
 	type = NIL;
@@ -212,11 +212,17 @@ public:
 	operator PoolVector<Color>() const;
 	operator PoolVector<Plane>() const;
 	operator PoolVector<Face3>() const;
+#ifdef REAL_T_IS_DOUBLE
+	operator PoolVector<float>() const; // helper, converts from PoolRealArray
+#endif
 
 	operator Vector<Variant>() const;
 	operator Vector<uint8_t>() const;
 	operator Vector<int>() const;
 	operator Vector<real_t>() const;
+#ifdef REAL_T_IS_DOUBLE
+	operator Vector<float>() const; // helper
+#endif
 	operator Vector<String>() const;
 	operator Vector<StringName>() const;
 	operator Vector<Vector3>() const;
@@ -277,11 +283,17 @@ public:
 	Variant(const PoolVector<Vector3> &p_vector3_array);
 	Variant(const PoolVector<Color> &p_color_array);
 	Variant(const PoolVector<Face3> &p_face_array);
+#ifdef REAL_T_IS_DOUBLE
+	Variant(const PoolVector<float> &p_float_array); // helper, stored as PoolRealArray
+#endif
 
 	Variant(const Vector<Variant> &p_array);
 	Variant(const Vector<uint8_t> &p_array);
 	Variant(const Vector<int> &p_array);
 	Variant(const Vector<real_t> &p_array);
+#ifdef REAL_T_IS_DOUBLE
+	Variant(const Vector<float> &p_array); // helper
+#endif
 	Variant(const Vector<String> &p_array);
 	Variant(const Vector<StringName> &p_array);
 	Variant(const Vector<Vector3> &p_array);
@@ -261,7 +261,6 @@ struct _VariantCall {
 	VCALL_LOCALMEM0R(String, capitalize);
 	VCALL_LOCALMEM3R(String, split);
 	VCALL_LOCALMEM3R(String, rsplit);
-	VCALL_LOCALMEM2R(String, split_floats);
 	VCALL_LOCALMEM0R(String, to_upper);
 	VCALL_LOCALMEM0R(String, to_lower);
 	VCALL_LOCALMEM1R(String, left);
@@ -313,6 +312,22 @@ struct _VariantCall {
 	VCALL_LOCALMEM1R(String, trim_prefix);
 	VCALL_LOCALMEM1R(String, trim_suffix);
 
+	static void _call_String_split_floats(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+
+		String *s = reinterpret_cast<String *>(p_self._data._mem);
+		Vector<float> floats = s->split_floats(*p_args[0], *p_args[1]);
+
+		PoolRealArray retval;
+		retval.resize(floats.size());
+		PoolRealArray::Write w = retval.write();
+		for (int i = 0; i < floats.size(); i++) {
+			w[i] = floats[i];
+		}
+		w.release();
+
+		r_ret = retval;
+	}
+
 	static void _call_String_to_ascii(Variant &r_ret, Variant &p_self, const Variant **p_args) {
 
 		String *s = reinterpret_cast<String *>(p_self._data._mem);
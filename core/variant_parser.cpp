@@ -35,9 +35,37 @@
 #include "core/os/keyboard.h"
 #include "core/string_buffer.h"
 
+bool VariantParser::StreamFile::_fill_readahead() {
+
+	readahead_pos = 0;
+
+	uint64_t remaining = f->get_len() - f->get_position();
+	if (remaining > 0 && remaining <= 0x7FFFFFFF) {
+		//scan the rest of the file in place if it's mapped
+		readahead = f->get_buffer_view(remaining);
+		if (readahead) {
+			readahead_size = remaining;
+			return true;
+		}
+	}
+
+	readahead = readahead_buffer;
+	readahead_size = f->get_buffer(readahead_buffer, READAHEAD_SIZE);
+	return readahead_size > 0;
+}
+
 CharType VariantParser::StreamFile::get_char() {
 
-	return f->get_8();
+	if (!readahead_enabled) {
+		return f->get_8();
+	}
+
+	if (readahead_pos >= readahead_size && !_fill_readahead()) {
+		eof = true;
+		return 0;
+	}
+
+	return readahead[readahead_pos++];
 }
 
 bool VariantParser::StreamFile::is_utf8() const {
@@ -46,6 +74,9 @@ bool VariantParser::StreamFile::is_utf8() const {
 }
 bool VariantParser::StreamFile::is_eof() const {
 
+	if (readahead_enabled) {
+		return eof;
+	}
 	return f->eof_reached();
 }
 
@@ -200,7 +231,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 			};
 			case '"': {
 
-				String str;
+				StringBuffer<> str;
+				bool ascii = true;
 				while (true) {
 
 					CharType ch = p_stream->get_char();
@@ -273,20 +305,25 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							} break;
 						}
 
+						if (res > 127)
+							ascii = false;
 						str += res;
 
 					} else {
 						if (ch == '\n')
 							line++;
+						else if (ch > 127)
+							ascii = false;
 						str += ch;
 					}
 				}
 
-				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+				String value = str.as_string();
+				if (p_stream->is_utf8() && !ascii) {
+					value.parse_utf8(value.ascii(true).get_data());
 				}
 				r_token.type = TK_STRING;
-				r_token.value = str;
+				r_token.value = value;
 				return OK;
 
 			} break;
@@ -514,8 +551,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			value = Variant();
 		else if (id == "Vector2") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -527,8 +564,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Rect2") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -540,8 +577,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Vector3") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -553,8 +590,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Transform2D" || id == "Matrix32") { //compatibility
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -569,8 +606,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Plane") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -582,8 +619,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Quat") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -596,8 +633,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "AABB" || id == "Rect3") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -610,8 +647,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "Basis" || id == "Matrix3") { //compatibility
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -623,8 +660,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Transform") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -1096,16 +1133,16 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PoolRealArray" || id == "FloatArray") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
-			PoolVector<float> arr;
+			PoolVector<real_t> arr;
 			{
 				int len = args.size();
 				arr.resize(len);
-				PoolVector<float>::Write w = arr.write();
+				PoolVector<real_t>::Write w = arr.write();
 				for (int i = 0; i < len; i++) {
 					w[i] = args[i];
 				}
@@ -1167,8 +1204,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PoolVector2Array" || id == "Vector2Array") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -1188,8 +1225,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PoolVector3Array" || id == "Vector3Array") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -53,12 +53,33 @@ public:
 	struct StreamFile : public Stream {
 
 		FileAccess *f;
+		bool readahead_enabled; // disable if the file position is used between reads
 
 		virtual CharType get_char();
 		virtual bool is_utf8() const;
 		virtual bool is_eof() const;
 
-		StreamFile() { f = NULL; }
+		StreamFile() {
+			f = NULL;
+			readahead_enabled = true;
+			readahead = NULL;
+			readahead_pos = 0;
+			readahead_size = 0;
+			eof = false;
+		}
+
+	private:
+		enum {
+			READAHEAD_SIZE = 4096
+		};
+
+		uint8_t readahead_buffer[READAHEAD_SIZE];
+		const uint8_t *readahead; // readahead_buffer, or the file itself when it's mapped in memory
+		int readahead_pos;
+		int readahead_size;
+		bool eof;
+
+		bool _fill_readahead();
 	};
 
 	struct StreamString : public Stream {
@@ -30,6 +30,7 @@
 
 #include "rasterizer_storage_gles2.h"
 
+#include "core/math/math_batch.h"
 #include "core/math/transform.h"
 #include "core/project_settings.h"
 #include "rasterizer_canvas_gles2.h"
@@ -38,6 +39,27 @@
 
 GLuint RasterizerStorageGLES2::system_fbo = 0;
 
+void RasterizerStorageGLES2::buffer_sub_data_real(GLenum p_target, GLintptr p_offset, int p_count, const real_t *p_data) {
+
+#ifdef REAL_T_IS_DOUBLE
+
+	float chunk[1024];
+	while (p_count > 0) {
+		int n = MIN(p_count, 1024);
+		for (int i = 0; i < n; i++) {
+			chunk[i] = p_data[i];
+		}
+		glBufferSubData(p_target, p_offset, n * sizeof(float), chunk);
+		p_offset += n * sizeof(float);
+		p_data += n;
+		p_count -= n;
+	}
+
+#else
+	glBufferSubData(p_target, p_offset, p_count * sizeof(float), p_data);
+#endif
+}
+
 /* TEXTURE API */
 
 #define _EXT_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
@@ -3332,32 +3354,7 @@ void RasterizerStorageGLES2::update_dirty_multimeshes() {
 
 			} else {
 
-				for (int i = 0; i < count; i += stride) {
-
-					float *dataptr = &data[i];
-
-					Transform xform;
-					xform.basis.elements[0][0] = dataptr[0];
-					xform.basis.elements[0][1] = dataptr[1];
-					xform.basis.elements[0][2] = dataptr[2];
-					xform.origin.x = dataptr[3];
-					xform.basis.elements[1][0] = dataptr[4];
-					xform.basis.elements[1][1] = dataptr[5];
-					xform.basis.elements[1][2] = dataptr[6];
-					xform.origin.y = dataptr[7];
-					xform.basis.elements[2][0] = dataptr[8];
-					xform.basis.elements[2][1] = dataptr[9];
-					xform.basis.elements[2][2] = dataptr[10];
-					xform.origin.z = dataptr[11];
-
-					AABB laabb = xform.xform(mesh_aabb);
-
-					if (i == 0) {
-						aabb = laabb;
-					} else {
-						aabb.merge_with(laabb);
-					}
-				}
+				aabb = MathBatch::xform_aabb_merged(mesh_aabb, data, stride, count / stride);
 			}
 
 			multimesh->aabb = aabb;
@@ -5425,11 +5422,11 @@ void RasterizerStorageGLES2::canvas_light_occluder_set_polylines(RID p_occluder,
 		if (!co->vertex_id) {
 			glGenBuffers(1, &co->vertex_id);
 			glBindBuffer(GL_ARRAY_BUFFER, co->vertex_id);
-			glBufferData(GL_ARRAY_BUFFER, lc * 6 * sizeof(real_t), vw.ptr(), GL_STATIC_DRAW);
+			glBufferData(GL_ARRAY_BUFFER, lc * 6 * sizeof(float), vw.ptr(), GL_STATIC_DRAW);
 		} else {
 
 			glBindBuffer(GL_ARRAY_BUFFER, co->vertex_id);
-			glBufferSubData(GL_ARRAY_BUFFER, 0, lc * 6 * sizeof(real_t), vw.ptr());
+			glBufferSubData(GL_ARRAY_BUFFER, 0, lc * 6 * sizeof(float), vw.ptr());
 		}
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
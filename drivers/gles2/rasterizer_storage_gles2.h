@@ -56,6 +56,9 @@ public:
 
 	static GLuint system_fbo;
 
+	// Uploads p_count real_t values as GL_FLOAT, narrowing them when real_t is double.
+	static void buffer_sub_data_real(GLenum p_target, GLintptr p_offset, int p_count, const real_t *p_data);
+
 	struct Config {
 
 		bool shrink_textures_x2;
@@ -334,10 +334,10 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 	uint32_t buffer_ofs = 0;
 
 	//vertex
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buffer_ofs, 2 * p_vertex_count, (const real_t *)p_vertices);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
-	buffer_ofs += sizeof(Vector2) * p_vertex_count;
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+	buffer_ofs += sizeof(float) * 2 * p_vertex_count;
 	//color
 #ifdef DEBUG_ENABLED
 	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
@@ -364,10 +364,10 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buffer_ofs, 2 * p_vertex_count, (const real_t *)p_uvs);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
-		buffer_ofs += sizeof(Vector2) * p_vertex_count;
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		buffer_ofs += sizeof(float) * 2 * p_vertex_count;
 
 	} else {
 		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
@@ -435,10 +435,10 @@ void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count
 	uint32_t buffer_ofs = 0;
 
 	//vertex
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buffer_ofs, 2 * p_vertex_count, (const real_t *)p_vertices);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
-	buffer_ofs += sizeof(Vector2) * p_vertex_count;
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+	buffer_ofs += sizeof(float) * 2 * p_vertex_count;
 	//color
 
 	if (p_singlecolor) {
@@ -458,10 +458,10 @@ void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count
 
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buffer_ofs, 2 * p_vertex_count, (const real_t *)p_uvs);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
-		buffer_ofs += sizeof(Vector2) * p_vertex_count;
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		buffer_ofs += sizeof(float) * 2 * p_vertex_count;
 
 	} else {
 		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
@@ -488,10 +488,10 @@ void RasterizerCanvasGLES3::_draw_generic_indices(GLuint p_primitive, const int
 	uint32_t buffer_ofs = 0;
 
 	//vertex
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buffer_ofs, 2 * p_vertex_count, (const real_t *)p_vertices);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
-	buffer_ofs += sizeof(Vector2) * p_vertex_count;
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+	buffer_ofs += sizeof(float) * 2 * p_vertex_count;
 	//color
 #ifdef DEBUG_ENABLED
 	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
@@ -518,10 +518,10 @@ void RasterizerCanvasGLES3::_draw_generic_indices(GLuint p_primitive, const int
 
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buffer_ofs, 2 * p_vertex_count, (const real_t *)p_uvs);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
-		buffer_ofs += sizeof(Vector2) * p_vertex_count;
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
+		buffer_ofs += sizeof(float) * 2 * p_vertex_count;
 
 	} else {
 		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
@@ -1676,9 +1676,9 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.normals.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_NORMAL);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.normals.ptr());
-					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
-					buf_ofs += sizeof(Vector3) * vertices;
+					RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buf_ofs, 3 * vertices, (const real_t *)c.normals.ptr());
+					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_FLOAT, false, sizeof(float) * 3, CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					buf_ofs += sizeof(float) * 3 * vertices;
 
 				} else {
 
@@ -1688,9 +1688,9 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.tangents.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TANGENT);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Plane) * vertices, c.tangents.ptr());
-					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_FLOAT, false, sizeof(Plane), CAST_INT_TO_UCHAR_PTR(buf_ofs));
-					buf_ofs += sizeof(Plane) * vertices;
+					RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buf_ofs, 4 * vertices, (const real_t *)c.tangents.ptr());
+					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_FLOAT, false, sizeof(float) * 4, CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					buf_ofs += sizeof(float) * 4 * vertices;
 
 				} else {
 
@@ -1713,9 +1713,9 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.uvs.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uvs.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
-					buf_ofs += sizeof(Vector2) * vertices;
+					RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buf_ofs, 2 * vertices, (const real_t *)c.uvs.ptr());
+					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					buf_ofs += sizeof(float) * 2 * vertices;
 
 				} else {
 
@@ -1725,9 +1725,9 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				if (!c.uvs2.empty()) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV2);
-					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uvs2.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
-					buf_ofs += sizeof(Vector2) * vertices;
+					RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buf_ofs, 2 * vertices, (const real_t *)c.uvs2.ptr());
+					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_FLOAT, false, sizeof(float) * 2, CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					buf_ofs += sizeof(float) * 2 * vertices;
 
 				} else {
 
@@ -1735,8 +1735,8 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				}
 
 				glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-				glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.vertices.ptr());
-				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+				RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, buf_ofs, 3 * vertices, (const real_t *)c.vertices.ptr());
+				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, false, sizeof(float) * 3, CAST_INT_TO_UCHAR_PTR(buf_ofs));
 				glDrawArrays(gl_primitive[c.primitive], 0, c.vertices.size());
 			}
 
@@ -1753,7 +1753,7 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 			RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(e->geometry);
 
 			if (!particles->use_local_coords) //not using local coordinates? then clear transform..
-				state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, Transform());
+				state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, Transform(Basis(), -state.render_origin));
 
 			int amount = particles->amount;
 
@@ -2261,7 +2261,9 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 		_set_cull(e->sort_key & RenderList::SORT_KEY_MIRROR_FLAG, e->sort_key & RenderList::SORT_KEY_CULL_DISABLED_FLAG, p_reverse_cull);
 
-		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, e->instance->transform);
+		Transform world_transform = e->instance->transform;
+		world_transform.origin -= state.render_origin;
+		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, world_transform);
 
 		_render_geometry(e);
 
@@ -2536,7 +2538,7 @@ void RasterizerSceneGLES3::_draw_sky(RasterizerStorageGLES3::Sky *p_sky, const C
 	};
 
 	if (!asymmetrical) {
-		float vw, vh, zn;
+		real_t vw, vh, zn;
 		camera.get_viewport_size(vw, vh);
 		zn = p_projection.get_z_near();
 
@@ -2551,7 +2553,8 @@ void RasterizerSceneGLES3::_draw_sky(RasterizerStorageGLES3::Sky *p_sky, const C
 	}
 
 	glBindBuffer(GL_ARRAY_BUFFER, state.sky_verts);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Vector3) * 8, vertices, GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 3 * 8, NULL, GL_DYNAMIC_DRAW);
+	RasterizerStorageGLES3::buffer_sub_data_real(GL_ARRAY_BUFFER, 0, 3 * 8, (const real_t *)vertices);
 	glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
 
 	glBindVertexArray(state.sky_array);
@@ -2589,8 +2592,19 @@ void RasterizerSceneGLES3::_setup_environment(Environment *env, const CameraMatr
 	//store camera into ubo
 	store_camera(p_cam_projection, state.ubo_data.projection_matrix);
 	store_camera(p_cam_projection.inverse(), state.ubo_data.inv_projection_matrix);
-	store_transform(p_cam_transform, state.ubo_data.camera_matrix);
-	store_transform(p_cam_transform.affine_inverse(), state.ubo_data.camera_inverse_matrix);
+
+#ifdef REAL_T_IS_DOUBLE
+	// Large world coordinates would lose precision once narrowed to float, so the world
+	// is shifted to be relative to the camera before anything reaches the shaders.
+	state.render_origin = p_cam_transform.origin;
+#else
+	state.render_origin = Vector3();
+#endif
+
+	Transform cam_transform = p_cam_transform;
+	cam_transform.origin -= state.render_origin;
+	store_transform(cam_transform, state.ubo_data.camera_matrix);
+	store_transform(cam_transform.affine_inverse(), state.ubo_data.camera_inverse_matrix);
 
 	//time global variables
 	state.ubo_data.time = storage->frame.time[0];
@@ -2653,8 +2667,8 @@ void RasterizerSceneGLES3::_setup_environment(Environment *env, const CameraMatr
 		state.ubo_data.fog_transmit_enabled = env->fog_transmit_enabled;
 		state.ubo_data.fog_transmit_curve = env->fog_transmit_curve;
 		state.ubo_data.fog_height_enabled = env->fog_height_enabled;
-		state.ubo_data.fog_height_min = env->fog_height_min;
-		state.ubo_data.fog_height_max = env->fog_height_max;
+		state.ubo_data.fog_height_min = env->fog_height_min - state.render_origin.y;
+		state.ubo_data.fog_height_max = env->fog_height_max - state.render_origin.y;
 		state.ubo_data.fog_height_curve = env->fog_height_curve;
 
 	} else {
@@ -4179,7 +4193,10 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 	state.ubo_data.shadow_dual_paraboloid_render_zfar = 0;
 	state.ubo_data.opaque_prepass_threshold = 0.99;
 
-	p_cam_projection.get_viewport_size(state.ubo_data.viewport_size[0], state.ubo_data.viewport_size[1]);
+	Size2 viewport_size;
+	p_cam_projection.get_viewport_size(viewport_size.width, viewport_size.height);
+	state.ubo_data.viewport_size[0] = viewport_size.width;
+	state.ubo_data.viewport_size[1] = viewport_size.height;
 
 	if (storage->frame.current_rt) {
 		state.ubo_data.screen_pixel_size[0] = 1.0 / storage->frame.current_rt->width;
@@ -5085,15 +5102,15 @@ void RasterizerSceneGLES3::initialize() {
 
 		glGenBuffers(1, &state.sky_verts);
 		glBindBuffer(GL_ARRAY_BUFFER, state.sky_verts);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(Vector3) * 8, NULL, GL_DYNAMIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 3 * 8, NULL, GL_DYNAMIC_DRAW);
 		glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
 
 		glGenVertexArrays(1, &state.sky_array);
 		glBindVertexArray(state.sky_array);
 		glBindBuffer(GL_ARRAY_BUFFER, state.sky_verts);
-		glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3) * 2, 0);
+		glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3 * 2, 0);
 		glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3) * 2, CAST_INT_TO_UCHAR_PTR(sizeof(Vector3)));
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 3 * 2, CAST_INT_TO_UCHAR_PTR(sizeof(float) * 3));
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
 		glBindVertexArray(0);
 		glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
@@ -161,6 +161,10 @@ public:
 
 		GLuint scene_ubo;
 
+		// World position subtracted from everything uploaded to the GPU, so float
+		// shaders only see camera-relative positions. Always zero unless REAL_T_IS_DOUBLE.
+		Vector3 render_origin;
+
 		struct EnvironmentRadianceUBO {
 
 			float transform[16];
@@ -30,6 +30,7 @@
 
 #include "rasterizer_storage_gles3.h"
 #include "core/engine.h"
+#include "core/math/math_batch.h"
 #include "core/project_settings.h"
 #include "rasterizer_canvas_gles3.h"
 #include "rasterizer_scene_gles3.h"
@@ -135,6 +136,27 @@ void glTexStorage2DCustom(GLenum target, GLsizei levels, GLenum internalformat,
 
 GLuint RasterizerStorageGLES3::system_fbo = 0;
 
+void RasterizerStorageGLES3::buffer_sub_data_real(GLenum p_target, GLintptr p_offset, int p_count, const real_t *p_data) {
+
+#ifdef REAL_T_IS_DOUBLE
+
+	float chunk[1024];
+	while (p_count > 0) {
+		int n = MIN(p_count, 1024);
+		for (int i = 0; i < n; i++) {
+			chunk[i] = p_data[i];
+		}
+		glBufferSubData(p_target, p_offset, n * sizeof(float), chunk);
+		p_offset += n * sizeof(float);
+		p_data += n;
+		p_count -= n;
+	}
+
+#else
+	glBufferSubData(p_target, p_offset, p_count * sizeof(float), p_data);
+#endif
+}
+
 Ref<Image> RasterizerStorageGLES3::_get_gl_image_and_format(const Ref<Image> &p_image, Image::Format p_format, uint32_t p_flags, Image::Format &r_real_format, GLenum &r_gl_format, GLenum &r_gl_internal_format, GLenum &r_gl_type, bool &r_compressed, bool &r_srgb, bool p_force_decompress) const {
 
 	r_compressed = false;
@@ -4955,30 +4977,7 @@ void RasterizerStorageGLES3::update_dirty_multimeshes() {
 				}
 			} else {
 
-				for (int i = 0; i < count; i += stride) {
-
-					float *dataptr = &data[i];
-					Transform xform;
-
-					xform.basis.elements[0][0] = dataptr[0];
-					xform.basis.elements[0][1] = dataptr[1];
-					xform.basis.elements[0][2] = dataptr[2];
-					xform.origin.x = dataptr[3];
-					xform.basis.elements[1][0] = dataptr[4];
-					xform.basis.elements[1][1] = dataptr[5];
-					xform.basis.elements[1][2] = dataptr[6];
-					xform.origin.y = dataptr[7];
-					xform.basis.elements[2][0] = dataptr[8];
-					xform.basis.elements[2][1] = dataptr[9];
-					xform.basis.elements[2][2] = dataptr[10];
-					xform.origin.z = dataptr[11];
-
-					AABB laabb = xform.xform(mesh_aabb);
-					if (i == 0)
-						aabb = laabb;
-					else
-						aabb.merge_with(laabb);
-				}
+				aabb = MathBatch::xform_aabb_merged(mesh_aabb, data, stride, count / stride);
 			}
 
 			multimesh->aabb = aabb;
@@ -7699,11 +7698,11 @@ void RasterizerStorageGLES3::canvas_light_occluder_set_polylines(RID p_occluder,
 		if (!co->vertex_id) {
 			glGenBuffers(1, &co->vertex_id);
 			glBindBuffer(GL_ARRAY_BUFFER, co->vertex_id);
-			glBufferData(GL_ARRAY_BUFFER, lc * 6 * sizeof(real_t), vw.ptr(), GL_STATIC_DRAW);
+			glBufferData(GL_ARRAY_BUFFER, lc * 6 * sizeof(float), vw.ptr(), GL_STATIC_DRAW);
 		} else {
 
 			glBindBuffer(GL_ARRAY_BUFFER, co->vertex_id);
-			glBufferSubData(GL_ARRAY_BUFFER, 0, lc * 6 * sizeof(real_t), vw.ptr());
+			glBufferSubData(GL_ARRAY_BUFFER, 0, lc * 6 * sizeof(float), vw.ptr());
 		}
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
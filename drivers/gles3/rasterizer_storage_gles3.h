@@ -63,6 +63,9 @@ public:
 	RasterizerSceneGLES3 *scene;
 	static GLuint system_fbo; //on some devices, such as apple, screen is rendered to yet another fbo.
 
+	// Uploads p_count real_t values as GL_FLOAT, narrowing them when real_t is double.
+	static void buffer_sub_data_real(GLenum p_target, GLintptr p_offset, int p_count, const real_t *p_data);
+
 	enum RenderArchitecture {
 		RENDER_ARCH_MOBILE,
 		RENDER_ARCH_DESKTOP,
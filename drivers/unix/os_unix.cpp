@@ -56,11 +56,14 @@
 #include <assert.h>
 #include <dlfcn.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <signal.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -446,6 +449,39 @@ Error OS_Unix::get_dynamic_library_symbol_handle(void *p_library_handle, const S
 	return OK;
 }
 
+Error OS_Unix::map_file(const String &p_path, const uint8_t *&r_data, uint64_t &r_size) {
+
+	int fd = ::open(p_path.utf8().get_data(), O_RDONLY);
+	if (fd == -1) {
+		return ERR_CANT_OPEN;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0 || uint64_t(st.st_size) > uint64_t(SIZE_MAX)) {
+		::close(fd);
+		return ERR_CANT_OPEN;
+	}
+
+	void *data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // the mapping keeps the file referenced
+
+	if (data == MAP_FAILED) {
+		return ERR_CANT_OPEN;
+	}
+
+	r_data = (const uint8_t *)data;
+	r_size = st.st_size;
+	return OK;
+}
+
+Error OS_Unix::unmap_file(const uint8_t *p_data, uint64_t p_size) {
+
+	if (munmap((void *)p_data, p_size)) {
+		return FAILED;
+	}
+	return OK;
+}
+
 Error OS_Unix::set_cwd(const String &p_cwd) {
 
 	if (chdir(p_cwd.utf8().get_data()) != 0)
@@ -32,6 +32,8 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/config_file.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/io/zip_io.h"
@@ -322,8 +324,21 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	sd.path_utf8 = p_path.utf8();
 	sd.ofs = pd->f->get_position();
 	sd.size = p_data.size();
+	sd.compressed = false;
 
-	pd->f->store_buffer(p_data.ptr(), p_data.size());
+	Vector<uint8_t> compressed;
+	if (pd->compress && p_data.size()) {
+		compressed = FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), PACK_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PACK_COMPRESSED_BLOCK_SIZE);
+		// Already compressed formats barely shrink, keep them raw so reading them costs nothing extra.
+		sd.compressed = compressed.size() && compressed.size() < p_data.size() * 9 / 10;
+	}
+
+	if (sd.compressed) {
+		sd.size = compressed.size();
+		pd->f->store_buffer(compressed.ptr(), compressed.size());
+	} else {
+		pd->f->store_buffer(p_data.ptr(), p_data.size());
+	}
 	int pad = _get_pad(PCK_PADDING, sd.size);
 	for (int i = 0; i < pad; i++) {
 		pd->f->store_8(0);
@@ -925,6 +940,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("editor/compress_pck_on_export");
 
 	Error err = export_project_files(p_preset, _save_pack_file, &pd, _add_shared_object);
 
@@ -971,7 +987,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	int64_t pck_start_pos = f->get_position();
 
 	f->store_32(0x43504447); //GDPC
-	f->store_32(1); //pack version
+	f->store_32(PACK_FORMAT_VERSION); //pack version
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(0); //hmph
@@ -993,6 +1009,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 		header_size += 8; // offset to file _with_ header size included
 		header_size += 8; // size of file
 		header_size += 16; // md5
+		header_size += 4; // flags
 	}
 
 	int header_padding = _get_pad(PCK_PADDING, header_size);
@@ -1011,6 +1028,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 		f->store_64(pd.file_ofs[i].ofs + header_padding + header_size);
 		f->store_64(pd.file_ofs[i].size); // pay attention here, this is where file is
 		f->store_buffer(pd.file_ofs[i].md5.ptr(), 16); //also save md5 for file
+		f->store_32(pd.file_ofs[i].compressed ? PACK_FILE_COMPRESSED : 0);
 	}
 
 	for (int i = 0; i < header_padding; i++) {
@@ -1426,6 +1444,8 @@ EditorExport::EditorExport() {
 	save_timer->connect("timeout", this, "_save");
 	block_save = false;
 
+	GLOBAL_DEF("editor/compress_pck_on_export", false);
+
 	singleton = this;
 }
 
@@ -57,6 +57,7 @@ public:
 		MODE_SCRIPT_TEXT,
 		MODE_SCRIPT_COMPILED,
 		MODE_SCRIPT_ENCRYPTED,
+		MODE_SCRIPT_PRECOMPILED,
 	};
 
 private:
@@ -164,6 +165,7 @@ private:
 
 		uint64_t ofs;
 		uint64_t size;
+		bool compressed;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -176,6 +178,7 @@ private:
 
 		FileAccess *f;
 		Vector<SavedData> file_ofs;
+		bool compress;
 		EditorProgress *ep;
 		Vector<SharedObject> *so_files;
 	};
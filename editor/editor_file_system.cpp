@@ -36,7 +36,9 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/safe_refcount.h"
 #include "core/variant_parser.h"
+#include "core/version.h"
 #include "editor_node.h"
 #include "editor_resource_preview.h"
 #include "editor_settings.h"
@@ -613,6 +615,14 @@ void EditorFileSystem::scan() {
 
 	_update_extensions();
 
+	//directories are watched again as they are scanned
+	if (EDITOR_GET("filesystem/directories/watch_project_changes")) {
+		watcher.start();
+	} else {
+		watcher.stop();
+	}
+	scan_begin_usec = OS::get_singleton()->get_ticks_usec();
+
 	abort_scan = false;
 	if (!use_threads) {
 		scanning = true;
@@ -625,6 +635,7 @@ void EditorFileSystem::scan() {
 		new_filesystem = NULL;
 		_update_scan_actions();
 		scanning = false;
+		print_verbose("Project scanned in " + rtos((OS::get_singleton()->get_ticks_usec() - scan_begin_usec) / 1000.0) + " msec.");
 		emit_signal("filesystem_changed");
 		emit_signal("sources_changed", sources_changed.size() > 0);
 		_queue_update_script_classes();
@@ -666,6 +677,9 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 
 	String cd = da->get_current_dir();
 
+	//watched before listing, so no change is missed
+	watcher.watch_dir(cd);
+
 	p_dir->modified_time = FileAccess::get_modified_time(cd);
 
 	da->list_dir_begin();
@@ -834,7 +848,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 	}
 }
 
-void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress) {
+void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress, bool p_recursive) {
 
 	uint64_t current_mtime = FileAccess::get_modified_time(p_dir->get_path());
 
@@ -1021,7 +1035,9 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 			scan_actions.push_back(ia);
 			continue;
 		}
-		_scan_fs_changes(p_dir->get_subdir(i), p_progress);
+		if (p_recursive) {
+			_scan_fs_changes(p_dir->get_subdir(i), p_progress);
+		}
 	}
 }
 
@@ -1066,9 +1082,38 @@ void EditorFileSystem::scan_changes() {
 	sources_changed.clear();
 	scanning_changes = true;
 	scanning_changes_done = false;
+	scan_begin_usec = OS::get_singleton()->get_ticks_usec();
 
 	abort_scan = false;
 
+	Set<String> changed_dirs;
+	if (filesystem && watcher.is_active() && watcher.get_changed_dirs(&changed_dirs)) {
+		//only the directories the watcher saw changing need a rescan
+		if (changed_dirs.size()) {
+			EditorProgressBG pr("sources", TTR("ScanSources"), 1000);
+			ScanProgress sp;
+			sp.progress = &pr;
+			sp.hi = 1;
+			sp.low = 0;
+			scan_total = 0;
+			for (Set<String>::Element *E = changed_dirs.front(); E; E = E->next()) {
+
+				//removed and moved directories are handled when scanning their parent
+				EditorFileSystemDirectory *efd = DirAccess::exists(E->get()) ? get_filesystem_path(E->get()) : NULL;
+				if (efd) {
+					_scan_fs_changes(efd, sp, false);
+				}
+			}
+			if (_update_scan_actions())
+				emit_signal("filesystem_changed");
+		}
+		scanning_changes = false;
+		scanning_changes_done = true;
+		print_verbose("Scanned " + itos(changed_dirs.size()) + " changed directories in " + rtos((OS::get_singleton()->get_ticks_usec() - scan_begin_usec) / 1000.0) + " msec.");
+		emit_signal("sources_changed", sources_changed.size() > 0);
+		return;
+	}
+
 	if (!use_threads) {
 		if (filesystem) {
 			EditorProgressBG pr("sources", TTR("ScanSources"), 1000);
@@ -1083,6 +1128,7 @@ void EditorFileSystem::scan_changes() {
 		}
 		scanning_changes = false;
 		scanning_changes_done = true;
+		print_verbose("Project scanned for changes in " + rtos((OS::get_singleton()->get_ticks_usec() - scan_begin_usec) / 1000.0) + " msec.");
 		emit_signal("sources_changed", sources_changed.size() > 0);
 	} else {
 
@@ -1141,6 +1187,7 @@ void EditorFileSystem::_notification(int p_what) {
 						Thread::wait_to_finish(thread_sources);
 						memdelete(thread_sources);
 						thread_sources = NULL;
+						print_verbose("Project scanned for changes in " + rtos((OS::get_singleton()->get_ticks_usec() - scan_begin_usec) / 1000.0) + " msec.");
 						if (_update_scan_actions())
 							emit_signal("filesystem_changed");
 						emit_signal("sources_changed", sources_changed.size() > 0);
@@ -1158,6 +1205,7 @@ void EditorFileSystem::_notification(int p_what) {
 					Thread::wait_to_finish(thread);
 					memdelete(thread);
 					thread = NULL;
+					print_verbose("Project scanned in " + rtos((OS::get_singleton()->get_ticks_usec() - scan_begin_usec) / 1000.0) + " msec.");
 					_update_scan_actions();
 					emit_signal("filesystem_changed");
 					emit_signal("sources_changed", sources_changed.size() > 0);
@@ -1699,12 +1747,15 @@ Error EditorFileSystem::_reimport_group(const String &p_group_file, const Vector
 	return err;
 }
 
-void EditorFileSystem::_reimport_file(const String &p_file) {
+void EditorFileSystem::_reimport_file(const String &p_file, bool p_update_file_system) {
 
-	EditorFileSystemDirectory *fs = NULL;
-	int cpos = -1;
-	bool found = _find_file(p_file, &fs, cpos);
-	ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
+	//without updating the file system, this only imports and can run on a thread
+	if (p_update_file_system) {
+		EditorFileSystemDirectory *fs = NULL;
+		int cpos = -1;
+		bool found = _find_file(p_file, &fs, cpos);
+		ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
+	}
 
 	//try to obtain existing params
 
@@ -1729,7 +1780,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 			}
 		}
 
-	} else {
+	} else if (p_update_file_system) {
 		late_added_files.insert(p_file); //imported files do not call update_file(), but just in case..
 	}
 
@@ -1773,14 +1824,43 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 
 	//finally, perform import!!
 	String base_path = ResourceFormatImporter::get_singleton()->get_import_base_path(p_file);
+	String source_md5 = FileAccess::get_md5(p_file);
+
+	//the same source, importer and options always import to the same files, so they can be reused from the import cache
+	String cache_key;
+	if (String(EDITOR_GET("filesystem/import/cache_path")) != String() && importer->get_save_extension() != "") {
+
+		String key = importer->get_importer_name() + ":" + itos(importer->get_format_version()) + ":" + VERSION_FULL_CONFIG + ":" + importer->get_import_settings_string() + ":" + p_file + ":" + source_md5;
+		for (List<ResourceImporter::ImportOption>::Element *E = opts.front(); E; E = E->next()) {
+
+			String value;
+			VariantWriter::write_to_string(params[E->get().option.name], value);
+			key += ":" + String(E->get().option.name) + "=" + value;
+		}
+		cache_key = key.md5_text();
+	}
 
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant metadata;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+	Error err = OK;
+	bool cached = false;
 
-	if (err != OK) {
-		ERR_PRINTS("Error importing '" + p_file + "'.");
+	if (cache_key != String()) {
+		cached = _import_cache_fetch(cache_key, base_path, importer->get_save_extension(), &import_variants, &metadata);
+		if (cached) {
+			atomic_increment(&import_cache_hits);
+		} else {
+			atomic_increment(&import_cache_misses);
+		}
+	}
+
+	if (!cached) {
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+
+		if (err != OK) {
+			ERR_PRINTS("Error importing '" + p_file + "'.");
+		}
 	}
 
 	//as import is complete, save the .import file
@@ -1873,18 +1953,35 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	FileAccess *md5s = FileAccess::open(base_path + ".md5", FileAccess::WRITE);
 	ERR_FAIL_COND_MSG(!md5s, "Cannot open MD5 file '" + base_path + ".md5'.");
 
-	md5s->store_line("source_md5=\"" + FileAccess::get_md5(p_file) + "\"");
+	md5s->store_line("source_md5=\"" + source_md5 + "\"");
 	if (dest_paths.size()) {
 		md5s->store_line("dest_md5=\"" + FileAccess::get_multiple_md5(dest_paths) + "\"\n");
 	}
 	md5s->close();
 	memdelete(md5s);
 
+	//files generated outside the .import folder are not cached, the source importer owns them
+	if (cache_key != String() && !cached && err == OK && gen_files.empty()) {
+		_import_cache_store(cache_key, base_path, importer->get_save_extension(), import_variants, metadata);
+	}
+
+	if (p_update_file_system) {
+		_update_reimported_file(p_file, importer->get_resource_type());
+	}
+}
+
+void EditorFileSystem::_update_reimported_file(const String &p_file, const String &p_type) {
+
+	EditorFileSystemDirectory *fs = NULL;
+	int cpos = -1;
+	bool found = _find_file(p_file, &fs, cpos);
+	ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
+
 	//update modified times, to avoid reimport
 	fs->files[cpos]->modified_time = FileAccess::get_modified_time(p_file);
 	fs->files[cpos]->import_modified_time = FileAccess::get_modified_time(p_file + ".import");
 	fs->files[cpos]->deps = _get_dependencies(p_file);
-	fs->files[cpos]->type = importer->get_resource_type();
+	fs->files[cpos]->type = p_type;
 	fs->files[cpos]->import_valid = ResourceLoader::is_import_valid(p_file);
 
 	//if file is currently up, maybe the source it was loaded from changed, so import math must be updated for it
@@ -1904,6 +2001,156 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	EditorResourcePreview::get_singleton()->check_for_invalidation(p_file);
 }
 
+void EditorFileSystem::_reimport_thread(void *p_userdata) {
+
+	ImportThreadData *data = (ImportThreadData *)p_userdata;
+
+	while (true) {
+
+		uint32_t index = atomic_increment(&data->next) - 1;
+		if (index >= data->count) {
+			break;
+		}
+
+		data->efs->_reimport_file(data->files[index].path, false);
+		atomic_increment(&data->done);
+	}
+}
+
+void EditorFileSystem::_reimport_files_threaded(const Vector<ImportFile> &p_files, int p_from, int p_to, EditorProgress &p_progress) {
+
+	for (int i = p_from; i < p_to; i++) {
+		if (!FileAccess::exists(p_files[i].path + ".import")) {
+			late_added_files.insert(p_files[i].path);
+		}
+	}
+
+	ImportThreadData data;
+	data.efs = this;
+	data.files = &p_files[p_from];
+	data.count = p_to - p_from;
+	data.next = 0;
+	data.done = 0;
+
+	int thread_count = MIN(OS::get_singleton()->get_processor_count(), (int)data.count);
+	Vector<Thread *> threads;
+	for (int i = 0; i < thread_count; i++) {
+		threads.push_back(Thread::create(_reimport_thread, &data));
+	}
+
+	//the main thread only reports progress, importers may not touch the editor while running
+	uint32_t reported = 0;
+	while (data.done < data.count) {
+
+		uint32_t done = data.done;
+		if (done != reported) {
+			p_progress.step(p_files[p_from + done - 1].path.get_file(), p_from + done);
+			reported = done;
+		}
+		OS::get_singleton()->delay_usec(10000);
+	}
+
+	for (int i = 0; i < threads.size(); i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+
+	Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(p_files[p_from].importer);
+	for (int i = p_from; i < p_to; i++) {
+		_update_reimported_file(p_files[i].path, importer->get_resource_type());
+	}
+}
+
+String EditorFileSystem::_get_import_cache_dir(const String &p_key) const {
+
+	String cache_path = EDITOR_GET("filesystem/import/cache_path");
+	return cache_path.plus_file(p_key.substr(0, 2)).plus_file(p_key);
+}
+
+bool EditorFileSystem::_import_cache_fetch(const String &p_key, const String &p_base_path, const String &p_extension, List<String> *r_variants, Variant *r_metadata) {
+
+	String dir = _get_import_cache_dir(p_key);
+
+	Ref<ConfigFile> entry;
+	entry.instance();
+	if (entry->load(dir.plus_file("entry.cfg")) != OK) {
+		return false;
+	}
+
+	Array variants = entry->get_value("entry", "variants", Array());
+	Vector<String> suffixes;
+	if (variants.empty()) {
+		suffixes.push_back("." + p_extension);
+	}
+	for (int i = 0; i < variants.size(); i++) {
+		suffixes.push_back("." + String(variants[i]) + "." + p_extension);
+	}
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	for (int i = 0; i < suffixes.size(); i++) {
+
+		if (da->copy(dir.plus_file("output" + suffixes[i]), ProjectSettings::get_singleton()->globalize_path(p_base_path + suffixes[i])) != OK) {
+			memdelete(da);
+			return false;
+		}
+	}
+	memdelete(da);
+
+	for (int i = 0; i < variants.size(); i++) {
+		r_variants->push_back(variants[i]);
+	}
+	*r_metadata = entry->get_value("entry", "metadata", Variant());
+
+	return true;
+}
+
+void EditorFileSystem::_import_cache_store(const String &p_key, const String &p_base_path, const String &p_extension, const List<String> &p_variants, const Variant &p_metadata) {
+
+	String dir = _get_import_cache_dir(p_key);
+	//written to a temporary directory first, so other editors sharing the cache never see a partial entry
+	String tmp_dir = dir + ".tmp" + itos(OS::get_singleton()->get_process_id());
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->dir_exists(dir) || da->make_dir_recursive(tmp_dir) != OK) {
+		memdelete(da);
+		return;
+	}
+
+	Array variants;
+	Vector<String> suffixes;
+	if (p_variants.empty()) {
+		suffixes.push_back("." + p_extension);
+	}
+	for (const List<String>::Element *E = p_variants.front(); E; E = E->next()) {
+		variants.push_back(E->get());
+		suffixes.push_back("." + E->get() + "." + p_extension);
+	}
+
+	bool ok = true;
+	for (int i = 0; i < suffixes.size() && ok; i++) {
+		ok = da->copy(ProjectSettings::get_singleton()->globalize_path(p_base_path + suffixes[i]), tmp_dir.plus_file("output" + suffixes[i])) == OK;
+	}
+
+	if (ok) {
+		Ref<ConfigFile> entry;
+		entry.instance();
+		entry->set_value("entry", "variants", variants);
+		if (p_metadata.get_type() != Variant::NIL) {
+			entry->set_value("entry", "metadata", p_metadata);
+		}
+		ok = entry->save(tmp_dir.plus_file("entry.cfg")) == OK;
+	}
+
+	if (!ok || da->rename(tmp_dir, dir) != OK) {
+		//failed writing, or another editor stored the same entry first
+		if (da->change_dir(tmp_dir) == OK) {
+			da->erase_contents_recursive();
+		}
+		da->remove(tmp_dir);
+	}
+	memdelete(da);
+}
+
 void EditorFileSystem::_find_group_files(EditorFileSystemDirectory *efd, Map<String, Vector<String> > &group_files, Set<String> &groups_to_reimport) {
 
 	int fc = efd->files.size();
@@ -1958,7 +2205,7 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 			//it's a regular file
 			ImportFile ifile;
 			ifile.path = p_files[i];
-			ifile.order = ResourceFormatImporter::get_singleton()->get_import_order(p_files[i]);
+			ResourceFormatImporter::get_singleton()->get_import_order_threads_and_importer(p_files[i], ifile.order, ifile.threaded, ifile.importer);
 			files.push_back(ifile);
 		}
 
@@ -1973,9 +2220,50 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	files.sort();
 
-	for (int i = 0; i < files.size(); i++) {
-		pr.step(files[i].path.get_file(), i);
-		_reimport_file(files[i].path);
+	struct ImporterStats {
+		int files;
+		uint64_t usec;
+		ImporterStats() {
+			files = 0;
+			usec = 0;
+		}
+	};
+	Map<String, ImporterStats> importer_stats;
+	uint64_t import_begin = OS::get_singleton()->get_ticks_usec();
+
+	int from = 0;
+	while (from < files.size()) {
+
+		//consecutive files of an importer that can run on threads are imported together
+		int to = from + 1;
+		if (use_multiple_import_threads && files[from].threaded) {
+			while (to < files.size() && files[to].threaded && files[to].importer == files[from].importer && files[to].order == files[from].order) {
+				to++;
+			}
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+		if (to - from > 1) {
+			_reimport_files_threaded(files, from, to, pr);
+		} else {
+			pr.step(files[from].path.get_file(), from);
+			_reimport_file(files[from].path);
+		}
+
+		ImporterStats &stats = importer_stats[files[from].importer];
+		stats.files += to - from;
+		stats.usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+		from = to;
+	}
+
+	if (files.size()) {
+		print_verbose("Imported " + itos(files.size()) + " files in " + rtos((OS::get_singleton()->get_ticks_usec() - import_begin) / 1000000.0) + " seconds.");
+		for (Map<String, ImporterStats>::Element *E = importer_stats.front(); E; E = E->next()) {
+			float seconds = E->get().usec / 1000000.0;
+			print_verbose("\t" + E->key() + ": " + itos(E->get().files) + " files in " + rtos(seconds) + " seconds (" + rtos(seconds > 0 ? E->get().files / seconds : 0) + " files/s).");
+		}
 	}
 
 	//reimport groups
@@ -1998,6 +2286,10 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 		emit_signal("filesystem_changed");
 	}
 
+	if (import_cache_hits || import_cache_misses) {
+		print_verbose("Import cache: " + itos(import_cache_hits) + " hits, " + itos(import_cache_misses) + " misses.");
+	}
+
 	emit_signal("resources_reimported", p_files);
 }
 
@@ -2111,6 +2403,7 @@ EditorFileSystem::EditorFileSystem() {
 
 	ResourceLoader::import = _resource_import;
 	reimport_on_missing_imported_files = GLOBAL_DEF("editor/reimport_missing_imported_files", true);
+	use_multiple_import_threads = GLOBAL_DEF("editor/import/use_multiple_threads", true);
 
 	singleton = this;
 	filesystem = memnew(EditorFileSystemDirectory); //like, empty
@@ -2119,6 +2412,9 @@ EditorFileSystem::EditorFileSystem() {
 	thread = NULL;
 	scanning = false;
 	importing = false;
+	import_cache_hits = 0;
+	import_cache_misses = 0;
+	scan_begin_usec = 0;
 	use_threads = true;
 	thread_sources = NULL;
 	new_filesystem = NULL;
@@ -35,9 +35,11 @@
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/set.h"
+#include "editor/editor_file_system_watcher.h"
 #include "scene/main/node.h"
 class FileAccess;
 
+struct EditorProgress;
 struct EditorProgressBG;
 class EditorFileSystemDirectory : public Object {
 
@@ -145,6 +147,9 @@ class EditorFileSystem : public Node {
 	bool scanning;
 	bool importing;
 	bool first_scan;
+
+	EditorFileSystemWatcher watcher;
+	uint64_t scan_begin_usec;
 	float scan_total;
 	String filesystem_settings_version_for_import;
 	bool revalidate_import_files;
@@ -190,7 +195,7 @@ class EditorFileSystem : public Node {
 
 	bool _find_file(const String &p_file, EditorFileSystemDirectory **r_d, int &r_file_pos) const;
 
-	void _scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress);
+	void _scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress, bool p_recursive = true);
 
 	void _delete_internal_files(String p_file);
 
@@ -212,7 +217,8 @@ class EditorFileSystem : public Node {
 
 	void _update_extensions();
 
-	void _reimport_file(const String &p_file);
+	void _reimport_file(const String &p_file, bool p_update_file_system = true);
+	void _update_reimported_file(const String &p_file, const String &p_type);
 	Error _reimport_group(const String &p_group_file, const Vector<String> &p_files);
 
 	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
@@ -223,12 +229,27 @@ class EditorFileSystem : public Node {
 
 	struct ImportFile {
 		String path;
+		String importer;
+		bool threaded;
 		int order;
 		bool operator<(const ImportFile &p_if) const {
-			return order < p_if.order;
+			return order == p_if.order ? (importer < p_if.importer) : (order < p_if.order);
 		}
 	};
 
+	struct ImportThreadData {
+		EditorFileSystem *efs;
+		const ImportFile *files;
+		uint32_t count;
+		volatile uint32_t next;
+		volatile uint32_t done;
+	};
+
+	static void _reimport_thread(void *p_userdata);
+	void _reimport_files_threaded(const Vector<ImportFile> &p_files, int p_from, int p_to, EditorProgress &p_progress);
+
+	bool use_multiple_import_threads;
+
 	void _scan_script_classes(EditorFileSystemDirectory *p_dir);
 	volatile bool update_script_classes_queued;
 	void _queue_update_script_classes();
@@ -245,6 +266,13 @@ class EditorFileSystem : public Node {
 
 	Set<String> group_file_cache;
 
+	volatile uint32_t import_cache_hits;
+	volatile uint32_t import_cache_misses;
+
+	String _get_import_cache_dir(const String &p_key) const;
+	bool _import_cache_fetch(const String &p_key, const String &p_base_path, const String &p_extension, List<String> *r_variants, Variant *r_metadata);
+	void _import_cache_store(const String &p_key, const String &p_base_path, const String &p_extension, const List<String> &p_variants, const Variant &p_metadata);
+
 protected:
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -272,6 +300,9 @@ public:
 	bool is_group_file(const String &p_path) const;
 	void move_group_file(const String &p_path, const String &p_new_path);
 
+	int get_import_cache_hits() const { return import_cache_hits; }
+	int get_import_cache_misses() const { return import_cache_misses; }
+
 	EditorFileSystem();
 	~EditorFileSystem();
 };
@@ -0,0 +1,178 @@
+/*************************************************************************/
+/*  editor_file_system_watcher.cpp                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "editor_file_system_watcher.h"
+
+#include "core/project_settings.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#define WATCH_MASK (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_MOVE_SELF | IN_ONLYDIR)
+
+static bool _is_network_file_system(const String &p_path) {
+
+	struct statfs st;
+	if (statfs(p_path.utf8().get_data(), &st) != 0) {
+		return true;
+	}
+
+	switch ((unsigned long)st.f_type) {
+		case 0x6969: // NFS
+		case 0x517B: // SMB
+		case 0xFE534D42: // SMB2
+		case 0xFF534D42: // CIFS
+		case 0x65735546: // FUSE (sshfs and similar)
+			return true;
+	}
+	return false;
+}
+
+void EditorFileSystemWatcher::start() {
+
+	stop();
+
+	String root = ProjectSettings::get_singleton()->get_resource_path();
+	if (_is_network_file_system(root)) {
+		return;
+	}
+
+	fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	events_lost = false;
+}
+
+void EditorFileSystemWatcher::stop() {
+
+	if (fd != -1) {
+		close(fd);
+		fd = -1;
+	}
+	watches.clear();
+}
+
+void EditorFileSystemWatcher::watch_dir(const String &p_dir) {
+
+	if (fd == -1) {
+		return;
+	}
+
+	int wd = inotify_add_watch(fd, ProjectSettings::get_singleton()->globalize_path(p_dir).utf8().get_data(), WATCH_MASK);
+	if (wd == -1) {
+		//most likely out of watches (fs.inotify.max_user_watches), go back to full scans
+		WARN_PRINTS("Can't watch directory '" + p_dir + "' for changes, the project will be fully scanned instead.");
+		stop();
+		return;
+	}
+
+	watches[wd] = p_dir;
+}
+
+bool EditorFileSystemWatcher::get_changed_dirs(Set<String> *r_dirs) {
+
+	ERR_FAIL_COND_V(fd == -1, false);
+
+	char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+	while (true) {
+
+		ssize_t len = read(fd, buffer, sizeof(buffer));
+		if (len <= 0) {
+			if (len == -1 && errno == EINTR) {
+				continue;
+			}
+			break; //EAGAIN, nothing else to read
+		}
+
+		for (char *ptr = buffer; ptr < buffer + len;) {
+
+			const struct inotify_event *event = (const struct inotify_event *)ptr;
+			ptr += sizeof(struct inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				events_lost = true;
+				continue;
+			}
+
+			Map<int, String>::Element *E = watches.find(event->wd);
+			if (!E) {
+				continue;
+			}
+
+			if (event->mask & IN_IGNORED) {
+				//directory removed, its parent reports it
+				watches.erase(E);
+			} else if (event->mask & IN_MOVE_SELF) {
+				//the watch would follow it to the new location, which gets watched again when scanned
+				r_dirs->insert(E->get().get_base_dir());
+				inotify_rm_watch(fd, event->wd);
+				watches.erase(E);
+			} else {
+				r_dirs->insert(E->get());
+			}
+		}
+	}
+
+	bool ok = !events_lost;
+	events_lost = false;
+	return ok;
+}
+
+#else
+
+void EditorFileSystemWatcher::start() {
+}
+
+void EditorFileSystemWatcher::stop() {
+}
+
+void EditorFileSystemWatcher::watch_dir(const String &p_dir) {
+}
+
+bool EditorFileSystemWatcher::get_changed_dirs(Set<String> *r_dirs) {
+
+	return false;
+}
+
+#endif
+
+EditorFileSystemWatcher::EditorFileSystemWatcher() {
+
+	fd = -1;
+	events_lost = false;
+}
+
+EditorFileSystemWatcher::~EditorFileSystemWatcher() {
+
+	stop();
+}
@@ -0,0 +1,58 @@
+/*************************************************************************/
+/*  editor_file_system_watcher.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef EDITOR_FILE_SYSTEM_WATCHER_H
+#define EDITOR_FILE_SYSTEM_WATCHER_H
+
+#include "core/map.h"
+#include "core/set.h"
+#include "core/ustring.h"
+
+// Reports which project directories changed, so rescans can skip the rest of the tree.
+// Only available with inotify (Linux), and not on network file systems where it misses remote changes.
+class EditorFileSystemWatcher {
+
+	int fd;
+	Map<int, String> watches; // watch descriptor -> directory
+	bool events_lost;
+
+public:
+	bool is_active() const { return fd != -1; }
+
+	void start();
+	void stop();
+	void watch_dir(const String &p_dir);
+	bool get_changed_dirs(Set<String> *r_dirs); // false if events were lost and everything must be scanned
+
+	EditorFileSystemWatcher();
+	~EditorFileSystemWatcher();
+};
+
+#endif // EDITOR_FILE_SYSTEM_WATCHER_H
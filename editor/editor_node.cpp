@@ -3518,7 +3518,12 @@ void EditorNode::notify_child_process_exited() {
 }
 
 void EditorNode::add_io_error(const String &p_error) {
-	_load_error_notify(singleton, p_error);
+	//deferred, as importers can run on threads
+	singleton->call_deferred("_add_io_error", p_error);
+}
+
+void EditorNode::_add_io_error(const String &p_error) {
+	_load_error_notify(this, p_error);
 }
 
 void EditorNode::_load_error_notify(void *p_ud, const String &p_text) {
@@ -5318,6 +5323,7 @@ void EditorNode::_feature_profile_changed() {
 void EditorNode::_bind_methods() {
 
 	ClassDB::bind_method("_menu_option", &EditorNode::_menu_option);
+	ClassDB::bind_method("_add_io_error", &EditorNode::_add_io_error);
 	ClassDB::bind_method("_tool_menu_option", &EditorNode::_tool_menu_option);
 	ClassDB::bind_method("_menu_confirm_current", &EditorNode::_menu_confirm_current);
 	ClassDB::bind_method("_dialog_action", &EditorNode::_dialog_action);
@@ -391,8 +391,11 @@ void EditorProfiler::_update_frame() {
 			const Metric::Category::Item &it = m.categories[i].items[j];
 
 			TreeItem *item = variables->create_item(category);
-			item->set_cell_mode(0, TreeItem::CELL_MODE_CHECK);
-			item->set_editable(0, true);
+			if (!it.count) {
+				// Counts are not plotted, they have no time.
+				item->set_cell_mode(0, TreeItem::CELL_MODE_CHECK);
+				item->set_editable(0, true);
+			}
 			item->set_text(0, it.name);
 			item->set_metadata(0, it.signature);
 			item->set_metadata(1, it.script);
@@ -400,6 +403,11 @@ void EditorProfiler::_update_frame() {
 			item->set_text_align(2, TreeItem::ALIGN_RIGHT);
 			item->set_tooltip(0, it.script + ":" + itos(it.line));
 
+			if (it.count) {
+				item->set_text(2, itos(it.calls));
+				continue;
+			}
+
 			float time = dtime == DISPLAY_SELF_TIME ? it.self : it.total;
 
 			item->set_text(1, _get_time_as_text(m, time, it.calls));
@@ -669,7 +677,7 @@ Vector<Vector<String> > EditorProfiler::get_data_as_csv() const {
 			values.write[it++] = String::num_real(c.total_time);
 
 			for (int k = 0; k < c.items.size(); k++) {
-				values.write[it++] = String::num_real(c.items[k].total);
+				values.write[it++] = c.items[k].count ? itos(c.items[k].calls) : String::num_real(c.items[k].total);
 			}
 		}
 		res.push_back(values);
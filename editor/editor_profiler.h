@@ -70,6 +70,7 @@ public:
 				float self;
 				float total;
 				int calls;
+				bool count; // calls holds a plain count sent by the game, there is no time
 			};
 
 			Vector<Item> items;
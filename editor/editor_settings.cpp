@@ -380,6 +380,7 @@ void EditorSettings::_load_defaults(Ref<ConfigFile> p_extra_config) {
 	hints["filesystem/directories/autoscan_project_path"] = PropertyInfo(Variant::STRING, "filesystem/directories/autoscan_project_path", PROPERTY_HINT_GLOBAL_DIR);
 	_initial_set("filesystem/directories/default_project_path", OS::get_singleton()->has_environment("HOME") ? OS::get_singleton()->get_environment("HOME") : OS::get_singleton()->get_system_dir(OS::SYSTEM_DIR_DOCUMENTS));
 	hints["filesystem/directories/default_project_path"] = PropertyInfo(Variant::STRING, "filesystem/directories/default_project_path", PROPERTY_HINT_GLOBAL_DIR);
+	_initial_set("filesystem/directories/watch_project_changes", true);
 
 	// On save
 	_initial_set("filesystem/on_save/compress_binary_resources", true);
@@ -400,6 +401,8 @@ void EditorSettings::_load_defaults(Ref<ConfigFile> p_extra_config) {
 	hints["filesystem/import/pvrtc_texture_tool"] = PropertyInfo(Variant::STRING, "filesystem/import/pvrtc_texture_tool", PROPERTY_HINT_GLOBAL_FILE, "");
 #endif
 	_initial_set("filesystem/import/pvrtc_fast_conversion", false);
+	_initial_set("filesystem/import/cache_path", "");
+	hints["filesystem/import/cache_path"] = PropertyInfo(Variant::STRING, "filesystem/import/cache_path", PROPERTY_HINT_GLOBAL_DIR);
 
 	/* Docks */
 
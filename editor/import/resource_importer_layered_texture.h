@@ -56,6 +56,7 @@ public:
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
 	virtual String get_save_extension() const;
 	virtual String get_resource_type() const;
+	virtual bool can_import_threaded() const { return true; }
 
 	enum Preset {
 		PRESET_3D,
@@ -245,9 +245,9 @@ bool CanvasItemEditor::_is_node_movable(const Node *p_node, bool p_popup_warning
 }
 
 void CanvasItemEditor::_snap_if_closer_float(
-		float p_value,
-		float &r_current_snap, SnapTarget &r_current_snap_target,
-		float p_target_value, SnapTarget p_snap_target,
+		real_t p_value,
+		real_t &r_current_snap, SnapTarget &r_current_snap_target,
+		real_t p_target_value, SnapTarget p_snap_target,
 		float p_radius) {
 
 	float radius = p_radius / zoom;
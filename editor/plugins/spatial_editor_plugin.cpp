@@ -426,7 +426,7 @@ Vector3 SpatialEditorViewport::_get_screen_to_space(const Vector3 &p_vector3) {
 	} else {
 		cm.set_perspective(get_fov(), get_size().aspect(), get_znear() + p_vector3.z, get_zfar());
 	}
-	float screen_w, screen_h;
+	real_t screen_w, screen_h;
 	cm.get_viewport_size(screen_w, screen_h);
 
 	Transform camera_transform;
@@ -1218,6 +1218,7 @@ ProjectExportDialog::ProjectExportDialog() {
 	script_mode->add_item(TTR("Text"), (int)EditorExportPreset::MODE_SCRIPT_TEXT);
 	script_mode->add_item(TTR("Compiled"), (int)EditorExportPreset::MODE_SCRIPT_COMPILED);
 	script_mode->add_item(TTR("Encrypted (Provide Key Below)"), (int)EditorExportPreset::MODE_SCRIPT_ENCRYPTED);
+	script_mode->add_item(TTR("Precompiled (Fast Startup)"), (int)EditorExportPreset::MODE_SCRIPT_PRECOMPILED);
 	script_mode->connect("item_selected", this, "_script_export_mode_changed");
 	script_key = memnew(LineEdit);
 	script_key->connect("text_changed", this, "_script_encryption_key_changed");
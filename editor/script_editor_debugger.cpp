@@ -368,6 +368,20 @@ void ScriptEditorDebugger::_file_selected(const String &p_file) {
 			}
 
 		} break;
+		case SAVE_SAMPLES: {
+			Error err;
+			FileAccessRef file = FileAccess::open(p_file, FileAccess::WRITE, &err);
+
+			if (err != OK) {
+				ERR_PRINTS("Failed to open " + p_file);
+				return;
+			}
+
+			// Folded call stacks, as read by flame graph tools.
+			for (Map<String, uint64_t>::Element *E = script_samples.front(); E; E = E->next()) {
+				file->store_line(E->key() + " " + itos(E->get()));
+			}
+		} break;
 	}
 }
 
@@ -976,6 +990,7 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 			EditorProfiler::Metric::Category::Item item;
 			item.calls = 1;
 			item.line = 0;
+			item.count = false;
 
 			item.name = "Physics Time";
 			item.total = metric.physics_time;
@@ -1017,7 +1032,14 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 				item.calls = 1;
 				item.line = 0;
 				item.name = values[j];
-				item.self = values[j + 1];
+				item.count = values[j + 1].get_type() == Variant::INT;
+				if (item.count) {
+					// Counters (cache hits, for example) are listed in the calls column and are not part of the category time.
+					item.calls = values[j + 1];
+					item.self = 0;
+				} else {
+					item.self = values[j + 1];
+				}
 				item.total = item.self;
 				item.signature = "categ::" + name + "::" + item.name;
 				item.name = item.name.capitalize();
@@ -1040,6 +1062,7 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 			float self = p_data[idx++];
 
 			EditorProfiler::Metric::Category::Item item;
+			item.count = false;
 			if (profiler_signature.has(signature)) {
 
 				item.signature = profiler_signature[signature];
@@ -1072,6 +1095,17 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 			profiler->add_frame_metric(metric, false);
 		else
 			profiler->add_frame_metric(metric, true);
+	} else if (p_msg == "gdscript_samples") {
+		for (int i = 0; i + 1 < p_data.size(); i += 2) {
+			String stack = p_data[i];
+			uint64_t count = p_data[i + 1];
+			Map<String, uint64_t>::Element *E = script_samples.find(stack);
+			if (E) {
+				E->get() += count;
+			} else {
+				script_samples.insert(stack, count);
+			}
+		}
 	} else if (p_msg == "network_profile") {
 		int frame_size = 6;
 		for (int i = 0; i < p_data.size(); i += frame_size) {
@@ -1543,6 +1577,7 @@ void ScriptEditorDebugger::_profiler_activate(bool p_enable) {
 
 	if (p_enable) {
 		profiler_signature.clear();
+		script_samples.clear();
 		Array msg;
 		msg.push_back("start_profiling");
 		int max_funcs = EditorSettings::get_singleton()->get("debugger/profiler_frame_max_functions");
@@ -1624,6 +1659,13 @@ void ScriptEditorDebugger::_export_csv() {
 	file_dialog->popup_centered_ratio();
 }
 
+void ScriptEditorDebugger::_export_samples() {
+
+	file_dialog->set_mode(EditorFileDialog::MODE_SAVE_FILE);
+	file_dialog_mode = SAVE_SAMPLES;
+	file_dialog->popup_centered_ratio();
+}
+
 String ScriptEditorDebugger::get_var_value(const String &p_var) const {
 	if (!breaked)
 		return String();
@@ -2198,6 +2240,7 @@ void ScriptEditorDebugger::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("debug_continue"), &ScriptEditorDebugger::debug_continue);
 	ClassDB::bind_method(D_METHOD("_output_clear"), &ScriptEditorDebugger::_output_clear);
 	ClassDB::bind_method(D_METHOD("_export_csv"), &ScriptEditorDebugger::_export_csv);
+	ClassDB::bind_method(D_METHOD("_export_samples"), &ScriptEditorDebugger::_export_samples);
 	ClassDB::bind_method(D_METHOD("_performance_draw"), &ScriptEditorDebugger::_performance_draw);
 	ClassDB::bind_method(D_METHOD("_performance_select"), &ScriptEditorDebugger::_performance_select);
 	ClassDB::bind_method(D_METHOD("_scene_tree_request"), &ScriptEditorDebugger::_scene_tree_request);
@@ -2592,6 +2635,11 @@ ScriptEditorDebugger::ScriptEditorDebugger(EditorNode *p_editor) {
 		export_csv->connect("pressed", this, "_export_csv");
 		buttons->add_child(export_csv);
 
+		export_samples = memnew(Button(TTR("Export script samples")));
+		export_samples->set_tooltip(TTR("Save the call stacks sampled while profiling GDScript, in the folded format used by flame graph tools."));
+		export_samples->connect("pressed", this, "_export_samples");
+		buttons->add_child(export_samples);
+
 		misc->add_child(buttons);
 	}
 
@@ -92,6 +92,7 @@ private:
 	Button *le_set;
 	Button *le_clear;
 	Button *export_csv;
+	Button *export_samples;
 
 	bool updating_scene_tree;
 	float inspect_scene_tree_timeout;
@@ -112,6 +113,7 @@ private:
 	enum FileDialogMode {
 		SAVE_CSV,
 		SAVE_NODE,
+		SAVE_SAMPLES,
 	};
 	FileDialogMode file_dialog_mode;
 
@@ -144,6 +146,7 @@ private:
 	Vector<TreeItem *> perf_items;
 
 	Map<int, String> profiler_signature;
+	Map<String, uint64_t> script_samples; //call stacks sampled by the GDScript profiler, and their count
 
 	Tree *perf_monitors;
 	Control *perf_draw;
@@ -228,6 +231,7 @@ private:
 	void _item_menu_id_pressed(int p_option);
 
 	void _export_csv();
+	void _export_samples();
 
 	void _clear_execution();
 
@@ -0,0 +1,347 @@
+/*************************************************************************/
+/*  test_class_db.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_class_db.h"
+
+#include "core/class_db.h"
+#include "core/os/os.h"
+
+namespace TestClassDB {
+
+// Reference lookups walking the inheritance chain one class at a time, the way
+// ClassDB resolved names before it kept per-class flattened tables.
+
+static StringName _walk_method_owner(const StringName &p_class, const StringName &p_method) {
+
+	StringName check = p_class;
+	while (check != StringName()) {
+		if (ClassDB::has_method(check, p_method, true))
+			return check;
+		check = ClassDB::get_parent_class_nocheck(check);
+	}
+	return StringName();
+}
+
+static StringName _walk_property_owner(const StringName &p_class, const StringName &p_property) {
+
+	StringName check = p_class;
+	while (check != StringName()) {
+		if (ClassDB::has_property(check, p_property, true))
+			return check;
+		check = ClassDB::get_parent_class_nocheck(check);
+	}
+	return StringName();
+}
+
+bool test_method_lookup() {
+
+	List<StringName> classes;
+	ClassDB::get_class_list(&classes);
+
+	int checked = 0;
+	for (List<StringName>::Element *E = classes.front(); E; E = E->next()) {
+
+		List<MethodInfo> methods;
+		ClassDB::get_method_list(E->get(), &methods);
+
+		for (List<MethodInfo>::Element *F = methods.front(); F; F = F->next()) {
+
+			StringName owner = _walk_method_owner(E->get(), F->get().name);
+			if (owner == StringName()) {
+				continue; //virtual method, no bind
+			}
+
+			if (!ClassDB::has_method(E->get(), F->get().name)) {
+				OS::get_singleton()->print("\thas_method(%s, %s) failed\n", String(E->get()).utf8().get_data(), String(F->get().name).utf8().get_data());
+				return false;
+			}
+			if (ClassDB::get_method(E->get(), F->get().name) != ClassDB::get_method(owner, F->get().name)) {
+				OS::get_singleton()->print("\tget_method(%s, %s) resolved to the wrong class\n", String(E->get()).utf8().get_data(), String(F->get().name).utf8().get_data());
+				return false;
+			}
+			checked++;
+		}
+
+		if (ClassDB::get_method(E->get(), "__not_a_method__") || ClassDB::has_method(E->get(), "__not_a_method__"))
+			return false;
+	}
+
+	OS::get_singleton()->print("\tchecked %i inherited method lookups\n", checked);
+	return checked > 0;
+}
+
+bool test_property_lookup() {
+
+	List<StringName> classes;
+	ClassDB::get_class_list(&classes);
+
+	int checked = 0;
+	for (List<StringName>::Element *E = classes.front(); E; E = E->next()) {
+
+		List<PropertyInfo> properties;
+		ClassDB::get_property_list(E->get(), &properties);
+
+		for (List<PropertyInfo>::Element *F = properties.front(); F; F = F->next()) {
+
+			StringName owner = _walk_property_owner(E->get(), F->get().name);
+			if (owner == StringName()) {
+				continue; //group or category
+			}
+
+			bool valid = false;
+			int index = ClassDB::get_property_index(E->get(), F->get().name, &valid);
+			if (!valid || index != ClassDB::get_property_index(owner, F->get().name)) {
+				return false;
+			}
+			if (ClassDB::get_property_type(E->get(), F->get().name) != ClassDB::get_property_type(owner, F->get().name)) {
+				return false;
+			}
+			if (!ClassDB::has_property(E->get(), F->get().name)) {
+				return false;
+			}
+			checked++;
+		}
+	}
+
+	OS::get_singleton()->print("\tchecked %i inherited property lookups\n", checked);
+	return checked > 0;
+}
+
+bool test_object_property_access() {
+
+	Object *obj = ClassDB::instance("Button");
+	if (!obj)
+		return true; //scene types not registered, nothing to check
+
+	bool pass = true;
+
+	Variant value;
+	// Property declared on Control, several levels up from Button.
+	pass = pass && ClassDB::set_property(obj, "rect_min_size", Vector2(12, 34));
+	pass = pass && ClassDB::get_property(obj, "rect_min_size", value) && Vector2(value) == Vector2(12, 34);
+	// Constant declared on Object is reachable through get_property().
+	pass = pass && ClassDB::get_property(obj, "NOTIFICATION_PREDELETE", value) && int(value) == Object::NOTIFICATION_PREDELETE;
+	pass = pass && !ClassDB::get_property(obj, "__not_a_property__", value);
+	pass = pass && !ClassDB::set_property(obj, "__not_a_property__", value);
+
+	memdelete(obj);
+	return pass;
+}
+
+bool test_property_handle() {
+
+	Object *obj = ClassDB::instance("Button");
+	if (!obj)
+		return true;
+
+	bool pass = true;
+
+	Vector<StringName> path;
+	path.push_back("rect_min_size");
+	Object::PropertyHandle handle = obj->get_property_handle(path);
+	pass = pass && handle.is_direct();
+
+	bool valid = false;
+	obj->set_by_handle(handle, Vector2(5, 6), &valid);
+	pass = pass && valid && Vector2(obj->get("rect_min_size")) == Vector2(5, 6);
+	pass = pass && Vector2(obj->get_by_handle(handle)) == Vector2(5, 6);
+
+	// Sub-property paths go through the resolved setter/getter for the first name.
+	path.push_back("y");
+	Object::PropertyHandle sub_handle = obj->get_property_handle(path);
+	obj->set_by_handle(sub_handle, 9, &valid);
+	pass = pass && valid && Vector2(obj->get("rect_min_size")) == Vector2(5, 9);
+	pass = pass && float(obj->get_by_handle(sub_handle)) == 9;
+
+	// Properties that aren't bound with a setter and getter fall back to set().
+	path.clear();
+	path.push_back("script");
+	Object::PropertyHandle script_handle = obj->get_property_handle(path);
+	pass = pass && !script_handle.is_direct();
+	obj->set_by_handle(script_handle, Variant(), &valid);
+	pass = pass && valid;
+
+	memdelete(obj);
+	return pass;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+
+	test_method_lookup,
+	test_property_lookup,
+	test_object_property_access,
+	test_property_handle,
+	0
+};
+
+#define BENCHMARK_LOOPS 1000000
+
+static void _print_benchmark(const char *p_name, uint64_t p_usec) {
+
+	OS::get_singleton()->print("\t%-40s %.1f ns/op\n", p_name, double(p_usec) * 1000.0 / BENCHMARK_LOOPS);
+}
+
+static void _run_benchmarks() {
+
+	OS::get_singleton()->print("\nBenchmarks (%i iterations each):\n", BENCHMARK_LOOPS);
+
+	const StringName cls = "Button";
+	if (!ClassDB::class_exists(cls))
+		return;
+
+	struct Lookup {
+		const char *name;
+		StringName method;
+	};
+
+	// Method bound on the class itself, a few levels up, and at the root.
+	Lookup lookups[] = {
+		{ "own", "set_flat" },
+		{ "inherited (Control)", "set_position" },
+		{ "inherited (Object)", "get_instance_id" },
+	};
+
+	for (int i = 0; i < 3; i++) {
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		int found = 0;
+		for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+			found += _walk_method_owner(cls, lookups[i].method) != StringName();
+		}
+		uint64_t walk = OS::get_singleton()->get_ticks_usec() - from;
+
+		from = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+			found += ClassDB::get_method(cls, lookups[i].method) != NULL;
+		}
+		uint64_t flat = OS::get_singleton()->get_ticks_usec() - from;
+
+		_print_benchmark((String("get_method chain walk, ") + lookups[i].name).utf8().get_data(), walk);
+		_print_benchmark((String("get_method, ") + lookups[i].name).utf8().get_data(), flat);
+		ERR_CONTINUE(found != BENCHMARK_LOOPS * 2);
+	}
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		ClassDB::has_method(cls, "get_instance_id");
+	}
+	_print_benchmark("has_method, inherited (Object)", OS::get_singleton()->get_ticks_usec() - from);
+
+	Object *obj = ClassDB::instance(cls);
+	ERR_FAIL_COND(!obj);
+
+	const StringName prop = "rect_min_size";
+	Variant value = Vector2(1, 1);
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		ClassDB::set_property(obj, prop, value);
+	}
+	_print_benchmark("set_property, inherited (Control)", OS::get_singleton()->get_ticks_usec() - from);
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		ClassDB::get_property(obj, prop, value);
+	}
+	_print_benchmark("get_property, inherited (Control)", OS::get_singleton()->get_ticks_usec() - from);
+
+	// Per-write cost of the paths used by AnimationPlayer and Tween.
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		obj->set(prop, value);
+	}
+	_print_benchmark("Object::set", OS::get_singleton()->get_ticks_usec() - from);
+
+	Vector<StringName> path;
+	path.push_back(prop);
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		obj->set_indexed(path, value);
+	}
+	_print_benchmark("Object::set_indexed", OS::get_singleton()->get_ticks_usec() - from);
+
+	Object::PropertyHandle handle = obj->get_property_handle(path);
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		obj->set_by_handle(handle, value);
+	}
+	_print_benchmark("Object::set_by_handle", OS::get_singleton()->get_ticks_usec() - from);
+
+	path.push_back("x");
+	Object::PropertyHandle sub_handle = obj->get_property_handle(path);
+	Variant sub_value = 3.0;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		obj->set_indexed(path, sub_value);
+	}
+	_print_benchmark("Object::set_indexed, sub-property", OS::get_singleton()->get_ticks_usec() - from);
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int j = 0; j < BENCHMARK_LOOPS; j++) {
+		obj->set_by_handle(sub_handle, sub_value);
+	}
+	_print_benchmark("Object::set_by_handle, sub-property", OS::get_singleton()->get_ticks_usec() - from);
+
+	memdelete(obj);
+}
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	_run_benchmarks();
+
+	return NULL;
+}
+} // namespace TestClassDB
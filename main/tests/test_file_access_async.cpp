@@ -0,0 +1,119 @@
+/*************************************************************************/
+/*  test_file_access_async.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_file_access_async.h"
+
+#include "core/io/marshalls.h"
+#include "core/math/math_funcs.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+
+namespace TestFileAccessAsync {
+
+static const int FILE_SIZE = 64 * 1024 * 1024;
+static const int READ_SIZE = 4096;
+static const int READ_COUNT = 16384;
+
+MainLoop *test() {
+
+	String path = OS::get_singleton()->get_user_data_dir().plus_file("test_file_access_async.bin");
+
+	OS::get_singleton()->print("Writing a %d MiB file...\n", FILE_SIZE / (1024 * 1024));
+	FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+	if (!f) {
+		OS::get_singleton()->print("Failed writing the test file.\n");
+		return NULL;
+	}
+	Vector<uint8_t> chunk;
+	chunk.resize(READ_SIZE);
+	for (int i = 0; i < FILE_SIZE / READ_SIZE; i++) {
+		for (int j = 0; j < READ_SIZE; j += 4) {
+			encode_uint32(i, &chunk.write[j]); // every chunk holds its own index
+		}
+		f->store_buffer(chunk.ptr(), READ_SIZE);
+	}
+	f->close();
+	memdelete(f);
+
+	Vector<uint32_t> chunks;
+	chunks.resize(READ_COUNT);
+	for (int i = 0; i < READ_COUNT; i++) {
+		chunks.write[i] = Math::rand() % (FILE_SIZE / READ_SIZE);
+	}
+
+	Vector<uint8_t> dst;
+	dst.resize(READ_COUNT * READ_SIZE);
+
+	// Blocking reads, one after the other.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	f = FileAccess::open(path, FileAccess::READ);
+	for (int i = 0; i < READ_COUNT; i++) {
+		f->seek(uint64_t(chunks[i]) * READ_SIZE);
+		f->get_buffer(&dst.write[i * READ_SIZE], READ_SIZE);
+	}
+	memdelete(f);
+	uint64_t sync_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	zeromem(dst.ptrw(), dst.size());
+
+	// The same reads, all queued first.
+	begin = OS::get_singleton()->get_ticks_usec();
+	Vector<int> requests;
+	requests.resize(READ_COUNT);
+	for (int i = 0; i < READ_COUNT; i++) {
+		requests.write[i] = FileAccess::read_async(path, uint64_t(chunks[i]) * READ_SIZE, &dst.write[i * READ_SIZE], READ_SIZE);
+	}
+	int failed = 0;
+	for (int i = 0; i < READ_COUNT; i++) {
+		Error err;
+		if (FileAccess::wait_async_read(requests[i], &err) != READ_SIZE || err != OK) {
+			failed++;
+		}
+	}
+	uint64_t async_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int mismatches = 0;
+	for (int i = 0; i < READ_COUNT; i++) {
+		if (decode_uint32(&dst[i * READ_SIZE]) != chunks[i]) {
+			mismatches++;
+		}
+	}
+
+	float mib = READ_COUNT * float(READ_SIZE) / (1024 * 1024);
+	OS::get_singleton()->print("%d reads of %d bytes\n", READ_COUNT, READ_SIZE);
+	OS::get_singleton()->print("Blocking: %.3f msec (%.1f MiB/s)\n", sync_usec / 1000.0, mib / (sync_usec / 1000000.0));
+	OS::get_singleton()->print("Asynchronous: %.3f msec (%.1f MiB/s), %d failed, %d mismatching\n", async_usec / 1000.0, mib / (async_usec / 1000000.0), failed, mismatches);
+
+	DirAccess::remove_file_or_error(path);
+
+	return NULL;
+}
+} // namespace TestFileAccessAsync
@@ -39,6 +39,7 @@
 #include "modules/gdscript/gdscript.h"
 #include "modules/gdscript/gdscript_compiler.h"
 #include "modules/gdscript/gdscript_parser.h"
+#include "modules/gdscript/gdscript_serializer.h"
 #include "modules/gdscript/gdscript_tokenizer.h"
 
 namespace TestGDScript {
@@ -564,10 +565,17 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 			switch (code[ip]) {
 
-				case GDScriptFunction::OPCODE_OPERATOR: {
+				case GDScriptFunction::OPCODE_OPERATOR:
+				case GDScriptFunction::OPCODE_OPERATOR_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_REAL:
+				case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+				case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
 
+					static const char *suffixes[] = { "", "-int", "-float", "-vec2", "-vec3" };
 					int op = code[ip + 1];
-					txt += " op ";
+					txt += " op";
+					txt += suffixes[code[ip] - GDScriptFunction::OPCODE_OPERATOR];
+					txt += " ";
 
 					String opname = Variant::get_operator_name(Variant::Operator(op));
 
@@ -609,20 +617,20 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += "[\"";
 					txt += func.get_global_name(code[ip + 2]);
 					txt += "\"]=";
-					txt += DADDR(3);
-					incr += 4;
+					txt += DADDR(4);
+					incr += 5;
 
 				} break;
 				case GDScriptFunction::OPCODE_GET_NAMED: {
 
 					txt += " get_named ";
-					txt += DADDR(3);
+					txt += DADDR(4);
 					txt += "=";
 					txt += DADDR(1);
 					txt += "[\"";
 					txt += func.get_global_name(code[ip + 2]);
 					txt += "\"]";
-					incr += 4;
+					incr += 5;
 
 				} break;
 				case GDScriptFunction::OPCODE_SET_MEMBER: {
@@ -754,21 +762,51 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					int argc = code[ip + 1];
 					if (ret) {
-						txt += DADDR(4 + argc) + "=";
+						txt += DADDR(5 + argc) + "=";
+					}
+
+					txt += DADDR(2) + ".";
+					txt += String(func.get_global_name(code[ip + 3]));
+					txt += "(";
+
+					for (int i = 0; i < argc; i++) {
+						if (i > 0)
+							txt += ", ";
+						txt += DADDR(5 + i);
+					}
+					txt += ")";
+
+					incr = 6 + argc;
+
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET: {
+
+					bool ret = code[ip] == GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET;
+
+					if (ret)
+						txt += " call-bind-ret ";
+					else
+						txt += " call-bind ";
+
+					int argc = code[ip + 1];
+					if (ret) {
+						txt += DADDR(5 + argc) + "=";
 					}
 
 					txt += DADDR(2) + ".";
+					txt += String(func.get_method_bind(code[ip + 4]).class_name) + "::";
 					txt += String(func.get_global_name(code[ip + 3]));
 					txt += "(";
 
 					for (int i = 0; i < argc; i++) {
 						if (i > 0)
 							txt += ", ";
-						txt += DADDR(4 + i);
+						txt += DADDR(5 + i);
 					}
 					txt += ")";
 
-					incr = 5 + argc;
+					incr = 6 + argc;
 
 				} break;
 				case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
@@ -857,6 +895,18 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					incr = 3;
 				} break;
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL: {
+
+					txt += code[ip] == GDScriptFunction::OPCODE_JUMP_IF_NOT_INT ? " jump-if-not-int " : " jump-if-not-float ";
+					txt += DADDR(2);
+					txt += " " + Variant::get_operator_name(Variant::Operator(code[ip + 1])) + " ";
+					txt += DADDR(3);
+					txt += " to ";
+					txt += itos(code[ip + 4]);
+
+					incr = 5;
+				} break;
 				case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
 
 					txt += " jump-to-default-argument ";
@@ -917,8 +967,382 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 	}
 }
 
+struct BenchmarkScript {
+
+	const char *name;
+	const char *code;
+};
+
+// Every static function starting with "bench_" is timed. Keep loops long enough to dwarf call overhead.
+static const BenchmarkScript benchmark_scripts[] = {
+	{ "native_calls",
+			"extends Reference\n"
+			"const LOOPS = 1000000\n"
+			"static func bench_native_call_untyped():\n"
+			"\tvar node = Node2D.new()\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tnode.set_rotation(node.get_rotation() + 0.001)\n"
+			"\tnode.free()\n"
+			"static func bench_native_call_typed():\n"
+			"\tvar node: Node2D = Node2D.new()\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tnode.set_rotation(node.get_rotation() + 0.001)\n"
+			"\tnode.free()\n"
+			"static func bench_native_call_typed_subclass():\n"
+			"\tvar node: Node2D = Sprite.new()\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tnode.set_rotation(node.get_rotation() + 0.001)\n"
+			"\tnode.free()\n" },
+	{ "typed_arithmetic",
+			"extends Reference\n"
+			"const LOOPS = 1000000\n"
+			"static func bench_int_untyped():\n"
+			"\tvar total = 0\n"
+			"\tvar i = 0\n"
+			"\twhile i < LOOPS:\n"
+			"\t\ttotal = (total + i * 3) % 65536\n"
+			"\t\ti += 1\n"
+			"\treturn total\n"
+			"static func bench_int_typed():\n"
+			"\tvar total: int = 0\n"
+			"\tvar i: int = 0\n"
+			"\twhile i < LOOPS:\n"
+			"\t\ttotal = (total + i * 3) % 65536\n"
+			"\t\ti += 1\n"
+			"\treturn total\n"
+			"static func bench_float_untyped():\n"
+			"\tvar x = 0.0\n"
+			"\tvar v = 1.0\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tv = v * 0.999 + 0.5\n"
+			"\t\tif v > x:\n"
+			"\t\t\tx = v\n"
+			"\treturn x\n"
+			"static func bench_float_typed():\n"
+			"\tvar x: float = 0.0\n"
+			"\tvar v: float = 1.0\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tv = v * 0.999 + 0.5\n"
+			"\t\tif v > x:\n"
+			"\t\t\tx = v\n"
+			"\treturn x\n"
+			"static func bench_vector2_untyped():\n"
+			"\tvar p = Vector2()\n"
+			"\tvar vel = Vector2(1, 2)\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tp = p + vel * 0.016\n"
+			"\treturn p\n"
+			"static func bench_vector2_typed():\n"
+			"\tvar p: Vector2 = Vector2()\n"
+			"\tvar vel: Vector2 = Vector2(1, 2)\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tp = p + vel * 0.016\n"
+			"\treturn p\n"
+			"static func bench_vector3_untyped():\n"
+			"\tvar p = Vector3()\n"
+			"\tvar vel = Vector3(1, 2, 3)\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tp = p + vel * 0.016\n"
+			"\treturn p\n"
+			"static func bench_vector3_typed():\n"
+			"\tvar p: Vector3 = Vector3()\n"
+			"\tvar vel: Vector3 = Vector3(1, 2, 3)\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tp = p + vel * 0.016\n"
+			"\treturn p\n" },
+	{ "method_calls",
+			"extends Reference\n"
+			"const LOOPS = 1000000\n"
+			"class Base:\n"
+			"\tvar count = 0\n"
+			"\tfunc step(x):\n"
+			"\t\tcount += x\n"
+			"class Derived extends Base:\n"
+			"\tfunc other():\n"
+			"\t\tpass\n"
+			"static func bench_script_call():\n"
+			"\tvar obj = Base.new()\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tobj.step(1)\n"
+			"\treturn obj.count\n"
+			"static func bench_script_call_inherited():\n"
+			"\tvar obj = Derived.new()\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tobj.step(1)\n"
+			"\treturn obj.count\n"
+			"static func bench_script_call_polymorphic():\n"
+			"\tvar objs = [Base.new(), Derived.new()]\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tobjs[i % 2].step(1)\n"
+			"\treturn objs[0].count + objs[1].count\n"
+			"static func bench_native_call_on_script_object():\n"
+			"\tvar obj = Base.new()\n"
+			"\tfor i in range(LOOPS):\n"
+			"\t\tobj.get_instance_id()\n"
+			"\treturn obj.count\n" },
+	{ "yield_resume",
+			"extends Reference\n"
+			"const AGENTS = 10000\n"
+			"const STEPS = 20\n"
+			"static func agent(steps):\n"
+			"\tvar total = 0\n"
+			"\tvar pos = Vector2()\n"
+			"\tvar name = \"agent\"\n"
+			"\tvar path = [pos]\n"
+			"\tfor i in range(steps):\n"
+			"\t\tyield()\n"
+			"\t\ttotal += i\n"
+			"\t\tpos += Vector2(1, 0)\n"
+			"\treturn total\n"
+			"static func bench_yield_resume():\n"
+			"\tvar states = []\n"
+			"\tfor i in range(AGENTS):\n"
+			"\t\tstates.push_back(agent(STEPS))\n"
+			"\tfor step in range(STEPS):\n"
+			"\t\tfor i in range(AGENTS):\n"
+			"\t\t\tstates[i] = states[i].resume()\n"
+			"\treturn states[0]\n" },
+	{ "parallel_for",
+			"extends Reference\n"
+			"const SIZE = 1000000\n"
+			"class Worker:\n"
+			"\tstatic func sum_squares(chunk):\n"
+			"\t\tvar total = 0\n"
+			"\t\tfor x in chunk:\n"
+			"\t\t\ttotal = (total + x * x) % 65536\n"
+			"\t\treturn total\n"
+			"static func bench_serial():\n"
+			"\treturn Worker.sum_squares(range(SIZE))\n"
+			"static func bench_parallel():\n"
+			"\treturn parallel_for(Worker, \"sum_squares\", range(SIZE))\n" },
+	{ NULL, NULL }
+};
+
+// A synthetic script mixing the constructs most scripts are made of, for the tokenizer and parser.
+static String _make_parser_benchmark_script(int p_lines) {
+
+	String code = "extends Node\n\n";
+	int lines = 2;
+	for (int i = 0; lines < p_lines; i++) {
+		String n = itos(i);
+		code += "# Method number " + n + ", with a comment to skip.\n";
+		code += "export var value_" + n + " = " + itos(i * 7) + "\n";
+		code += "func method_" + n + "(a, b = 0.5, c := \"default\\n\"):\n";
+		code += "\tvar total = a * 0x1F + b / 2.0e3\n";
+		code += "\tfor j in range(10):\n";
+		code += "\t\tif j % 2 == 0 and total > 1_000:\n";
+		code += "\t\t\ttotal -= sqrt(j) + abs(b)\n";
+		code += "\t\telse:\n";
+		code += "\t\t\tprint(\"value: %s\" % [total], 'single', value_" + n + ")\n";
+		code += "\treturn Vector2(total, c.length())\n\n";
+		lines += 11;
+	}
+	return code;
+}
+
+// Tokens of the text tokenizer, one word each, with the value of identifiers and constants.
+static String _dump_tokens(const String &p_code) {
+
+	GDScriptTokenizerText tk;
+	tk.set_code(p_code);
+
+	String dump;
+	for (int i = 0; i < 1000; i++) {
+
+		GDScriptTokenizer::Token token = tk.get_token();
+		if (dump != String()) {
+			dump += " ";
+		}
+
+		switch (token) {
+			case GDScriptTokenizer::TK_IDENTIFIER: {
+				dump += "id(" + String(tk.get_token_identifier()) + ")";
+			} break;
+			case GDScriptTokenizer::TK_CONSTANT: {
+				const Variant &constant = tk.get_token_constant();
+				String value = constant;
+				dump += Variant::get_type_name(constant.get_type()) + "(" + (constant.get_type() == Variant::STRING ? value.c_escape() : value) + ")";
+			} break;
+			case GDScriptTokenizer::TK_BUILT_IN_FUNC: {
+				dump += "func(" + String(GDScriptFunctions::get_func_name(tk.get_token_built_in_func())) + ")";
+			} break;
+			case GDScriptTokenizer::TK_BUILT_IN_TYPE: {
+				dump += "type(" + Variant::get_type_name(tk.get_token_type()) + ")";
+			} break;
+			case GDScriptTokenizer::TK_NEWLINE: {
+				dump += "newline";
+			} break;
+			case GDScriptTokenizer::TK_ERROR: {
+				return dump + "error(" + tk.get_token_error() + ")";
+			}
+			case GDScriptTokenizer::TK_EOF: {
+				return dump + "EOF";
+			}
+			default: {
+				dump += String(GDScriptTokenizer::get_token_name(token)).trim_prefix("'").trim_suffix("'");
+			} break;
+		}
+
+		tk.advance();
+	}
+
+	return dump + "...";
+}
+
+static const struct {
+	const char *code;
+	const char *tokens;
+} tokenizer_checks[] = {
+	// Escapes, quotes and node paths.
+	{ "x = \"a\\tb\\\"c\\u00e9\\\\\" + 'it\\'s' + \"\"\"l1\nl2\"\"\" + @\"a/b\"",
+			"id(x) = String(a\\tb\\\"c\xc3\xa9\\\\) + String(it\\'s) + String(l1\\nl2) + NodePath(a/b) EOF" },
+	// Hexadecimal, binary, separators and reals.
+	{ "a = 0x1F + 0xff_ff + 0b1010 + 1_000 + 1.5 + 1e3 + .25",
+			"id(a) = int(31) + int(65535) + int(10) + int(1000) + float(1.5) + float(1000) + float(0.25) EOF" },
+	// Words that begin (or end) like reserved words are identifiers.
+	{ "var var_x = iffy if in_range else printer",
+			"var id(var_x) = id(iffy) if id(in_range) else id(printer) EOF" },
+	{ "print(int8, int, nullable, null, true_ish, true, i, in)",
+			"func(print) ( id(int8) , type(int) , id(nullable) , Nil(Null) , id(true_ish) , bool(True) , id(i) , In ) EOF" },
+	// Comments, including ones that look like warning directives and one ending the code.
+	{ "a = 1 # warning? no\n# only a comment\nc = \"# not a comment\"\nb = 2 # the end",
+			"id(a) = int(1) newline newline id(c) = String(# not a comment) newline id(b) = int(2) EOF" },
+	{ NULL, NULL }
+};
+
+static bool _check_tokenizer() {
+
+	bool ok = true;
+	for (int i = 0; tokenizer_checks[i].code; i++) {
+
+		String tokens = _dump_tokens(String::utf8(tokenizer_checks[i].code));
+		String expected = String::utf8(tokenizer_checks[i].tokens);
+		if (tokens != expected) {
+			print_line("\tTokenizer check " + itos(i) + " failed.\n\t\texpected: " + expected + "\n\t\tgot:      " + tokens);
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+static void _run_parser_benchmarks() {
+
+	if (!_check_tokenizer()) {
+		OS::get_singleton()->set_exit_code(1);
+		return;
+	}
+
+	const int sizes[] = { 1000, 10000, 0 };
+
+	for (int i = 0; sizes[i]; i++) {
+
+		print_line("** parse " + itos(sizes[i]) + " lines **");
+
+		String code = _make_parser_benchmark_script(sizes[i]);
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		GDScriptTokenizerText tk;
+		tk.set_code(code);
+		int tokens = 0;
+		while (tk.get_token() != GDScriptTokenizer::TK_EOF && tk.get_token() != GDScriptTokenizer::TK_ERROR) {
+			tk.advance();
+			tokens++;
+		}
+		uint64_t tokenize_time = OS::get_singleton()->get_ticks_usec() - from;
+
+		if (tk.get_token() == GDScriptTokenizer::TK_ERROR) {
+			print_line("\tTokenizer error: " + tk.get_token_error());
+			continue;
+		}
+
+		from = OS::get_singleton()->get_ticks_usec();
+		GDScriptParser parser;
+		Error err = parser.parse(code, "", false, "res://parse_benchmark.gd");
+		uint64_t parse_time = OS::get_singleton()->get_ticks_usec() - from;
+
+		if (err) {
+			print_line("\tParse error at line " + itos(parser.get_error_line()) + ": " + parser.get_error());
+			continue;
+		}
+
+		print_line("\ttokenize: " + rtos(tokenize_time / 1000.0) + " msec (" + itos(tokens) + " tokens), parse: " + rtos(parse_time / 1000.0) + " msec");
+	}
+}
+
+static void _run_benchmarks() {
+
+	_run_parser_benchmarks();
+
+	for (int i = 0; benchmark_scripts[i].name; i++) {
+
+		print_line("** " + String(benchmark_scripts[i].name) + " **");
+
+		String code = String::utf8(benchmark_scripts[i].code);
+
+		Ref<GDScript> gds;
+		gds.instance();
+		gds->set_source_code(code);
+		uint64_t compile_from = OS::get_singleton()->get_ticks_usec();
+		Error err = gds->reload();
+		uint64_t compile_time = OS::get_singleton()->get_ticks_usec() - compile_from;
+		if (err) {
+			print_line("\tFailed to compile benchmark script.");
+			continue;
+		}
+
+		// Startup cost of the same script when exported precompiled.
+		String path = "res://" + String(benchmark_scripts[i].name) + ".gd";
+		String error;
+		Vector<uint8_t> compiled = GDScriptSerializer::compile_and_save(path, code, &error);
+		if (compiled.empty()) {
+			print_line("\tFailed to precompile benchmark script: " + error);
+		} else {
+			GDScript *loaded = memnew(GDScript);
+			Ref<GDScript> loadedres(loaded);
+			loaded->set_script_path(path);
+
+			uint64_t load_from = OS::get_singleton()->get_ticks_usec();
+			err = GDScriptSerializer::load(compiled, loaded, &error);
+			uint64_t load_time = OS::get_singleton()->get_ticks_usec() - load_from;
+
+			if (err) {
+				print_line("\tFailed to load precompiled benchmark script: " + error);
+			} else {
+				print_line("\tcompile: " + rtos(compile_time / 1000.0) + " msec, load precompiled: " + rtos(load_time / 1000.0) + " msec (" + itos(compiled.size()) + " bytes)");
+			}
+		}
+
+		List<MethodInfo> methods;
+		gds->get_script_method_list(&methods);
+		methods.sort();
+
+		for (List<MethodInfo>::Element *E = methods.front(); E; E = E->next()) {
+
+			if (!E->get().name.begins_with("bench_"))
+				continue;
+
+			Variant::CallError ce;
+			uint64_t from = OS::get_singleton()->get_ticks_usec();
+			static_cast<Object *>(gds.ptr())->call(E->get().name, NULL, 0, ce);
+			uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - from;
+
+			if (ce.error != Variant::CallError::CALL_OK) {
+				print_line("\t" + E->get().name + ": call failed");
+			} else {
+				print_line("\t" + E->get().name + ": " + rtos(elapsed / 1000.0) + " msec");
+			}
+		}
+	}
+}
+
 MainLoop *test(TestType p_type) {
 
+	if (p_type == TEST_BENCHMARK) {
+
+		_run_benchmarks();
+		return NULL;
+	}
+
 	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
 	if (cmdlargs.empty()) {
@@ -1047,6 +1471,9 @@ MainLoop *test(TestType p_type) {
 			current = current->get_base();
 		}
 
+		print_line("** OPTIMIZER **");
+		print_line(gdc.get_optimizer_stats().to_string());
+
 	} else if (p_type == TEST_BYTECODE) {
 
 		Vector<uint8_t> buf2 = GDScriptTokenizerBuffer::parse_code_string(code);
@@ -34,16 +34,22 @@
 #ifdef DEBUG_ENABLED
 
 #include "test_astar.h"
+#include "test_class_db.h"
+#include "test_file_access_async.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_math.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
+#include "test_packed_data.h"
+#include "test_pck_compression.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
 #include "test_render.h"
+#include "test_resource_loader.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
+#include "test_text_resource.h"
 
 const char **tests_get_names() {
 
@@ -60,8 +66,15 @@ const char **tests_get_names() {
 		"gd_parser",
 		"gd_compiler",
 		"gd_bytecode",
+		"gd_benchmark",
 		"ordered_hash_map",
 		"astar",
+		"class_db",
+		"resource_loader",
+		"packed_data",
+		"pck_compression",
+		"file_access_async",
+		"text_resource",
 		NULL
 	};
 
@@ -132,6 +145,11 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestGDScript::test(TestGDScript::TEST_BYTECODE);
 	}
 
+	if (p_test == "gd_benchmark") {
+
+		return TestGDScript::test(TestGDScript::TEST_BENCHMARK);
+	}
+
 	if (p_test == "ordered_hash_map") {
 
 		return TestOrderedHashMap::test();
@@ -142,6 +160,36 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "class_db") {
+
+		return TestClassDB::test();
+	}
+
+	if (p_test == "resource_loader") {
+
+		return TestResourceLoader::test();
+	}
+
+	if (p_test == "packed_data") {
+
+		return TestPackedData::test();
+	}
+
+	if (p_test == "pck_compression") {
+
+		return TestPCKCompression::test();
+	}
+
+	if (p_test == "file_access_async") {
+
+		return TestFileAccessAsync::test();
+	}
+
+	if (p_test == "text_resource") {
+
+		return TestTextResource::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
@@ -32,7 +32,9 @@
 
 #include "core/math/basis.h"
 #include "core/math/camera_matrix.h"
+#include "core/math/math_batch.h"
 #include "core/math/math_funcs.h"
+#include "core/math/random_pcg.h"
 #include "core/math/transform.h"
 #include "core/os/file_access.h"
 #include "core/os/keyboard.h"
@@ -402,8 +404,171 @@ uint32_t ihash3(uint32_t a) {
 	return a;
 }
 
+// Checks MathBatch against the per-element Transform/AABB code and times both.
+void test_batch() {
+
+	const int count = 100000;
+	const int passes = 20;
+
+	RandomPCG rng(12345);
+
+	Transform xform(Basis(Vector3(0.3, 1.0, -0.2).normalized(), 0.7).scaled(Vector3(1.5, 0.5, 2.0)), Vector3(10, -4, 3));
+
+	Vector<Vector3> points;
+	Vector<AABB> aabbs;
+	Vector<float> rows;
+	points.resize(count);
+	aabbs.resize(count);
+	rows.resize(count * 12);
+	for (int i = 0; i < count; i++) {
+		points.write[i] = Vector3(rng.random(-100, 100), rng.random(-100, 100), rng.random(-100, 100));
+		aabbs.write[i] = AABB(points[i], Vector3(rng.random(0, 5), rng.random(0, 5), rng.random(0, 5)));
+		Transform t(Basis(Vector3(0, 1, 0), rng.random(0.0, Math_TAU)), points[i]);
+		MathBatch::xform_to_rows(Transform(), t, &rows.write[i * 12]);
+	}
+
+	CameraMatrix cm;
+	cm.set_perspective(70, 1.6, 0.1, 100);
+	Vector<Plane> planes = cm.get_projection_planes(Transform().looking_at(Vector3(1, 0, 0), Vector3(0, 1, 0)));
+
+	Vector<Vector3> out_points;
+	Vector<AABB> out_aabbs;
+	Vector<int> indices;
+	out_points.resize(count);
+	out_aabbs.resize(count);
+	indices.resize(count);
+
+	// Correctness.
+
+	int errors = 0;
+
+	MathBatch::xform_points(xform, points.ptr(), out_points.ptrw(), count);
+	for (int i = 0; i < count; i++) {
+		if (out_points[i] != xform.xform(points[i]))
+			errors++;
+	}
+
+	MathBatch::xform_vectors(xform.basis, points.ptr(), out_points.ptrw(), count);
+	for (int i = 0; i < count; i++) {
+		if (out_points[i] != xform.basis.xform(points[i]))
+			errors++;
+	}
+
+	MathBatch::xform_aabbs(xform, aabbs.ptr(), out_aabbs.ptrw(), count);
+	for (int i = 0; i < count; i++) {
+		AABB expected = xform.xform(aabbs[i]);
+		if (out_aabbs[i].position != expected.position || out_aabbs[i].size != expected.size)
+			errors++;
+	}
+
+	int visible = MathBatch::cull_aabbs_convex(planes.ptr(), planes.size(), aabbs.ptr(), count, indices.ptrw());
+	int expected_visible = 0;
+	for (int i = 0; i < count; i++) {
+		if (aabbs[i].intersects_convex_shape(planes.ptr(), planes.size())) {
+			if (expected_visible >= visible || indices[expected_visible] != i)
+				errors++;
+			expected_visible++;
+		}
+	}
+	if (expected_visible != visible)
+		errors++;
+
+	AABB merged = MathBatch::xform_aabb_merged(aabbs[0], rows.ptr(), 12, count);
+	AABB expected_merged;
+	for (int i = 0; i < count; i++) {
+		const float *r = &rows[i * 12];
+		Transform t(r[0], r[1], r[2], r[4], r[5], r[6], r[8], r[9], r[10], r[3], r[7], r[11]);
+		if (i == 0)
+			expected_merged = t.xform(aabbs[0]);
+		else
+			expected_merged.merge_with(t.xform(aabbs[0]));
+	}
+	if (!merged.position.is_equal_approx(expected_merged.position) || !merged.size.is_equal_approx(expected_merged.size))
+		errors++;
+
+	print_line("MathBatch (" + String(MathBatch::get_backend_name()) + "): " + itos(errors) + " mismatches, " + itos(visible) + "/" + itos(count) + " AABBs visible");
+
+	// Timing, per element.
+
+#define BATCH_BENCHMARK(m_name, m_code)                                                                        \
+	{                                                                                                          \
+		uint64_t from = OS::get_singleton()->get_ticks_usec();                                                 \
+		for (int pass = 0; pass < passes; pass++) {                                                            \
+			m_code;                                                                                            \
+		}                                                                                                      \
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - from;                                       \
+		print_line(String(m_name) + ": " + rtos(double(elapsed) * 1000.0 / (double(count) * passes)) + " ns"); \
+	}
+
+	Vector3 *pw = out_points.ptrw();
+	AABB *aw = out_aabbs.ptrw();
+
+	BATCH_BENCHMARK("xform points, per element", for (int i = 0; i < count; i++) pw[i] = xform.xform(points[i]));
+	BATCH_BENCHMARK("xform points, batch", MathBatch::xform_points(xform, points.ptr(), pw, count));
+	BATCH_BENCHMARK("xform AABBs, per element", for (int i = 0; i < count; i++) aw[i] = xform.xform(aabbs[i]));
+	BATCH_BENCHMARK("xform AABBs, batch", MathBatch::xform_aabbs(xform, aabbs.ptr(), aw, count));
+	BATCH_BENCHMARK("frustum cull, per element", int v = 0; for (int i = 0; i < count; i++) if (aabbs[i].intersects_convex_shape(planes.ptr(), planes.size())) indices.write[v++] = i);
+	BATCH_BENCHMARK("frustum cull, batch", MathBatch::cull_aabbs_convex(planes.ptr(), planes.size(), aabbs.ptr(), count, indices.ptrw()));
+	BATCH_BENCHMARK("multimesh AABB, batch", MathBatch::xform_aabb_merged(aabbs[0], rows.ptr(), 12, count));
+
+#undef BATCH_BENCHMARK
+}
+
+void test_large_world() {
+
+	// Positions far away from the origin must keep millimeter precision with float=64 builds,
+	// both in real_t math and once narrowed to float relative to the camera for the GPU.
+
+	const real_t distances[] = { 1000, 100000, 1000000, 10000000 };
+	const real_t tolerance = 0.0001;
+
+#ifdef REAL_T_IS_DOUBLE
+	print_line("Large world precision (real_t is double):");
+#else
+	print_line("Large world precision (real_t is float, failures above 1 km are expected):");
+#endif
+
+	for (int i = 0; i < 4; i++) {
+
+		real_t d = distances[i];
+		Vector3 origin(d, d * 0.5, -d);
+		Vector3 step(0.001, 0.001, 0.001);
+
+		// Millimeter steps survive at this distance.
+		real_t step_error = ((origin + step) - origin - step).length();
+
+		// Round trip through a rotated, scaled transform placed far away.
+		Transform xform(Basis(Vector3(0.2, 1.0, 0.4).normalized(), 1.3).scaled(Vector3(2, 2, 2)), origin);
+		Vector3 local(1.234, -5.678, 9.1011);
+		real_t xform_error = (xform.xform_inv(xform.xform(local)) - local).length();
+
+		// Object one meter in front of a camera, both far away: what the GPU receives after
+		// subtracting the render origin, versus narrowing world positions directly.
+		Vector3 camera_pos = origin;
+		Vector3 object_pos = origin + Vector3(0.1234, 0.5678, -1.0);
+		Vector3 expected = object_pos - camera_pos;
+		Vector3 relative = object_pos - camera_pos;
+		Vector3 relative_gpu((float)relative.x, (float)relative.y, (float)relative.z);
+		Vector3 direct_gpu((float)object_pos.x - (float)camera_pos.x, (float)object_pos.y - (float)camera_pos.y, (float)object_pos.z - (float)camera_pos.z);
+		real_t relative_error = (relative_gpu - expected).length();
+		real_t direct_error = (direct_gpu - expected).length();
+
+		// Boxes one millimeter apart must not touch.
+		AABB a(origin, Vector3(1, 1, 1));
+		AABB b(origin + Vector3(1.001, 0, 0), Vector3(1, 1, 1));
+		bool separated = !a.intersects(b);
+
+		bool ok = step_error < tolerance && xform_error < tolerance && relative_error < tolerance && separated;
+
+		print_line("\t" + rtos(d / 1000) + " km: step error " + rtos(step_error) + ", xform error " + rtos(xform_error) + ", gpu error " + rtos(relative_error) + " (camera-relative) / " + rtos(direct_error) + " (world), AABBs separated: " + (separated ? "yes" : "no") + (ok ? " - OK" : " - FAILED"));
+	}
+}
+
 MainLoop *test() {
 
+	test_batch();
+	test_large_world();
+
 	{
 		float r = 1;
 		float g = 0.5;
@@ -560,7 +725,7 @@ MainLoop *test() {
 	{
 		Vector3 v(1, 2, 3);
 		v.normalize();
-		float a = 0.3;
+		real_t a = 0.3;
 
 		Basis m(v, a);
 
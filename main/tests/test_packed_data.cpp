@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  test_packed_data.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_packed_data.h"
+
+#include "core/io/file_access_pack.h"
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+#include "core/version.h"
+
+namespace TestPackedData {
+
+static const int FILE_COUNT = 300000;
+static const int FILES_PER_DIR = 100;
+
+static String _file_path(int p_index) {
+
+	return "res://test_packed_data/dir_" + itos(p_index / FILES_PER_DIR) + "/file_" + itos(p_index) + ".res";
+}
+
+// Writes a pack in the format the exporter uses, every file holding one byte.
+static bool _write_pack(const String &p_pack_path) {
+
+	FileAccess *f = FileAccess::open(p_pack_path, FileAccess::WRITE);
+	if (!f) {
+		return false;
+	}
+
+	f->store_32(0x43504447); //GDPC
+	f->store_32(1); //pack version
+	f->store_32(VERSION_MAJOR);
+	f->store_32(VERSION_MINOR);
+	f->store_32(0);
+	for (int i = 0; i < 16; i++) {
+		f->store_32(0); //reserved
+	}
+	f->store_32(FILE_COUNT);
+
+	Vector<CharString> paths;
+	paths.resize(FILE_COUNT);
+	uint64_t data_ofs = f->get_position();
+	for (int i = 0; i < FILE_COUNT; i++) {
+		paths.write[i] = _file_path(i).utf8();
+		int len = paths[i].length();
+		data_ofs += 4 + len + (4 - len % 4) % 4 + 8 + 8 + 16;
+	}
+
+	uint8_t md5[16] = {};
+	for (int i = 0; i < FILE_COUNT; i++) {
+		int len = paths[i].length();
+		int pad = (4 - len % 4) % 4;
+		f->store_32(len + pad);
+		f->store_buffer((const uint8_t *)paths[i].get_data(), len);
+		for (int j = 0; j < pad; j++) {
+			f->store_8(0);
+		}
+		f->store_64(data_ofs + i);
+		f->store_64(1);
+		f->store_buffer(md5, 16);
+	}
+
+	for (int i = 0; i < FILE_COUNT; i++) {
+		f->store_8(i & 0xFF);
+	}
+
+	f->close();
+	memdelete(f);
+	return true;
+}
+
+MainLoop *test() {
+
+	String pack_path = OS::get_singleton()->get_user_data_dir().plus_file("test_packed_data.pck");
+
+	OS::get_singleton()->print("Writing a pack of %d files...\n", FILE_COUNT);
+	if (!_write_pack(pack_path)) {
+		OS::get_singleton()->print("Failed writing the test pack.\n");
+		return NULL;
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Error err = PackedData::get_singleton()->add_pack(pack_path, false);
+	uint64_t add_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	if (err != OK) {
+		OS::get_singleton()->print("Failed adding the test pack.\n");
+		DirAccess::remove_file_or_error(pack_path);
+		return NULL;
+	}
+
+	Vector<String> paths;
+	paths.resize(FILE_COUNT);
+	for (int i = 0; i < FILE_COUNT; i++) {
+		paths.write[i] = _file_path(i);
+	}
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int found = 0;
+	for (int i = 0; i < FILE_COUNT; i++) {
+		if (PackedData::get_singleton()->has_path(paths[i])) {
+			found++;
+		}
+	}
+	uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int matching = 0;
+	for (int i = 0; i < FILE_COUNT; i++) {
+		FileAccess *f = PackedData::get_singleton()->try_open_path(paths[i]);
+		if (f) {
+			if (f->get_8() == (i & 0xFF)) {
+				matching++;
+			}
+			memdelete(f);
+		}
+	}
+	uint64_t open_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("Adding the pack: %.3f msec\n", add_usec / 1000.0);
+	OS::get_singleton()->print("Looking up %d paths: %.3f msec (%d found)\n", FILE_COUNT, lookup_usec / 1000.0, found);
+	OS::get_singleton()->print("Opening and reading %d files: %.3f msec (%d matching)\n", FILE_COUNT, open_usec / 1000.0, matching);
+
+	DirAccess::remove_file_or_error(pack_path);
+
+	return NULL;
+}
+} // namespace TestPackedData
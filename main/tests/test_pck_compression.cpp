@@ -0,0 +1,238 @@
+/*************************************************************************/
+/*  test_pck_compression.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_pck_compression.h"
+
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/math/math_funcs.h"
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+
+namespace TestPCKCompression {
+
+static const int FILE_COUNT = 64;
+static const int FILE_SIZE = 1024 * 1024;
+
+static String _source_path(int p_index) {
+
+	return OS::get_singleton()->get_user_data_dir().plus_file("test_pck_compression_" + itos(p_index) + ".txt");
+}
+
+// Text resembling a resource file, which compresses about as well as real ones.
+static void _write_sources() {
+
+	for (int i = 0; i < FILE_COUNT; i++) {
+
+		FileAccess *f = FileAccess::open(_source_path(i), FileAccess::WRITE);
+		ERR_FAIL_COND(!f);
+		while (f->get_position() < (size_t)FILE_SIZE) {
+			f->store_string("tracks/" + itos(Math::rand() % 64) + "/keys = PoolRealArray( " + rtos(Math::randf()) + ", " + itos(Math::rand() % 1000) + " )\n");
+		}
+		f->close();
+		memdelete(f);
+	}
+}
+
+static uint64_t _write_pack(const String &p_pack_path, const String &p_prefix, bool p_compress) {
+
+	Ref<PCKPacker> packer;
+	packer.instance();
+	packer->pck_start(p_pack_path, 16);
+	for (int i = 0; i < FILE_COUNT; i++) {
+		packer->add_file(p_prefix + itos(i) + ".txt", _source_path(i), p_compress);
+	}
+	packer->flush();
+
+	FileAccess *f = FileAccess::open(p_pack_path, FileAccess::READ);
+	uint64_t size = f ? f->get_len() : 0;
+	if (f) {
+		memdelete(f);
+	}
+	return size;
+}
+
+// Reads every file whole, as loaders do, and returns the time taken.
+static uint64_t _read_all(const String &p_prefix, uint64_t *r_bytes) {
+
+	Vector<uint8_t> buffer;
+	buffer.resize(FILE_SIZE * 2);
+	*r_bytes = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < FILE_COUNT; i++) {
+		FileAccess *f = PackedData::get_singleton()->try_open_path(p_prefix + itos(i) + ".txt");
+		if (!f) {
+			continue;
+		}
+		int len = f->get_len();
+		buffer.resize(MAX(buffer.size(), len));
+		*r_bytes += f->get_buffer(buffer.ptrw(), len);
+		memdelete(f);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+static bool _compare(const Vector<uint8_t> &p_source, int p_from, const uint8_t *p_data, int p_len) {
+
+	return p_from + p_len <= p_source.size() && memcmp(p_source.ptr() + p_from, p_data, p_len) == 0;
+}
+
+// Checks every file against its source, read whole, across a compressed block boundary and
+// after seeking into the middle of the entry. Returns the amount of mismatching files.
+static int _verify(const String &p_prefix) {
+
+	int mismatches = 0;
+	Vector<uint8_t> buffer;
+
+	for (int i = 0; i < FILE_COUNT; i++) {
+
+		String path = p_prefix + itos(i) + ".txt";
+		Vector<uint8_t> source = FileAccess::get_file_as_array(_source_path(i));
+		FileAccess *f = PackedData::get_singleton()->try_open_path(path);
+		if (!f) {
+			OS::get_singleton()->print("Can't open %s.\n", path.utf8().get_data());
+			mismatches++;
+			continue;
+		}
+
+		bool match = (int)f->get_len() == source.size();
+
+		if (match) {
+			buffer.resize(source.size());
+			match = f->get_buffer(buffer.ptrw(), buffer.size()) == buffer.size() && _compare(source, 0, buffer.ptr(), buffer.size());
+		}
+
+		if (match) {
+			// Ends in the second block, so it needs both decompressed.
+			int from = PACK_COMPRESSED_BLOCK_SIZE - 100;
+			f->seek(from);
+			match = f->get_buffer(buffer.ptrw(), 300) == 300 && _compare(source, from, buffer.ptr(), 300);
+		}
+
+		if (match) {
+			// Lands in a block that was not read yet, at an odd offset.
+			int from = source.size() / 2 + 7;
+			f->seek(from);
+			match = f->get_8() == source[from] && f->get_position() == (size_t)from + 1;
+			match = match && f->get_buffer(buffer.ptrw(), 1000) == 1000 && _compare(source, from + 1, buffer.ptr(), 1000);
+		}
+
+		if (!match) {
+			OS::get_singleton()->print("Contents of %s don't match the source file.\n", path.utf8().get_data());
+			mismatches++;
+		}
+
+		memdelete(f);
+	}
+
+	return mismatches;
+}
+
+// Opens compressed files whose header is damaged in different ways. Returns the amount of them that opened anyway.
+static int _open_corrupt_headers() {
+
+	String path = OS::get_singleton()->get_user_data_dir().plus_file("test_pck_corrupt.bin");
+	// Compression mode, block size, uncompressed size and the size of the only block.
+	const uint32_t headers[][4] = {
+		{ 99, 4096, 100, 10 }, // unknown compression mode
+		{ Compression::MODE_ZSTD, 0, 100, 10 }, // no block size
+		{ Compression::MODE_ZSTD, 4096, 100, 0x7FFFFFF0 }, // block past the end of the file
+		{ Compression::MODE_ZSTD, 1, 0x7FFFFFF0, 10 }, // block table past the end of the file
+	};
+
+	int opened = 0;
+	for (int i = 0; i < (int)(sizeof(headers) / sizeof(headers[0])); i++) {
+
+		FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+		ERR_FAIL_COND_V(!f, 0);
+		f->store_buffer((const uint8_t *)"TCMP", 4);
+		for (int j = 0; j < 4; j++) {
+			f->store_32(headers[i][j]);
+		}
+		f->close();
+		memdelete(f);
+
+		FileAccessCompressed *fac = memnew(FileAccessCompressed);
+		fac->configure("TCMP");
+		if (fac->_open(path, FileAccess::READ) != ERR_FILE_CORRUPT) {
+			opened++;
+		}
+		memdelete(fac);
+	}
+
+	DirAccess::remove_file_or_error(path);
+	return opened;
+}
+
+MainLoop *test() {
+
+	String raw_pack = OS::get_singleton()->get_user_data_dir().plus_file("test_pck_raw.pck");
+	String zstd_pack = OS::get_singleton()->get_user_data_dir().plus_file("test_pck_zstd.pck");
+
+	OS::get_singleton()->print("Writing %d files of %d KiB...\n", FILE_COUNT, FILE_SIZE / 1024);
+	_write_sources();
+
+	uint64_t raw_size = _write_pack(raw_pack, "res://test_pck_raw/file_", false);
+	uint64_t zstd_size = _write_pack(zstd_pack, "res://test_pck_zstd/file_", true);
+
+	PackedData::get_singleton()->add_pack(raw_pack, false);
+	PackedData::get_singleton()->add_pack(zstd_pack, false);
+
+	OS::get_singleton()->print("Raw pack: %.2f MiB, Zstd pack: %.2f MiB\n", raw_size / 1048576.0, zstd_size / 1048576.0);
+
+	int raw_mismatches = _verify("res://test_pck_raw/file_");
+	int zstd_mismatches = _verify("res://test_pck_zstd/file_");
+	OS::get_singleton()->print("Verified %d files per pack: raw %d mismatching, Zstd %d mismatching\n", FILE_COUNT, raw_mismatches, zstd_mismatches);
+	int corrupt_opened = _open_corrupt_headers();
+	OS::get_singleton()->print("Compressed files with a damaged header refused: %s\n", corrupt_opened ? "no" : "yes");
+	if (raw_mismatches || zstd_mismatches || corrupt_opened) {
+		OS::get_singleton()->set_exit_code(1);
+	}
+
+	// The packs were just written so they are likely in the OS cache, drop it between runs
+	// (e.g. "echo 3 > /proc/sys/vm/drop_caches") to measure a cold start instead.
+	for (int run = 0; run < 2; run++) {
+		uint64_t raw_bytes, zstd_bytes;
+		uint64_t raw_usec = _read_all("res://test_pck_raw/file_", &raw_bytes);
+		uint64_t zstd_usec = _read_all("res://test_pck_zstd/file_", &zstd_bytes);
+		OS::get_singleton()->print("Run %d: raw %.3f msec (%.2f MiB), Zstd %.3f msec (%.2f MiB)\n", run + 1, raw_usec / 1000.0, raw_bytes / 1048576.0, zstd_usec / 1000.0, zstd_bytes / 1048576.0);
+	}
+
+	for (int i = 0; i < FILE_COUNT; i++) {
+		DirAccess::remove_file_or_error(_source_path(i));
+	}
+	DirAccess::remove_file_or_error(raw_pack);
+	DirAccess::remove_file_or_error(zstd_pack);
+
+	return NULL;
+}
+} // namespace TestPCKCompression
@@ -0,0 +1,301 @@
+/*************************************************************************/
+/*  test_resource_loader.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_loader.h"
+
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/version.h"
+#include "scene/animation/animation_player.h"
+#include "scene/resources/gradient.h"
+#include "scene/resources/packed_scene.h"
+
+namespace TestResourceLoader {
+
+static const int ANIMATION_COUNT = 64;
+static const int KEY_COUNT = 2000;
+
+static String _animation_path(int p_index) {
+
+	return "user://test_resource_loader/anim_" + itos(p_index) + ".tres";
+}
+
+static Ref<Animation> _make_animation(int p_index) {
+
+	Ref<Animation> anim;
+	anim.instance();
+	int track = anim->add_track(Animation::TYPE_VALUE);
+	anim->track_set_path(track, NodePath("..:position"));
+	for (int j = 0; j < KEY_COUNT; j++) {
+		anim->track_insert_key(track, j * 0.01, Vector2(j, p_index));
+	}
+	anim->set_length(KEY_COUNT * 0.01);
+	return anim;
+}
+
+// A scene with an AnimationPlayer referencing many external animations, which are the dependencies loaded in parallel.
+static bool _write_scene(const String &p_scene_path) {
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->make_dir_recursive("user://test_resource_loader");
+	memdelete(da);
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->set_name("AnimationPlayer");
+
+	for (int i = 0; i < ANIMATION_COUNT; i++) {
+
+		Ref<Animation> anim = _make_animation(i);
+
+		if (ResourceSaver::save(_animation_path(i), anim, ResourceSaver::FLAG_CHANGE_PATH) != OK) {
+			memdelete(player);
+			return false;
+		}
+		player->add_animation("anim_" + itos(i), anim);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	Error err = scene->pack(player);
+	if (err == OK) {
+		err = ResourceSaver::save(p_scene_path, scene);
+	}
+	memdelete(player);
+
+	return err == OK;
+}
+
+// The same animations built into a binary scene, to load one of them on its own.
+static int _write_builtin_scene(const String &p_scene_path) {
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->set_name("AnimationPlayer");
+
+	Vector<Ref<Animation> > anims;
+	for (int i = 0; i < ANIMATION_COUNT; i++) {
+
+		Ref<Animation> anim = _make_animation(i);
+		player->add_animation("anim_" + itos(i), anim);
+		anims.push_back(anim);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	Error err = scene->pack(player);
+	if (err == OK) {
+		err = ResourceSaver::save(p_scene_path, scene);
+	}
+	memdelete(player);
+
+	// Saving assigned the subindex each animation is stored under.
+	return err == OK ? anims[ANIMATION_COUNT / 2]->get_subindex() : -1;
+}
+
+static void _remove_scene(const String &p_scene_path) {
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	for (int i = 0; i < ANIMATION_COUNT; i++) {
+		da->remove(_animation_path(i));
+	}
+	da->remove(p_scene_path);
+	da->remove("user://test_resource_loader");
+	memdelete(da);
+}
+
+static int _count_animations(const RES &p_res) {
+
+	Ref<PackedScene> scene = p_res;
+	if (scene.is_null()) {
+		return -1;
+	}
+
+	Node *node = scene->instance();
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(node);
+	List<StringName> animations;
+	if (player) {
+		player->get_animation_list(&animations);
+	}
+	memdelete(node);
+
+	return animations.size();
+}
+
+static void _store_unicode_string(FileAccess *p_f, const String &p_string) {
+
+	CharString utf8 = p_string.utf8();
+	p_f->store_32(utf8.length() + 1);
+	p_f->store_buffer((const uint8_t *)utf8.get_data(), utf8.length() + 1);
+}
+
+// Writes by hand a Gradient the way a build with 32-bit reals saves it, as all existing assets are,
+// and checks its PoolColorArray loads back intact (which matters to builds with 64-bit reals).
+static bool _check_float_colors(const String &p_path) {
+
+	const Color colors[3] = { Color(1, 0, 0, 1), Color(0.25, 0.5, 0.75, 1), Color(0, 0, 1, 0.5) };
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	if (!f) {
+		return false;
+	}
+
+	f->store_buffer((const uint8_t *)"RSRC", 4);
+	f->store_32(0); // little endian
+	f->store_32(0); // 32-bit reals
+	f->store_32(VERSION_MAJOR);
+	f->store_32(VERSION_MINOR);
+	f->store_32(3); // format version
+	_store_unicode_string(f, "Gradient");
+	f->store_64(0); // no import metadata
+	for (int i = 0; i < 14; i++) {
+		f->store_32(0); // reserved
+	}
+
+	f->store_32(1); // string table
+	_store_unicode_string(f, "colors");
+	f->store_32(0); // external resources
+	f->store_32(1); // internal resources
+	_store_unicode_string(f, "local://1");
+	f->store_64(f->get_position() + 8); // the resource follows its offset
+
+	_store_unicode_string(f, "Gradient");
+	f->store_32(1); // properties
+	f->store_32(0); // "colors" in the string table
+	f->store_32(36); // PoolColorArray
+	f->store_32(3);
+	for (int i = 0; i < 3; i++) {
+		f->store_float(colors[i].r);
+		f->store_float(colors[i].g);
+		f->store_float(colors[i].b);
+		f->store_float(colors[i].a);
+	}
+	f->store_buffer((const uint8_t *)"RSRC", 4);
+	f->close();
+	memdelete(f);
+
+	Ref<Gradient> gradient = ResourceLoader::load(p_path, "", true);
+	if (gradient.is_null() || gradient->get_colors().size() != 3) {
+		return false;
+	}
+	for (int i = 0; i < 3; i++) {
+		if (gradient->get_colors()[i] != colors[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+MainLoop *test() {
+
+	String scene_path = "user://test_resource_loader/scene.tscn";
+
+	OS::get_singleton()->print("Writing %d animations of %d keys...\n", ANIMATION_COUNT, KEY_COUNT);
+	if (!_write_scene(scene_path)) {
+		OS::get_singleton()->print("Failed writing the test scene.\n");
+		_remove_scene(scene_path);
+		return NULL;
+	}
+
+	// Nothing references the scene anymore, so both loads start with an empty resource cache.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	RES res = ResourceLoader::load(scene_path);
+	uint64_t sync_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	int sync_count = _count_animations(res);
+	res.unref();
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	ResourceLoader::load_threaded_request(scene_path, "", true);
+	ResourceLoader::load_threaded_request(scene_path, "", true); // Shares the load above.
+
+	int polls = 0;
+	float progress = 0;
+	while (ResourceLoader::load_threaded_get_status(scene_path, &progress) == ResourceLoader::THREAD_LOAD_IN_PROGRESS) {
+		if (polls++ % 50 == 0) {
+			OS::get_singleton()->print("\tprogress %d%%\n", int(progress * 100));
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+
+	res = ResourceLoader::load_threaded_get(scene_path);
+	uint64_t threaded_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	RES shared = ResourceLoader::load_threaded_get(scene_path);
+	int threaded_count = _count_animations(res);
+
+	OS::get_singleton()->print("Synchronous load: %.3f msec, %d animations\n", sync_usec / 1000.0, sync_count);
+	OS::get_singleton()->print("Threaded load (%d cores): %.3f msec, %d animations\n", OS::get_singleton()->get_processor_count(), threaded_usec / 1000.0, threaded_count);
+	OS::get_singleton()->print("Duplicate request shared: %s\n", (res.is_valid() && res == shared) ? "yes" : "no");
+	OS::get_singleton()->print("Unrequested path rejected: %s\n", ResourceLoader::load_threaded_get_status(scene_path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE ? "yes" : "no");
+
+	res.unref();
+	shared.unref();
+
+	String builtin_path = "user://test_resource_loader/builtin.scn";
+	int subindex = _write_builtin_scene(builtin_path);
+	if (subindex > 0) {
+
+		uint64_t mem = Memory::get_mem_usage();
+		begin = OS::get_singleton()->get_ticks_usec();
+		res = ResourceLoader::load(builtin_path);
+		uint64_t full_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		uint64_t full_mem = Memory::get_mem_usage() - mem;
+		res.unref();
+
+		String sub_path = builtin_path + "::" + itos(subindex);
+		mem = Memory::get_mem_usage();
+		begin = OS::get_singleton()->get_ticks_usec();
+		Ref<Animation> anim = ResourceLoader::load(sub_path);
+		uint64_t sub_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		uint64_t sub_mem = Memory::get_mem_usage() - mem;
+
+		OS::get_singleton()->print("Full binary scene load: %.3f msec, %d KiB\n", full_usec / 1000.0, int(full_mem / 1024));
+		OS::get_singleton()->print("Single built-in animation load: %.3f msec, %d KiB, %d keys\n", sub_usec / 1000.0, int(sub_mem / 1024), anim.is_valid() ? anim->track_get_key_count(0) : -1);
+		anim.unref();
+	} else {
+		OS::get_singleton()->print("Failed writing the binary test scene.\n");
+	}
+
+	String colors_path = "user://test_resource_loader/float_colors.res";
+	bool colors_ok = _check_float_colors(colors_path);
+	OS::get_singleton()->print("PoolColorArray saved with 32-bit reals loaded (%d-bit reals): %s\n", int(sizeof(real_t) * 8), colors_ok ? "yes" : "no");
+	if (!colors_ok) {
+		OS::get_singleton()->set_exit_code(1);
+	}
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->remove(builtin_path);
+	da->remove(colors_path);
+	memdelete(da);
+	_remove_scene(scene_path);
+
+	return NULL;
+}
+} // namespace TestResourceLoader
@@ -0,0 +1,162 @@
+/*************************************************************************/
+/*  test_text_resource.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_text_resource.h"
+
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/variant_parser.h"
+#include "scene/2d/node_2d.h"
+#include "scene/resources/curve.h"
+#include "scene/resources/packed_scene.h"
+
+namespace TestTextResource {
+
+static const int NODE_COUNT = 20000;
+static const int POINT_COUNT = 100000;
+
+// A scene with many nodes, each with a few properties, and a built-in resource holding a large array.
+static bool _write_scene(const String &p_path) {
+
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+
+	Ref<Curve2D> curve;
+	curve.instance();
+	for (int i = 0; i < POINT_COUNT; i++) {
+		curve->add_point(Vector2(i * 0.5, i % 100));
+	}
+	root->set_meta("curve", curve);
+
+	for (int i = 0; i < NODE_COUNT; i++) {
+
+		Node2D *node = memnew(Node2D);
+		node->set_name(String::utf8("Node \xc3\xb1 ") + itos(i)); // Non-ASCII names go through UTF-8 decoding.
+		node->set_position(Vector2(i, -i * 0.25));
+		node->set_rotation(i * 0.001);
+		node->set_meta("description", "Generated node number " + itos(i));
+		root->add_child(node);
+		node->set_owner(root);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	Error err = scene->pack(root);
+	if (err == OK) {
+		err = ResourceSaver::save(p_path, scene);
+	}
+	memdelete(root);
+
+	return err == OK;
+}
+
+// Parses every tag and assignment in the file, returning how many were found or -1 on error.
+static int _parse_file(const String &p_path, bool p_readahead, uint64_t &r_usec) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return -1;
+	}
+
+	VariantParser::StreamFile stream;
+	stream.f = f;
+	stream.readahead_enabled = p_readahead;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	int count = 0;
+	int lines = 0;
+	String error_text;
+	while (true) {
+
+		String assign;
+		Variant value;
+		VariantParser::Tag next_tag;
+
+		Error err = VariantParser::parse_tag_assign_eof(&stream, lines, error_text, next_tag, assign, value, NULL, true);
+		if (err == ERR_FILE_EOF) {
+			break;
+		} else if (err != OK) {
+			OS::get_singleton()->print("Parse error at line %d: %ls\n", lines, error_text.c_str());
+			count = -1;
+			break;
+		}
+		count++;
+	}
+
+	r_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	memdelete(f);
+
+	return count;
+}
+
+MainLoop *test() {
+
+	String path = "user://test_text_resource.tscn";
+
+	OS::get_singleton()->print("Writing a scene with %d nodes and %d curve points...\n", NODE_COUNT, POINT_COUNT);
+	if (!_write_scene(path)) {
+		OS::get_singleton()->print("Failed writing the test scene.\n");
+		return NULL;
+	}
+
+	uint64_t unbuffered_usec = 0;
+	int unbuffered_count = _parse_file(path, false, unbuffered_usec);
+	uint64_t buffered_usec = 0;
+	int buffered_count = _parse_file(path, true, buffered_usec);
+
+	OS::get_singleton()->print("Unbuffered parse: %.3f msec, %d entries\n", unbuffered_usec / 1000.0, unbuffered_count);
+	OS::get_singleton()->print("Buffered parse: %.3f msec, %d entries\n", buffered_usec / 1000.0, buffered_count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Ref<PackedScene> scene = ResourceLoader::load(path, "", true);
+	uint64_t load_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	bool match = false;
+	if (scene.is_valid()) {
+		Node *root = scene->instance();
+		Node *node = root->get_child_count() == NODE_COUNT ? root->get_child(NODE_COUNT - 1) : NULL;
+		match = node && String(node->get_name()) == String::utf8("Node \xc3\xb1 ") + itos(NODE_COUNT - 1);
+		memdelete(root);
+	}
+
+	OS::get_singleton()->print("Scene load: %.3f msec, contents match: %s\n", load_usec / 1000.0, match ? "yes" : "no");
+
+	scene.unref();
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->remove(path);
+	memdelete(da);
+
+	return NULL;
+}
+} // namespace TestTextResource
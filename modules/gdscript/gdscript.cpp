@@ -38,6 +38,7 @@
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "gdscript_compiler.h"
+#include "gdscript_serializer.h"
 
 ///////////////////////////
 
@@ -796,6 +797,29 @@ Error GDScript::load_byte_code(const String &p_path) {
 	return OK;
 }
 
+Error GDScript::load_precompiled(const String &p_path) {
+
+	Vector<uint8_t> buffer = FileAccess::get_file_as_array(p_path);
+	ERR_FAIL_COND_V(buffer.size() == 0, ERR_FILE_CORRUPT);
+
+	valid = false;
+	String error;
+	Error err = GDScriptSerializer::load(buffer, this, &error);
+	if (err) {
+		_err_print_error("GDScript::load_precompiled", path.empty() ? "built-in" : (const char *)path.utf8().get_data(), 0, ("Load Error: " + error).utf8().get_data(), ERR_HANDLER_SCRIPT);
+		ERR_FAIL_V(err);
+	}
+
+	valid = true;
+
+	for (Map<StringName, Ref<GDScript> >::Element *E = subclasses.front(); E; E = E->next()) {
+
+		_set_subclass_path(E->get(), path);
+	}
+
+	return OK;
+}
+
 Error GDScript::load_source_code(const String &p_path) {
 
 	PoolVector<uint8_t> sourcef;
@@ -888,10 +912,21 @@ void GDScript::get_script_signal_list(List<MethodInfo> *r_signals) const {
 #endif
 }
 
+uint32_t GDScript::_next_member_layout() {
+
+	static volatile uint32_t last_member_layout = 0;
+	uint32_t layout;
+	do {
+		layout = atomic_increment(&last_member_layout);
+	} while (layout == 0);
+	return layout;
+}
+
 GDScript::GDScript() :
 		script_list(this) {
 
 	_static_ref = this;
+	member_layout = _next_member_layout();
 	valid = false;
 	subclass_count = 0;
 	initializer = NULL;
@@ -1350,6 +1385,7 @@ GDScriptInstance::~GDScriptInstance() {
 /************* SCRIPT LANGUAGE **************/
 
 GDScriptLanguage *GDScriptLanguage::singleton = NULL;
+ThreadLocal<GDScriptLanguage::ThreadCallStack> GDScriptLanguage::thread_call_stack;
 
 String GDScriptLanguage::get_name() const {
 
@@ -1423,6 +1459,13 @@ void GDScriptLanguage::init() {
 
 		_add_global(E->get().name, E->get().ptr);
 	}
+
+#ifdef DEBUG_ENABLED
+	if (sample_output_path != String() && sample_interval_usec > 0) {
+		// Profile the whole run, for servers and other runs without a debugger attached.
+		sampling_start(sample_interval_usec);
+	}
+#endif
 }
 
 String GDScriptLanguage::get_type() const {
@@ -1439,6 +1482,18 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 	return OK;
 }
 void GDScriptLanguage::finish() {
+
+	if (sampling && !sampling_for_profiler) {
+		sampling_stop();
+		Error err = sampling_save(sample_output_path);
+		if (err == OK) {
+			print_verbose("GDScript: Saved sampling profile to " + sample_output_path);
+		}
+	}
+
+	if (source_load_count || precompiled_load_count) {
+		print_verbose(get_script_load_stats());
+	}
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -1459,6 +1514,10 @@ void GDScriptLanguage::profiling_start() {
 		elem->self()->profile.last_frame_call_count = 0;
 		elem->self()->profile.last_frame_self_time = 0;
 		elem->self()->profile.last_frame_total_time = 0;
+		elem->self()->profile.named_cache_hits = 0;
+		elem->self()->profile.named_cache_misses = 0;
+		elem->self()->profile.call_cache_hits = 0;
+		elem->self()->profile.call_cache_misses = 0;
 		elem = elem->next();
 	}
 
@@ -1467,6 +1526,9 @@ void GDScriptLanguage::profiling_start() {
 		lock->unlock();
 	}
 
+	if (!sampling && sample_interval_usec > 0 && is_tracking_calls()) {
+		sampling_for_profiler = sampling_start(sample_interval_usec) == OK;
+	}
 #endif
 }
 
@@ -1482,9 +1544,162 @@ void GDScriptLanguage::profiling_stop() {
 		lock->unlock();
 	}
 
+	if (sampling_for_profiler) {
+		sampling_stop();
+		sampling_for_profiler = false;
+		_send_samples();
+	}
 #endif
 }
 
+void GDScriptLanguage::_sampler_thread_func(void *p_userdata) {
+
+	GDScriptLanguage *language = (GDScriptLanguage *)p_userdata;
+
+	while (language->sampling) {
+
+		OS::get_singleton()->delay_usec(language->sample_interval_usec);
+		// Racy on purpose, at worst a sample is missed or taken a bit late.
+		if (language->_debug_call_stack_pos > 0) {
+			language->sample_pending = true;
+		}
+	}
+}
+
+Error GDScriptLanguage::sampling_start(int p_interval_usec) {
+
+	ERR_FAIL_COND_V_MSG(!is_tracking_calls(), ERR_UNAVAILABLE, "The GDScript sampling profiler needs a debugger, or an output path in the project settings.");
+	ERR_FAIL_COND_V(p_interval_usec <= 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(sampling, ERR_ALREADY_IN_USE);
+
+#ifdef NO_THREADS
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "The GDScript sampling profiler needs threads.");
+#else
+	if (lock) {
+		lock->lock();
+	}
+	samples.clear();
+	if (lock) {
+		lock->unlock();
+	}
+
+	sample_interval_usec = p_interval_usec;
+	sample_pending = false;
+	sampling = true;
+	sampler_thread = Thread::create(_sampler_thread_func, this);
+	return OK;
+#endif
+}
+
+void GDScriptLanguage::sampling_stop() {
+
+	if (!sampling) {
+		return;
+	}
+
+	sampling = false;
+	Thread::wait_to_finish(sampler_thread);
+	memdelete(sampler_thread);
+	sampler_thread = NULL;
+	sample_pending = false;
+}
+
+void GDScriptLanguage::take_sample() {
+
+	sample_pending = false;
+
+	// Root first, each frame being the function and the line it's running.
+	String stack;
+	for (int i = 0; i < _debug_call_stack_pos; i++) {
+
+		const CallLevel &cl = _call_stack[i];
+		if (i > 0) {
+			stack += ";";
+		}
+		stack += String(cl.function->get_name()) + " (" + cl.function->get_source() + ":" + itos(*cl.line) + ")";
+	}
+
+	if (stack.empty()) {
+		return;
+	}
+
+	if (lock) {
+		lock->lock();
+	}
+
+	Map<String, uint64_t>::Element *E = samples.find(stack);
+	if (E) {
+		E->get()++;
+	} else {
+		samples.insert(stack, 1);
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+}
+
+void GDScriptLanguage::sampling_get_samples(Map<String, uint64_t> *r_samples, bool p_clear) {
+
+	if (lock) {
+		lock->lock();
+	}
+
+	for (Map<String, uint64_t>::Element *E = samples.front(); E; E = E->next()) {
+		Map<String, uint64_t>::Element *F = r_samples->find(E->key());
+		if (F) {
+			F->get() += E->get();
+		} else {
+			r_samples->insert(E->key(), E->get());
+		}
+	}
+	if (p_clear) {
+		samples.clear();
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+}
+
+Error GDScriptLanguage::sampling_save(const String &p_path) {
+
+	Map<String, uint64_t> taken;
+	sampling_get_samples(&taken, false);
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Can't save GDScript sampling profile to '" + p_path + "'.");
+
+	// One line per call stack, followed by the number of samples it got.
+	for (Map<String, uint64_t>::Element *E = taken.front(); E; E = E->next()) {
+		f->store_line(E->key() + " " + itos(E->get()));
+	}
+
+	memdelete(f);
+	return OK;
+}
+
+void GDScriptLanguage::_send_samples() {
+
+	if (!ScriptDebugger::get_singleton() || !ScriptDebugger::get_singleton()->is_remote()) {
+		return;
+	}
+
+	Map<String, uint64_t> taken;
+	sampling_get_samples(&taken, true);
+	if (taken.empty()) {
+		return;
+	}
+
+	Array data;
+	for (Map<String, uint64_t>::Element *E = taken.front(); E; E = E->next()) {
+		data.push_back(E->key());
+		data.push_back(E->get());
+	}
+	ScriptDebugger::get_singleton()->send_message("gdscript_samples", data);
+}
+
 int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) {
 
 	int current = 0;
@@ -1546,6 +1761,84 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 	return current;
 }
 
+uint8_t *GDScriptLanguage::alloc_yield_frame(uint32_t p_size) {
+
+	if (!p_size) {
+		return NULL;
+	}
+
+	uint8_t *frame = NULL;
+
+	if (lock) {
+		lock->lock();
+	}
+
+	Map<uint32_t, Vector<uint8_t *> >::Element *E = yield_frame_pool.find(p_size);
+	if (E && E->get().size()) {
+		frame = E->get()[E->get().size() - 1];
+		E->get().resize(E->get().size() - 1);
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+
+	if (!frame) {
+		frame = (uint8_t *)memalloc(p_size);
+	}
+
+	return frame;
+}
+
+void GDScriptLanguage::free_yield_frame(uint8_t *p_frame, uint32_t p_size) {
+
+	if (!p_frame) {
+		return;
+	}
+
+	if (lock) {
+		lock->lock();
+	}
+
+	Vector<uint8_t *> &frames = yield_frame_pool[p_size];
+	bool pooled = frames.size() < YIELD_FRAME_POOL_MAX;
+	if (pooled) {
+		frames.push_back(p_frame);
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+
+	if (!pooled) {
+		memfree(p_frame);
+	}
+}
+
+void GDScriptLanguage::add_script_load_time(bool p_precompiled, uint64_t p_usec) {
+
+	if (lock) {
+		lock->lock();
+	}
+
+	if (p_precompiled) {
+		precompiled_load_count++;
+		precompiled_load_usec += p_usec;
+	} else {
+		source_load_count++;
+		source_load_usec += p_usec;
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+}
+
+String GDScriptLanguage::get_script_load_stats() const {
+
+	return "GDScript: loaded " + itos(source_load_count) + " scripts from source in " + rtos(source_load_usec / 1000.0) + " msec, " + itos(precompiled_load_count) + " precompiled in " + rtos(precompiled_load_usec / 1000.0) + " msec.";
+}
+
 struct GDScriptDepSort {
 
 	//must support sorting so inheritance works properly (parent must be reloaded first)
@@ -1747,6 +2040,11 @@ void GDScriptLanguage::frame() {
 			lock->lock();
 		}
 
+		uint64_t named_cache_hits = 0;
+		uint64_t named_cache_misses = 0;
+		uint64_t call_cache_hits = 0;
+		uint64_t call_cache_misses = 0;
+
 		SelfList<GDScriptFunction> *elem = function_list.first();
 		while (elem) {
 			elem->self()->profile.last_frame_call_count = elem->self()->profile.frame_call_count;
@@ -1755,14 +2053,39 @@ void GDScriptLanguage::frame() {
 			elem->self()->profile.frame_call_count = 0;
 			elem->self()->profile.frame_self_time = 0;
 			elem->self()->profile.frame_total_time = 0;
+			named_cache_hits += elem->self()->profile.named_cache_hits;
+			named_cache_misses += elem->self()->profile.named_cache_misses;
+			elem->self()->profile.named_cache_hits = 0;
+			elem->self()->profile.named_cache_misses = 0;
+			call_cache_hits += elem->self()->profile.call_cache_hits;
+			call_cache_misses += elem->self()->profile.call_cache_misses;
+			elem->self()->profile.call_cache_hits = 0;
+			elem->self()->profile.call_cache_misses = 0;
 			elem = elem->next();
 		}
 
 		if (lock) {
 			lock->unlock();
 		}
+
+		if (ScriptDebugger::get_singleton() && ScriptDebugger::get_singleton()->is_profiling()) {
+			// Integer values are shown as counts by the editor profiler, not as times.
+			Array values;
+			values.push_back("named_cache_hits");
+			values.push_back(named_cache_hits);
+			values.push_back("named_cache_misses");
+			values.push_back(named_cache_misses);
+			values.push_back("call_cache_hits");
+			values.push_back(call_cache_hits);
+			values.push_back("call_cache_misses");
+			values.push_back(call_cache_misses);
+			ScriptDebugger::get_singleton()->add_profiling_frame_data("gdscript_caches", values);
+		}
 	}
 
+	if (sampling_for_profiler) {
+		_send_samples();
+	}
 #endif
 }
 
@@ -2132,11 +2455,24 @@ GDScriptLanguage::GDScriptLanguage() {
 	profiling = false;
 	script_frame_time = 0;
 
+	source_load_count = 0;
+	source_load_usec = 0;
+	precompiled_load_count = 0;
+	precompiled_load_usec = 0;
+
 	_debug_call_stack_pos = 0;
 	int dmcs = GLOBAL_DEF("debug/settings/gdscript/max_call_stack", 1024);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/gdscript/max_call_stack", PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater")); //minimum is 1024
 
-	if (ScriptDebugger::get_singleton()) {
+	sampler_thread = NULL;
+	sampling = false;
+	sample_pending = false;
+	sampling_for_profiler = false;
+	sample_interval_usec = GLOBAL_DEF("debug/settings/gdscript/sampling_profiler/interval_usec", 1000);
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/gdscript/sampling_profiler/interval_usec", PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler/interval_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater")); //0 disables it
+	sample_output_path = GLOBAL_DEF("debug/settings/gdscript/sampling_profiler/output_path", "");
+
+	if (ScriptDebugger::get_singleton() || sample_output_path != String()) {
 		//debugging enabled!
 
 		_debug_max_call_stack = dmcs;
@@ -2162,6 +2498,14 @@ GDScriptLanguage::GDScriptLanguage() {
 
 GDScriptLanguage::~GDScriptLanguage() {
 
+	sampling_stop();
+
+	for (Map<uint32_t, Vector<uint8_t *> >::Element *E = yield_frame_pool.front(); E; E = E->next()) {
+		for (int i = 0; i < E->get().size(); i++) {
+			memfree(E->get()[i]);
+		}
+	}
+
 	if (lock) {
 		memdelete(lock);
 		lock = NULL;
@@ -2183,7 +2527,17 @@ RES ResourceFormatLoaderGDScript::load(const String &p_path, const String &p_ori
 
 	Ref<GDScript> scriptres(script);
 
-	if (p_path.ends_with(".gde") || p_path.ends_with(".gdc")) {
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	bool precompiled = p_path.ends_with(".gdo");
+
+	if (precompiled) {
+
+		script->set_script_path(p_original_path); // script needs this.
+		script->set_path(p_original_path);
+		Error err = script->load_precompiled(p_path);
+		ERR_FAIL_COND_V_MSG(err != OK, RES(), "Cannot load compiled script from file '" + p_path + "'.");
+
+	} else if (p_path.ends_with(".gde") || p_path.ends_with(".gdc")) {
 
 		script->set_script_path(p_original_path); // script needs this.
 		script->set_path(p_original_path);
@@ -2199,6 +2553,9 @@ RES ResourceFormatLoaderGDScript::load(const String &p_path, const String &p_ori
 
 		script->reload();
 	}
+
+	GDScriptLanguage::get_singleton()->add_script_load_time(precompiled, OS::get_singleton()->get_ticks_usec() - from);
+
 	if (r_error)
 		*r_error = OK;
 
@@ -2210,6 +2567,7 @@ void ResourceFormatLoaderGDScript::get_recognized_extensions(List<String> *p_ext
 	p_extensions->push_back("gd");
 	p_extensions->push_back("gdc");
 	p_extensions->push_back("gde");
+	p_extensions->push_back("gdo");
 }
 
 bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
@@ -2220,7 +2578,7 @@ bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
 String ResourceFormatLoaderGDScript::get_resource_type(const String &p_path) const {
 
 	String el = p_path.get_extension().to_lower();
-	if (el == "gd" || el == "gdc" || el == "gde")
+	if (el == "gd" || el == "gdc" || el == "gde" || el == "gdo")
 		return "GDScript";
 	return "";
 }
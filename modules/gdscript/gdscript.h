@@ -33,6 +33,7 @@
 
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/os/thread_local.h"
 #include "core/script_language.h"
 #include "gdscript_function.h"
 
@@ -72,6 +73,7 @@ class GDScript : public Script {
 	friend class GDScriptCompiler;
 	friend class GDScriptFunctions;
 	friend class GDScriptLanguage;
+	friend class GDScriptSerializer;
 
 	Variant _static_ref; //used for static call
 	Ref<GDScriptNativeClass> native;
@@ -83,6 +85,7 @@ class GDScript : public Script {
 	Map<StringName, Variant> constants;
 	Map<StringName, GDScriptFunction *> member_functions;
 	Map<StringName, MemberInfo> member_indices; //members are just indices to the instanced script.
+	uint32_t member_layout; //changes each time members, constants or accessors are compiled, never 0
 	Map<StringName, Ref<GDScript> > subclasses;
 	Map<StringName, Vector<StringName> > _signals;
 
@@ -115,6 +118,8 @@ class GDScript : public Script {
 
 	GDScriptInstance *_create_instance(const Variant **p_args, int p_argcount, Object *p_owner, bool p_isref, Variant::CallError &r_error);
 
+	static uint32_t _next_member_layout();
+
 	void _set_subclass_path(Ref<GDScript> &p_sc, const String &p_path);
 
 #ifdef TOOLS_ENABLED
@@ -185,6 +190,7 @@ public:
 	void set_script_path(const String &p_path) { path = p_path; } //because subclasses need a path too...
 	Error load_source_code(const String &p_path);
 	Error load_byte_code(const String &p_path);
+	Error load_precompiled(const String &p_path);
 
 	Vector<uint8_t> get_as_byte_code() const;
 
@@ -338,6 +344,28 @@ class GDScriptLanguage : public ScriptLanguage {
 	int _debug_max_call_stack;
 	CallLevel *_call_stack;
 
+	// Call stack of a thread other than the main one. Only that thread reads or writes it, so no lock is taken.
+	struct ThreadCallStack {
+
+		CallLevel *levels; // allocated on the first call, with room for _debug_max_call_stack levels
+		int pos; // may go past _debug_max_call_stack on overflow, so enters and exits stay balanced
+
+		ThreadCallStack() :
+				levels(NULL),
+				pos(0) {}
+		~ThreadCallStack() {
+			if (levels) {
+				memdelete_arr(levels);
+			}
+		}
+	};
+
+	static ThreadLocal<ThreadCallStack> thread_call_stack;
+
+	bool _thread_enter_function(GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line);
+	void _thread_exit_function();
+	Vector<StackInfo> _thread_get_current_stack_info();
+
 	void _add_global(const StringName &p_name, const Variant &p_value);
 
 	friend class GDScriptInstance;
@@ -353,25 +381,60 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	uint64_t script_frame_time;
 
+	// Frames of yielded calls are recycled, so scripts that keep yielding don't allocate on each yield.
+	enum {
+		YIELD_FRAME_POOL_MAX = 256 // free frames kept per size
+	};
+	Map<uint32_t, Vector<uint8_t *> > yield_frame_pool;
+
+	// Time spent by the loader on scripts, to compare compiling from source against precompiled exports.
+	int source_load_count;
+	uint64_t source_load_usec;
+	int precompiled_load_count;
+	uint64_t precompiled_load_usec;
+
+	// The sampling profiler thread only raises sample_pending, the main thread then records
+	// its call stack on the next line it runs, so no frame is read while it changes.
+	Thread *sampler_thread;
+	volatile bool sampling;
+	volatile bool sample_pending;
+	bool sampling_for_profiler;
+	int sample_interval_usec;
+	Map<String, uint64_t> samples; //folded call stack -> samples taken, guarded by lock
+	String sample_output_path;
+
+	static void _sampler_thread_func(void *p_userdata);
+	void _send_samples();
+
 public:
 	int calls;
 
 	bool debug_break(const String &p_error, bool p_allow_continue = true);
+
+	// Calls are tracked when debugging, or when the sampling profiler dumps to a file without a debugger.
+	_FORCE_INLINE_ bool is_tracking_calls() const { return _call_stack != NULL; }
 	bool debug_break_parse(const String &p_file, int p_line, const String &p_error);
 
-	_FORCE_INLINE_ void enter_function(GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line) {
+	// Returns false when the call must fail, which only happens on a stack overflow outside the main thread.
+	_FORCE_INLINE_ bool enter_function(GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line) {
 
-		if (Thread::get_main_id() != Thread::get_caller_id())
-			return; //no support for other threads than main for now
+		if (Thread::get_main_id() != Thread::get_caller_id()) {
+			return _thread_enter_function(p_instance, p_function, p_stack, p_ip, p_line);
+		}
 
-		if (ScriptDebugger::get_singleton()->get_lines_left() > 0 && ScriptDebugger::get_singleton()->get_depth() >= 0)
-			ScriptDebugger::get_singleton()->set_depth(ScriptDebugger::get_singleton()->get_depth() + 1);
+		ScriptDebugger *debugger = ScriptDebugger::get_singleton();
+		if (debugger && debugger->get_lines_left() > 0 && debugger->get_depth() >= 0)
+			debugger->set_depth(debugger->get_depth() + 1);
 
 		if (_debug_call_stack_pos >= _debug_max_call_stack) {
 			//stack overflow
 			_debug_error = "Stack Overflow (Stack Size: " + itos(_debug_max_call_stack) + ")";
-			ScriptDebugger::get_singleton()->debug(this);
-			return;
+			if (debugger) {
+				debugger->debug(this);
+			} else {
+				ERR_PRINTS(_debug_error);
+			}
+			return true;
 		}
 
 		_call_stack[_debug_call_stack_pos].stack = p_stack;
@@ -380,20 +443,28 @@ public:
 		_call_stack[_debug_call_stack_pos].ip = p_ip;
 		_call_stack[_debug_call_stack_pos].line = p_line;
 		_debug_call_stack_pos++;
+		return true;
 	}
 
 	_FORCE_INLINE_ void exit_function() {
 
-		if (Thread::get_main_id() != Thread::get_caller_id())
-			return; //no support for other threads than main for now
+		if (Thread::get_main_id() != Thread::get_caller_id()) {
+			_thread_exit_function();
+			return;
+		}
 
-		if (ScriptDebugger::get_singleton()->get_lines_left() > 0 && ScriptDebugger::get_singleton()->get_depth() >= 0)
-			ScriptDebugger::get_singleton()->set_depth(ScriptDebugger::get_singleton()->get_depth() - 1);
+		ScriptDebugger *debugger = ScriptDebugger::get_singleton();
+		if (debugger && debugger->get_lines_left() > 0 && debugger->get_depth() >= 0)
+			debugger->set_depth(debugger->get_depth() - 1);
 
 		if (_debug_call_stack_pos == 0) {
 
 			_debug_error = "Stack Underflow (Engine Bug)";
-			ScriptDebugger::get_singleton()->debug(this);
+			if (debugger) {
+				debugger->debug(this);
+			} else {
+				ERR_PRINTS(_debug_error);
+			}
 			return;
 		}
 
@@ -402,7 +473,7 @@ public:
 
 	virtual Vector<StackInfo> debug_get_current_stack_info() {
 		if (Thread::get_main_id() != Thread::get_caller_id())
-			return Vector<StackInfo>();
+			return _thread_get_current_stack_info();
 
 		Vector<StackInfo> csi;
 		csi.resize(_debug_call_stack_pos);
@@ -495,6 +566,21 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max);
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max);
 
+	// Sampling profiler, its samples are call stacks in the folded format of flame graph tools.
+	Error sampling_start(int p_interval_usec);
+	void sampling_stop();
+	bool is_sampling() const { return sampling; }
+	_FORCE_INLINE_ bool is_sample_pending() const { return sample_pending; }
+	void take_sample();
+	void sampling_get_samples(Map<String, uint64_t> *r_samples, bool p_clear);
+	Error sampling_save(const String &p_path);
+
+	uint8_t *alloc_yield_frame(uint32_t p_size);
+	void free_yield_frame(uint8_t *p_frame, uint32_t p_size);
+
+	void add_script_load_time(bool p_precompiled, uint64_t p_usec);
+	String get_script_load_stats() const;
+
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
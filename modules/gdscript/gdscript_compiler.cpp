@@ -74,6 +74,96 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+static bool _is_vector_operation(Variant::Operator p_op, Variant::Type p_vector, Variant::Type p_a, Variant::Type p_b) {
+
+	bool num_a = p_a == Variant::INT || p_a == Variant::REAL;
+	bool num_b = p_b == Variant::INT || p_b == Variant::REAL;
+
+	if (p_a == p_vector && p_b == p_vector) {
+		switch (p_op) {
+			case Variant::OP_ADD:
+			case Variant::OP_SUBTRACT:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_DIVIDE:
+			case Variant::OP_NEGATE:
+			case Variant::OP_POSITIVE:
+			case Variant::OP_EQUAL:
+			case Variant::OP_NOT_EQUAL: return true;
+			default: return false;
+		}
+	}
+	if (p_a == p_vector && num_b) {
+		return p_op == Variant::OP_MULTIPLY || p_op == Variant::OP_DIVIDE;
+	}
+	if (num_a && p_b == p_vector) {
+		return p_op == Variant::OP_MULTIPLY;
+	}
+	return false;
+}
+
+// Picks a type specialized opcode when the parser inferred the operand types. The VM checks
+// the types again and falls back to Variant::evaluate(), so this is only an optimization hint.
+static GDScriptFunction::Opcode _get_operator_opcode(Variant::Operator p_op, const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b) {
+
+	if (!p_a.has_type || !p_b.has_type || p_a.is_meta_type || p_b.is_meta_type)
+		return GDScriptFunction::OPCODE_OPERATOR;
+	if (p_a.kind != GDScriptParser::DataType::BUILTIN || p_b.kind != GDScriptParser::DataType::BUILTIN)
+		return GDScriptFunction::OPCODE_OPERATOR;
+
+	Variant::Type a = p_a.builtin_type;
+	Variant::Type b = p_b.builtin_type;
+
+	if (a == Variant::INT && b == Variant::INT) {
+		switch (p_op) {
+			case Variant::OP_EQUAL:
+			case Variant::OP_NOT_EQUAL:
+			case Variant::OP_LESS:
+			case Variant::OP_LESS_EQUAL:
+			case Variant::OP_GREATER:
+			case Variant::OP_GREATER_EQUAL:
+			case Variant::OP_ADD:
+			case Variant::OP_SUBTRACT:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_DIVIDE:
+			case Variant::OP_NEGATE:
+			case Variant::OP_POSITIVE:
+			case Variant::OP_MODULE:
+			case Variant::OP_SHIFT_LEFT:
+			case Variant::OP_SHIFT_RIGHT:
+			case Variant::OP_BIT_AND:
+			case Variant::OP_BIT_OR:
+			case Variant::OP_BIT_XOR:
+			case Variant::OP_BIT_NEGATE: return GDScriptFunction::OPCODE_OPERATOR_INT;
+			default: return GDScriptFunction::OPCODE_OPERATOR;
+		}
+	}
+
+	if ((a == Variant::INT || a == Variant::REAL) && (b == Variant::INT || b == Variant::REAL)) {
+		switch (p_op) {
+			case Variant::OP_EQUAL:
+			case Variant::OP_NOT_EQUAL:
+			case Variant::OP_LESS:
+			case Variant::OP_LESS_EQUAL:
+			case Variant::OP_GREATER:
+			case Variant::OP_GREATER_EQUAL:
+			case Variant::OP_ADD:
+			case Variant::OP_SUBTRACT:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_DIVIDE:
+			case Variant::OP_NEGATE:
+			case Variant::OP_POSITIVE: return GDScriptFunction::OPCODE_OPERATOR_REAL;
+			default: return GDScriptFunction::OPCODE_OPERATOR;
+		}
+	}
+
+	if (_is_vector_operation(p_op, Variant::VECTOR2, a, b))
+		return GDScriptFunction::OPCODE_OPERATOR_VECTOR2;
+	if (_is_vector_operation(p_op, Variant::VECTOR3, a, b))
+		return GDScriptFunction::OPCODE_OPERATOR_VECTOR3;
+
+	return GDScriptFunction::OPCODE_OPERATOR;
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -82,7 +172,8 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
 	if (src_address_a < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	GDScriptParser::DataType type_a = on->arguments[0]->get_datatype();
+	codegen.opcodes.push_back(_get_operator_opcode(op, type_a, type_a)); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_a); // argument 2 (repeated)
@@ -104,13 +195,72 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
 	if (src_address_b < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	codegen.opcodes.push_back(_get_operator_opcode(op, on->arguments[0]->get_datatype(), on->arguments[1]->get_datatype())); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
 	return true;
 }
 
+int GDScriptCompiler::_parse_jump_if_not(CodeGen &codegen, const GDScriptParser::Node *p_condition, int p_stack_level) {
+
+	if (p_condition->type == GDScriptParser::Node::TYPE_OPERATOR) {
+
+		// Fuse comparisons of ints and floats with the jump, so no temporary bool is needed.
+		const GDScriptParser::OperatorNode *on = static_cast<const GDScriptParser::OperatorNode *>(p_condition);
+		Variant::Operator op = Variant::OP_MAX;
+
+		switch (on->op) {
+			case GDScriptParser::OperatorNode::OP_EQUAL: op = Variant::OP_EQUAL; break;
+			case GDScriptParser::OperatorNode::OP_NOT_EQUAL: op = Variant::OP_NOT_EQUAL; break;
+			case GDScriptParser::OperatorNode::OP_LESS: op = Variant::OP_LESS; break;
+			case GDScriptParser::OperatorNode::OP_LESS_EQUAL: op = Variant::OP_LESS_EQUAL; break;
+			case GDScriptParser::OperatorNode::OP_GREATER: op = Variant::OP_GREATER; break;
+			case GDScriptParser::OperatorNode::OP_GREATER_EQUAL: op = Variant::OP_GREATER_EQUAL; break;
+			default: {
+			}
+		}
+
+		GDScriptFunction::Opcode opcode = GDScriptFunction::OPCODE_OPERATOR;
+		if (op != Variant::OP_MAX && on->arguments.size() == 2) {
+			opcode = _get_operator_opcode(op, on->arguments[0]->get_datatype(), on->arguments[1]->get_datatype());
+		}
+
+		if (opcode == GDScriptFunction::OPCODE_OPERATOR_INT || opcode == GDScriptFunction::OPCODE_OPERATOR_REAL) {
+
+			int slevel = p_stack_level;
+
+			int src_address_a = _parse_expression(codegen, on->arguments[0], slevel);
+			if (src_address_a < 0)
+				return -1;
+			if (src_address_a & GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS)
+				slevel++; //uses stack for return, increase stack
+
+			int src_address_b = _parse_expression(codegen, on->arguments[1], slevel);
+			if (src_address_b < 0)
+				return -1;
+
+			codegen.opcodes.push_back(opcode == GDScriptFunction::OPCODE_OPERATOR_INT ? GDScriptFunction::OPCODE_JUMP_IF_NOT_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL);
+			codegen.opcodes.push_back(op);
+			codegen.opcodes.push_back(src_address_a);
+			codegen.opcodes.push_back(src_address_b);
+			int jump_addr = codegen.opcodes.size();
+			codegen.opcodes.push_back(0); //temporary
+			return jump_addr;
+		}
+	}
+
+	int ret = _parse_expression(codegen, p_condition, p_stack_level, false);
+	if (ret < 0)
+		return -1;
+
+	codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+	codegen.opcodes.push_back(ret);
+	int jump_addr = codegen.opcodes.size();
+	codegen.opcodes.push_back(0); //temporary
+	return jump_addr;
+}
+
 GDScriptDataType GDScriptCompiler::_gdtype_from_datatype(const GDScriptParser::DataType &p_datatype) const {
 	if (!p_datatype.has_type) {
 		return GDScriptDataType();
@@ -656,10 +806,30 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							arguments.push_back(ret);
 						}
 
-						codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						// If the base is known to be a native class, resolve the bind now so the VM can call it directly.
+						MethodBind *method = NULL;
+						GDScriptParser::DataType base_type = instance->get_datatype();
+						if (base_type.has_type && base_type.kind == GDScriptParser::DataType::NATIVE && !base_type.is_meta_type) {
+							method = ClassDB::get_method(base_type.native_type, static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+							if (method && method->is_vararg()) {
+								method = NULL; // Keep the regular path, which has better error reporting for call() and friends.
+							}
+						}
+
+						if (method) {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL_METHOD_BIND : GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET);
+						} else {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						}
 						codegen.opcodes.push_back(on->arguments.size() - 2);
 						codegen.alloc_call(on->arguments.size() - 2);
-						for (int i = 0; i < arguments.size(); i++)
+						for (int i = 0; i < 2; i++)
+							codegen.opcodes.push_back(arguments[i]);
+						if (method)
+							codegen.opcodes.push_back(codegen.get_method_bind_pos(base_type.native_type, method));
+						else
+							codegen.opcodes.push_back(codegen.add_call_cache());
+						for (int i = 2; i < arguments.size(); i++)
 							codegen.opcodes.push_back(arguments[i]);
 					}
 				} break;
@@ -750,6 +920,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 					codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
 					codegen.opcodes.push_back(from); // argument 1
 					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+					if (named) {
+						codegen.opcodes.push_back(codegen.add_named_cache());
+					}
 
 				} break;
 				case GDScriptParser::OperatorNode::OP_AND: {
@@ -1052,6 +1225,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET);
 							codegen.opcodes.push_back(prev_pos);
 							codegen.opcodes.push_back(key_idx);
+							if (named) {
+								codegen.opcodes.push_back(codegen.add_named_cache());
+							}
 							slevel++;
 							codegen.alloc_stack(slevel);
 							int dst_pos = (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS) | slevel;
@@ -1061,6 +1237,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							//add in reverse order, since it will be reverted
 
 							setchain.push_back(dst_pos);
+							if (named) {
+								setchain.push_back(codegen.add_named_cache());
+							}
 							setchain.push_back(key_idx);
 							setchain.push_back(prev_pos);
 							setchain.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET);
@@ -1098,6 +1277,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET);
 						codegen.opcodes.push_back(prev_pos);
 						codegen.opcodes.push_back(set_index);
+						if (named) {
+							codegen.opcodes.push_back(codegen.add_named_cache());
+						}
 						codegen.opcodes.push_back(set_value);
 
 						for (int i = 0; i < setchain.size(); i++) {
@@ -1359,15 +1541,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 
 					case GDScriptParser::ControlFlowNode::CF_IF: {
 
-						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
-						if (ret2 < 0)
+						int else_addr = _parse_jump_if_not(codegen, cf->arguments[0], p_stack_level);
+						if (else_addr < 0)
 							return ERR_PARSE_ERROR;
 
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret2);
-						int else_addr = codegen.opcodes.size();
-						codegen.opcodes.push_back(0); //temporary
-
 						Error err = _parse_block(codegen, cf->body, p_stack_level, p_break_addr, p_continue_addr);
 						if (err)
 							return err;
@@ -1451,12 +1628,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 						codegen.opcodes.push_back(0);
 						int continue_addr = codegen.opcodes.size();
 
-						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
-						if (ret2 < 0)
+						int jump_addr = _parse_jump_if_not(codegen, cf->arguments[0], p_stack_level);
+						if (jump_addr < 0)
 							return ERR_PARSE_ERROR;
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret2);
-						codegen.opcodes.push_back(break_addr);
+						codegen.opcodes.write[jump_addr] = break_addr;
 						Error err = _parse_block(codegen, cf->body, p_stack_level, break_addr, continue_addr);
 						if (err)
 							return err;
@@ -1577,7 +1752,9 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	codegen.stack_max = 0;
 	codegen.current_line = 0;
 	codegen.call_max = 0;
-	codegen.debug_stack = ScriptDebugger::get_singleton() != NULL;
+	codegen.named_cache_count = 0;
+	codegen.call_cache_count = 0;
+	codegen.debug_stack = keep_debug_info || ScriptDebugger::get_singleton() != NULL;
 	Vector<StringName> argnames;
 
 	int stack_level = 0;
@@ -1694,15 +1871,24 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	gdfunc->arg_names = argnames;
 #endif
 	//constants
-	if (codegen.constant_map.size()) {
-		gdfunc->_constant_count = codegen.constant_map.size();
-		gdfunc->constants.resize(codegen.constant_map.size());
+	Vector<Variant> constants;
+	constants.resize(codegen.constant_map.size());
+	const Variant *K = NULL;
+	while ((K = codegen.constant_map.next(K))) {
+		int idx = codegen.constant_map[*K];
+		constants.write[idx] = *K;
+	}
+
+	//optimize the bytecode, lines are kept for the debugger
+	GDScriptOptimizer optimizer;
+	if (optimizer.optimize(codegen.opcodes, defarg_addr, constants, codegen.debug_stack)) {
+		optimizer_stats.add(optimizer.get_stats());
+	}
+
+	if (constants.size()) {
+		gdfunc->_constant_count = constants.size();
+		gdfunc->constants = constants;
 		gdfunc->_constants_ptr = gdfunc->constants.ptrw();
-		const Variant *K = NULL;
-		while ((K = codegen.constant_map.next(K))) {
-			int idx = codegen.constant_map[*K];
-			gdfunc->constants.write[idx] = *K;
-		}
 	} else {
 
 		gdfunc->_constants_ptr = NULL;
@@ -1724,6 +1910,50 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 		gdfunc->_global_names_count = 0;
 	}
 
+	//method binds
+	if (codegen.method_binds.size()) {
+
+		gdfunc->method_binds = codegen.method_binds;
+		gdfunc->_method_binds_ptr = gdfunc->method_binds.ptr();
+		gdfunc->_method_bind_count = gdfunc->method_binds.size();
+
+	} else {
+		gdfunc->_method_binds_ptr = NULL;
+		gdfunc->_method_bind_count = 0;
+	}
+
+	//inline caches of named gets and sets
+	if (codegen.named_cache_count) {
+
+		gdfunc->named_caches.resize(codegen.named_cache_count);
+		for (int i = 0; i < gdfunc->named_caches.size(); i++) {
+			gdfunc->named_caches.write[i].entry = NULL;
+			gdfunc->named_caches.write[i].resolves = 0;
+		}
+		gdfunc->_named_caches_ptr = gdfunc->named_caches.ptrw();
+		gdfunc->_named_cache_count = gdfunc->named_caches.size();
+
+	} else {
+		gdfunc->_named_caches_ptr = NULL;
+		gdfunc->_named_cache_count = 0;
+	}
+
+	//inline caches of method calls
+	if (codegen.call_cache_count) {
+
+		gdfunc->call_caches.resize(codegen.call_cache_count);
+		for (int i = 0; i < gdfunc->call_caches.size(); i++) {
+			gdfunc->call_caches.write[i].entry = NULL;
+			gdfunc->call_caches.write[i].resolves = 0;
+		}
+		gdfunc->_call_caches_ptr = gdfunc->call_caches.ptrw();
+		gdfunc->_call_cache_count = gdfunc->call_caches.size();
+
+	} else {
+		gdfunc->_call_caches_ptr = NULL;
+		gdfunc->_call_cache_count = 0;
+	}
+
 #ifdef TOOLS_ENABLED
 	// Named globals
 	if (codegen.named_globals.size()) {
@@ -1844,6 +2074,7 @@ Error GDScriptCompiler::_parse_class_level(GDScript *p_script, const GDScriptPar
 	}
 	p_script->member_functions.clear();
 	p_script->member_indices.clear();
+	p_script->member_layout = GDScript::_next_member_layout();
 	p_script->member_info.clear();
 	p_script->_signals.clear();
 	p_script->initializer = NULL;
@@ -2140,6 +2371,7 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	err_line = -1;
 	err_column = -1;
 	error = "";
+	optimizer_stats = GDScriptOptimizer::Stats();
 	parser = p_parser;
 	main_script = p_script;
 	const GDScriptParser::Node *root = parser->get_parse_tree();
@@ -2177,5 +2409,17 @@ int GDScriptCompiler::get_error_column() const {
 	return err_column;
 }
 
+const GDScriptOptimizer::Stats &GDScriptCompiler::get_optimizer_stats() const {
+
+	return optimizer_stats;
+}
+
+void GDScriptCompiler::set_keep_debug_info(bool p_enable) {
+
+	keep_debug_info = p_enable;
+}
+
 GDScriptCompiler::GDScriptCompiler() {
+
+	keep_debug_info = false;
 }
@@ -33,6 +33,7 @@
 
 #include "core/set.h"
 #include "gdscript.h"
+#include "gdscript_optimizer.h"
 #include "gdscript_parser.h"
 
 class GDScriptCompiler {
@@ -113,6 +114,31 @@ class GDScriptCompiler {
 			return ret;
 		}
 
+		Vector<GDScriptFunction::MethodBindCall> method_binds;
+
+		int get_method_bind_pos(const StringName &p_class, MethodBind *p_method) {
+			for (int i = 0; i < method_binds.size(); i++) {
+				if (method_binds[i].method == p_method && method_binds[i].class_name == p_class)
+					return i;
+			}
+			GDScriptFunction::MethodBindCall mbc;
+			mbc.class_name = p_class;
+			mbc.method = p_method;
+			method_binds.push_back(mbc);
+			return method_binds.size() - 1;
+		}
+
+		int named_cache_count;
+		int call_cache_count;
+
+		int add_named_cache() {
+			return named_cache_count++;
+		}
+
+		int add_call_cache() {
+			return call_cache_count++;
+		}
+
 		int get_constant_pos(const Variant &p_constant) {
 			if (constant_map.has(p_constant))
 				return constant_map[p_constant];
@@ -141,6 +167,7 @@ class GDScriptCompiler {
 
 	bool _create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level);
 	bool _create_binary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level, bool p_initializer = false);
+	int _parse_jump_if_not(CodeGen &codegen, const GDScriptParser::Node *p_condition, int p_stack_level);
 
 	GDScriptDataType _gdtype_from_datatype(const GDScriptParser::DataType &p_datatype) const;
 
@@ -155,6 +182,8 @@ class GDScriptCompiler {
 	int err_column;
 	StringName source;
 	String error;
+	GDScriptOptimizer::Stats optimizer_stats;
+	bool keep_debug_info;
 
 public:
 	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
@@ -162,6 +191,10 @@ public:
 	String get_error() const;
 	int get_error_line() const;
 	int get_error_column() const;
+	const GDScriptOptimizer::Stats &get_optimizer_stats() const;
+
+	// Keep line opcodes and stack debug info even when not running with the debugger (for exports).
+	void set_keep_debug_info(bool p_enable);
 
 	GDScriptCompiler();
 };
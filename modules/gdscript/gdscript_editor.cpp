@@ -218,6 +218,57 @@ Script *GDScriptLanguage::create_script() const {
 
 /* DEBUGGER FUNCTIONS */
 
+bool GDScriptLanguage::_thread_enter_function(GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line) {
+
+	ThreadCallStack &stack = thread_call_stack;
+	if (!stack.levels) {
+		stack.levels = memnew_arr(CallLevel, _debug_max_call_stack);
+	}
+
+	int pos = stack.pos++;
+	if (pos >= _debug_max_call_stack) {
+		// The debugger can only break on the main thread, so report a script error and let the caller fail the call.
+		String err_text = "Stack Overflow (Stack Size: " + itos(_debug_max_call_stack) + ") on a thread.";
+		_err_print_error(String(p_function->get_name()).utf8().get_data(), String(p_function->get_source()).utf8().get_data(), *p_line, err_text.utf8().get_data(), ERR_HANDLER_SCRIPT);
+		return false;
+	}
+
+	CallLevel &level = stack.levels[pos];
+	level.stack = p_stack;
+	level.instance = p_instance;
+	level.function = p_function;
+	level.ip = p_ip;
+	level.line = p_line;
+	return true;
+}
+
+void GDScriptLanguage::_thread_exit_function() {
+
+	ThreadCallStack &stack = thread_call_stack;
+	ERR_FAIL_COND_MSG(stack.pos == 0, "Stack Underflow (Engine Bug) on a thread.");
+	stack.pos--;
+}
+
+Vector<ScriptLanguage::StackInfo> GDScriptLanguage::_thread_get_current_stack_info() {
+
+	Vector<StackInfo> csi;
+
+	const ThreadCallStack &stack = thread_call_stack;
+	int size = MIN(stack.pos, _debug_max_call_stack);
+	csi.resize(size);
+	for (int i = 0; i < size; i++) {
+		const CallLevel &level = stack.levels[i];
+		StackInfo &si = csi.write[size - i - 1];
+		si.line = level.line ? *level.line : 0;
+		if (level.function) {
+			si.func = level.function->get_name();
+			si.file = level.function->get_source();
+		}
+	}
+
+	return csi;
+}
+
 bool GDScriptLanguage::debug_break_parse(const String &p_file, int p_line, const String &p_error) {
 	//break because of parse error
 
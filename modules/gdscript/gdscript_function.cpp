@@ -30,6 +30,7 @@
 
 #include "gdscript_function.h"
 
+#include "core/core_string_names.h"
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
@@ -189,10 +190,184 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 	return err_text;
 }
 
+#ifdef DEBUG_ENABLED
+static String _get_operator_error(Variant::Operator p_op, const Variant &p_a, const Variant &p_b, const Variant &p_ret) {
+
+	if (p_ret.get_type() == Variant::STRING) {
+		//return a string when invalid with the error
+		return String(p_ret) + " in operator '" + Variant::get_operator_name(p_op) + "'.";
+	}
+	return "Invalid operands '" + Variant::get_type_name(p_a.get_type()) + "' and '" + Variant::get_type_name(p_b.get_type()) + "' in operator '" + Variant::get_operator_name(p_op) + "'.";
+}
+#endif // DEBUG_ENABLED
+
+/* Fast paths for the typed operator opcodes. The compiler only emits them when the parser
+ * inferred the operand types, but typed locals can still be read before being assigned, so
+ * the types are checked here too. Each helper only accepts the type combinations (and values)
+ * for which it produces exactly what Variant::evaluate() would, and returns false otherwise
+ * so the VM falls back to the generic operator. */
+
+template <class T>
+static _FORCE_INLINE_ bool _compare_num(Variant::Operator p_op, T p_a, T p_b, bool &r_result) {
+
+	switch (p_op) {
+		case Variant::OP_EQUAL: r_result = p_a == p_b; return true;
+		case Variant::OP_NOT_EQUAL: r_result = p_a != p_b; return true;
+		case Variant::OP_LESS: r_result = p_a < p_b; return true;
+		case Variant::OP_LESS_EQUAL: r_result = p_a <= p_b; return true;
+		case Variant::OP_GREATER: r_result = p_a > p_b; return true;
+		case Variant::OP_GREATER_EQUAL: r_result = p_a >= p_b; return true;
+		default: return false;
+	}
+}
+
+static _FORCE_INLINE_ bool _is_int_operation(const Variant &p_a, const Variant &p_b) {
+
+	return p_a.get_type() == Variant::INT && p_b.get_type() == Variant::INT;
+}
+
+static _FORCE_INLINE_ bool _is_real_operation(const Variant &p_a, const Variant &p_b) {
+
+	// At least one side must be a float, int with int keeps integer semantics.
+	return (p_a.get_type() == Variant::REAL && (p_b.get_type() == Variant::REAL || p_b.get_type() == Variant::INT)) ||
+		   (p_a.get_type() == Variant::INT && p_b.get_type() == Variant::REAL);
+}
+
+static _FORCE_INLINE_ bool _evaluate_int(Variant::Operator p_op, const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+
+	if (unlikely(!_is_int_operation(p_a, p_b)))
+		return false;
+
+	int64_t a = p_a;
+	int64_t b = p_b;
+
+	switch (p_op) {
+		case Variant::OP_ADD: r_ret = a + b; return true;
+		case Variant::OP_SUBTRACT: r_ret = a - b; return true;
+		case Variant::OP_MULTIPLY: r_ret = a * b; return true;
+		case Variant::OP_DIVIDE: {
+			if (b == 0)
+				return false; // Let the generic path report it.
+			r_ret = a / b;
+			return true;
+		}
+		case Variant::OP_MODULE: {
+			if (b == 0)
+				return false;
+			r_ret = a % b;
+			return true;
+		}
+		case Variant::OP_NEGATE: r_ret = -a; return true;
+		case Variant::OP_POSITIVE: r_ret = a; return true;
+		case Variant::OP_SHIFT_LEFT: {
+			if (b < 0 || b >= 64)
+				return false;
+			r_ret = a << b;
+			return true;
+		}
+		case Variant::OP_SHIFT_RIGHT: {
+			if (b < 0 || b >= 64)
+				return false;
+			r_ret = a >> b;
+			return true;
+		}
+		case Variant::OP_BIT_AND: r_ret = a & b; return true;
+		case Variant::OP_BIT_OR: r_ret = a | b; return true;
+		case Variant::OP_BIT_XOR: r_ret = a ^ b; return true;
+		case Variant::OP_BIT_NEGATE: r_ret = ~a; return true;
+		default: {
+			bool result;
+			if (!_compare_num<int64_t>(p_op, a, b, result))
+				return false;
+			r_ret = result;
+			return true;
+		}
+	}
+}
+
+static _FORCE_INLINE_ bool _evaluate_real(Variant::Operator p_op, const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+
+	if (unlikely(!_is_real_operation(p_a, p_b)))
+		return false;
+
+	double a = p_a;
+	double b = p_b;
+
+	switch (p_op) {
+		case Variant::OP_ADD: r_ret = a + b; return true;
+		case Variant::OP_SUBTRACT: r_ret = a - b; return true;
+		case Variant::OP_MULTIPLY: r_ret = a * b; return true;
+		case Variant::OP_DIVIDE: {
+			if (b == 0)
+				return false; // Let the generic path report it.
+			r_ret = a / b;
+			return true;
+		}
+		case Variant::OP_NEGATE: r_ret = -a; return true;
+		case Variant::OP_POSITIVE: r_ret = a; return true;
+		default: {
+			bool result;
+			if (!_compare_num<double>(p_op, a, b, result))
+				return false;
+			r_ret = result;
+			return true;
+		}
+	}
+}
+
+template <class T, Variant::Type V>
+static _FORCE_INLINE_ bool _evaluate_vector(Variant::Operator p_op, const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+
+	Variant::Type type_a = p_a.get_type();
+	Variant::Type type_b = p_b.get_type();
+
+	if (type_a == V && type_b == V) {
+		T a = p_a;
+		T b = p_b;
+		switch (p_op) {
+			case Variant::OP_ADD: r_ret = a + b; return true;
+			case Variant::OP_SUBTRACT: r_ret = a - b; return true;
+			case Variant::OP_MULTIPLY: r_ret = a * b; return true;
+			case Variant::OP_DIVIDE: r_ret = a / b; return true;
+			case Variant::OP_NEGATE: r_ret = -a; return true;
+			case Variant::OP_POSITIVE: r_ret = a; return true;
+			case Variant::OP_EQUAL: r_ret = a == b; return true;
+			case Variant::OP_NOT_EQUAL: r_ret = a != b; return true;
+			default: return false;
+		}
+	}
+
+	bool num_a = type_a == Variant::INT || type_a == Variant::REAL;
+	bool num_b = type_b == Variant::INT || type_b == Variant::REAL;
+
+	if (type_a == V && num_b) {
+		T a = p_a;
+		real_t b = p_b;
+		switch (p_op) {
+			case Variant::OP_MULTIPLY: r_ret = a * b; return true;
+			case Variant::OP_DIVIDE: r_ret = a / b; return true;
+			default: return false;
+		}
+	}
+
+	if (num_a && type_b == V && p_op == Variant::OP_MULTIPLY) {
+		real_t a = p_a;
+		T b = p_b;
+		r_ret = b * a;
+		return true;
+	}
+
+	return false;
+}
+
 #if defined(__GNUC__)
 #define OPCODES_TABLE                         \
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR,                    \
+		&&OPCODE_OPERATOR_INT,                \
+		&&OPCODE_OPERATOR_REAL,               \
+		&&OPCODE_OPERATOR_VECTOR2,            \
+		&&OPCODE_OPERATOR_VECTOR3,            \
 		&&OPCODE_EXTENDS_TEST,                \
 		&&OPCODE_IS_BUILTIN,                  \
 		&&OPCODE_SET,                         \
@@ -215,6 +390,8 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 		&&OPCODE_CONSTRUCT_DICTIONARY,        \
 		&&OPCODE_CALL,                        \
 		&&OPCODE_CALL_RETURN,                 \
+		&&OPCODE_CALL_METHOD_BIND,            \
+		&&OPCODE_CALL_METHOD_BIND_RET,        \
 		&&OPCODE_CALL_BUILT_IN,               \
 		&&OPCODE_CALL_SELF,                   \
 		&&OPCODE_CALL_SELF_BASE,              \
@@ -224,6 +401,8 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 		&&OPCODE_JUMP,                        \
 		&&OPCODE_JUMP_IF,                     \
 		&&OPCODE_JUMP_IF_NOT,                 \
+		&&OPCODE_JUMP_IF_NOT_INT,             \
+		&&OPCODE_JUMP_IF_NOT_REAL,            \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,        \
 		&&OPCODE_RETURN,                      \
 		&&OPCODE_ITERATE_BEGIN,               \
@@ -257,6 +436,303 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 #define OPCODE_OUT break
 #endif
 
+static _FORCE_INLINE_ Object *_get_cache_receiver(const Variant &p_base) {
+
+	if (p_base.get_type() != Variant::OBJECT) {
+		return NULL;
+	}
+
+	Object *obj = p_base;
+#ifdef DEBUG_ENABLED
+	if (obj && ScriptDebugger::get_singleton() && !p_base.is_ref() && !ObjectDB::instance_validate(obj)) {
+		return NULL; //let the regular path report the stray pointer
+	}
+#endif
+	return obj;
+}
+
+template <class C, class E>
+static const E *_publish_cache_entry(C &p_cache, const E &p_entry, List<E *> &r_entries, Mutex *p_lock) {
+
+	E *entry = memnew(E(p_entry));
+
+	if (p_lock) {
+		p_lock->lock();
+	}
+
+	r_entries.push_back(entry);
+	// Also a full barrier, so the entry is complete before other threads can see it.
+	atomic_increment(&p_cache.resolves);
+	p_cache.entry = entry;
+
+	if (p_lock) {
+		p_lock->unlock();
+	}
+
+	return entry;
+}
+
+bool GDScriptFunction::_get_cache_key(Object *p_object, GDScriptInstance *&r_instance, uint32_t &r_layout) {
+
+	ScriptInstance *si = p_object->get_script_instance();
+	if (!si) {
+		r_instance = NULL;
+		r_layout = 0;
+		return true;
+	}
+
+	if (si->get_language() != GDScriptLanguage::get_singleton() || si->is_placeholder()) {
+		return false;
+	}
+
+	r_instance = static_cast<GDScriptInstance *>(si);
+	r_layout = r_instance->script->member_layout;
+	return true;
+}
+
+const GDScriptFunction::NamedCacheEntry *GDScriptFunction::_resolve_named_cache(NamedCache &p_cache, Object *p_object, GDScriptInstance *p_instance, uint32_t p_layout, const StringName &p_name, bool p_set) {
+
+	if (p_cache.resolves >= CACHE_MAX_RESOLVES) {
+		return NULL; //megamorphic site, keep using the generic path
+	}
+
+	NamedCacheEntry e;
+	e.layout = p_layout;
+	e.member = -1;
+	e.member_type = Variant::NIL;
+	e.method = NULL;
+	e.property_index = -1;
+
+	if (p_instance) {
+
+		const GDScript *script = p_instance->script.ptr();
+		const Map<StringName, GDScript::MemberInfo>::Element *E = script->member_indices.find(p_name);
+		if (E) {
+			const GDScript::MemberInfo &member = E->get();
+			if (p_set ? member.setter != StringName() : member.getter != StringName()) {
+				return NULL;
+			}
+			if (p_set && member.data_type.has_type) {
+				if (member.data_type.kind != GDScriptDataType::BUILTIN) {
+					return NULL;
+				}
+				e.member_type = member.data_type.builtin_type;
+			}
+			e.member = member.index;
+		} else {
+			// Not a member, but constants, _get() or _set() can still claim the name.
+			const StringName &hook = p_set ? GDScriptLanguage::get_singleton()->strings._set : GDScriptLanguage::get_singleton()->strings._get;
+			for (const GDScript *s = script; s; s = s->_base) {
+				if ((!p_set && s->constants.has(p_name)) || s->member_functions.has(hook)) {
+					return NULL;
+				}
+			}
+		}
+	}
+
+	if (e.member < 0) {
+
+		StringName cls = p_object->get_class_name();
+		const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(cls, p_name);
+		if (!psg) {
+			return NULL;
+		}
+
+		if (p_set) {
+			e.method = psg->_setptr;
+		} else {
+			bool is_constant = false;
+			ClassDB::get_integer_constant(cls, p_name, &is_constant);
+			if (is_constant) {
+				return NULL;
+			}
+
+			if (psg->index < 0) {
+				e.method = psg->_getptr;
+			} else if (!p_instance) {
+				// Indexed getters are called by name, which a script could override.
+				e.method = ClassDB::get_method(cls, psg->getter);
+			}
+		}
+
+		if (!e.method) {
+			return NULL;
+		}
+
+		e.native_class = cls;
+		e.property_index = psg->index;
+	}
+
+	return _publish_cache_entry(p_cache, e, named_cache_entries, GDScriptLanguage::get_singleton()->lock);
+}
+
+bool GDScriptFunction::_get_named_cached(NamedCache &p_cache, Object *p_object, const StringName &p_name, Variant &r_ret) {
+
+	GDScriptInstance *instance;
+	uint32_t layout;
+	if (!_get_cache_key(p_object, instance, layout)) {
+		return false;
+	}
+
+	const NamedCacheEntry *entry = p_cache.entry;
+	if (!entry || entry->layout != layout || (entry->member < 0 && entry->native_class != p_object->get_class_name())) {
+#ifdef DEBUG_ENABLED
+		if (GDScriptLanguage::get_singleton()->profiling) {
+			profile.named_cache_misses++;
+		}
+#endif
+		entry = _resolve_named_cache(p_cache, p_object, instance, layout, p_name, false);
+		if (!entry) {
+			return false;
+		}
+	}
+#ifdef DEBUG_ENABLED
+	else if (GDScriptLanguage::get_singleton()->profiling) {
+		profile.named_cache_hits++;
+	}
+#endif
+
+	if (entry->member >= 0) {
+		ERR_FAIL_INDEX_V(entry->member, instance->members.size(), false);
+		r_ret = instance->members[entry->member];
+		return true;
+	}
+
+	Variant::CallError ce;
+	if (entry->property_index >= 0) {
+		Variant index = entry->property_index;
+		const Variant *arg[1] = { &index };
+		r_ret = entry->method->call(p_object, arg, 1, ce);
+	} else {
+		r_ret = entry->method->call(p_object, NULL, 0, ce);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_set_named_cached(NamedCache &p_cache, Object *p_object, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+
+	GDScriptInstance *instance;
+	uint32_t layout;
+	if (!_get_cache_key(p_object, instance, layout)) {
+		return false;
+	}
+
+	const NamedCacheEntry *entry = p_cache.entry;
+	if (!entry || entry->layout != layout || (entry->member < 0 && entry->native_class != p_object->get_class_name())) {
+#ifdef DEBUG_ENABLED
+		if (GDScriptLanguage::get_singleton()->profiling) {
+			profile.named_cache_misses++;
+		}
+#endif
+		entry = _resolve_named_cache(p_cache, p_object, instance, layout, p_name, true);
+		if (!entry) {
+			return false;
+		}
+	}
+#ifdef DEBUG_ENABLED
+	else if (GDScriptLanguage::get_singleton()->profiling) {
+		profile.named_cache_hits++;
+	}
+#endif
+
+	if (entry->member >= 0) {
+		if (entry->member_type != Variant::NIL && entry->member_type != p_value.get_type()) {
+			return false; //needs a conversion, which the generic path does
+		}
+		ERR_FAIL_INDEX_V(entry->member, instance->members.size(), false);
+		p_object->_mark_edited();
+		instance->members.write[entry->member] = p_value;
+		r_valid = true;
+		return true;
+	}
+
+	p_object->_mark_edited();
+
+	Variant::CallError ce;
+	if (entry->property_index >= 0) {
+		Variant index = entry->property_index;
+		const Variant *arg[2] = { &index, &p_value };
+		entry->method->call(p_object, arg, 2, ce);
+	} else {
+		const Variant *arg[1] = { &p_value };
+		entry->method->call(p_object, arg, 1, ce);
+	}
+	r_valid = ce.error == Variant::CallError::CALL_OK;
+	return true;
+}
+
+const GDScriptFunction::CallCacheEntry *GDScriptFunction::_resolve_call_cache(CallCache &p_cache, Object *p_object, GDScriptInstance *p_instance, uint32_t p_layout, const StringName &p_method) {
+
+	if (p_cache.resolves >= CACHE_MAX_RESOLVES) {
+		return NULL;
+	}
+
+	if (p_method == CoreStringNames::get_singleton()->_free) {
+		return NULL; //handled by Object::call itself
+	}
+
+	CallCacheEntry e;
+	e.layout = p_layout;
+	e.function = NULL;
+	e.function_script = NULL;
+	e.function_layout = 0;
+	e.method = NULL;
+
+	if (p_instance) {
+		for (GDScript *s = p_instance->script.ptr(); s; s = s->_base) {
+			Map<StringName, GDScriptFunction *>::Element *E = s->member_functions.find(p_method);
+			if (E) {
+				e.function = E->get();
+				e.function_script = s;
+				e.function_layout = s->member_layout;
+				break;
+			}
+		}
+	}
+
+	if (!e.function) {
+
+		if (Object::cast_to<Script>(p_object)) {
+			return NULL; //scripts dispatch their own static functions in call()
+		}
+
+		e.native_class = p_object->get_class_name();
+		e.method = ClassDB::get_method(e.native_class, p_method);
+		if (!e.method) {
+			return NULL;
+		}
+	}
+
+	return _publish_cache_entry(p_cache, e, call_cache_entries, GDScriptLanguage::get_singleton()->lock);
+}
+
+const GDScriptFunction::CallCacheEntry *GDScriptFunction::_get_call_cached(CallCache &p_cache, Object *p_object, const StringName &p_method) {
+
+	GDScriptInstance *instance;
+	uint32_t layout;
+	if (!_get_cache_key(p_object, instance, layout)) {
+		return NULL;
+	}
+
+	// The receiver's layout is checked first, it keeps the script of a cached function alive.
+	const CallCacheEntry *entry = p_cache.entry;
+	if (!entry || entry->layout != layout || (entry->function ? entry->function_script->member_layout != entry->function_layout : entry->native_class != p_object->get_class_name())) {
+#ifdef DEBUG_ENABLED
+		if (GDScriptLanguage::get_singleton()->profiling) {
+			profile.call_cache_misses++;
+		}
+#endif
+		return _resolve_call_cache(p_cache, p_object, instance, layout, p_method);
+	}
+
+#ifdef DEBUG_ENABLED
+	if (GDScriptLanguage::get_singleton()->profiling) {
+		profile.call_cache_hits++;
+	}
+#endif
+	return entry;
+}
+
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Variant::CallError &r_err, CallState *p_state) {
 
 	OPCODES_TABLE;
@@ -287,11 +763,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (yielded)
-		stack = (Variant *)p_state->stack.ptr();
-		call_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		call_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script.ptr();
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -389,8 +865,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #ifdef DEBUG_ENABLED
 
-	if (ScriptDebugger::get_singleton())
-		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
+	if (GDScriptLanguage::get_singleton()->is_tracking_calls() && !GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line)) {
+		// Jump straight to the final OPCODE_END, so the call returns null and still exits the call stack.
+		ip = _code_size - 1;
+	}
 
 #define GD_ERR_BREAK(m_cond)                                                                                           \
 	{                                                                                                                  \
@@ -430,8 +908,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		profile.frame_call_count++;
 	}
 	bool exit_ok = false;
-	bool yielded = false;
 #endif
+	bool yielded = false;
+	bool debug_lines = ScriptDebugger::get_singleton() && Thread::get_caller_id() == Thread::get_main_id();
+	bool sample_lines = GDScriptLanguage::get_singleton()->is_tracking_calls() && Thread::get_caller_id() == Thread::get_main_id();
 
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
@@ -442,6 +922,64 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 		OPCODE_SWITCH(_code_ptr[ip]) {
 
+			// The typed operators fall through to the next one when the operands aren't of the
+			// expected types, ending in the generic OPCODE_OPERATOR.
+			OPCODE(OPCODE_OPERATOR_INT) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (likely(_evaluate_int((Variant::Operator)_code_ptr[ip + 1], *a, *b, *dst))) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+			}
+
+			OPCODE(OPCODE_OPERATOR_REAL) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (likely(_evaluate_real((Variant::Operator)_code_ptr[ip + 1], *a, *b, *dst))) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+			}
+
+			OPCODE(OPCODE_OPERATOR_VECTOR2) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (likely((_evaluate_vector<Vector2, Variant::VECTOR2>((Variant::Operator)_code_ptr[ip + 1], *a, *b, *dst)))) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+			}
+
+			OPCODE(OPCODE_OPERATOR_VECTOR3) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (likely((_evaluate_vector<Vector3, Variant::VECTOR3>((Variant::Operator)_code_ptr[ip + 1], *a, *b, *dst)))) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+			}
+
 			OPCODE(OPCODE_OPERATOR) {
 
 				CHECK_SPACE(5);
@@ -464,13 +1002,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 
-					if (ret.get_type() == Variant::STRING) {
-						//return a string when invalid with the error
-						err_text = ret;
-						err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
-					} else {
-						err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
-					}
+					err_text = _get_operator_error(op, *a, *b, ret);
 					OPCODE_BREAK;
 				}
 				*dst = ret;
@@ -619,18 +1151,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 			OPCODE(OPCODE_SET_NAMED) {
 
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 1);
-				GET_VARIANT_PTR(value, 3);
+				GET_VARIANT_PTR(value, 4);
 
 				int indexname = _code_ptr[ip + 2];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cachepos = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cachepos < 0 || cachepos >= _named_cache_count);
+
 				bool valid;
-				dst->set_named(*index, *value, &valid);
+				Object *obj = _get_cache_receiver(*dst);
+				if (!obj || !_set_named_cached(_named_caches_ptr[cachepos], obj, *index, *value, valid)) {
+					dst->set_named(*index, *value, &valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -639,22 +1177,41 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
 
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 1);
-				GET_VARIANT_PTR(dst, 3);
+				GET_VARIANT_PTR(dst, 4);
 
 				int indexname = _code_ptr[ip + 2];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cachepos = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cachepos < 0 || cachepos >= _named_cache_count);
+
+				bool cached = false;
+				Object *obj = _get_cache_receiver(*src);
+				if (obj) {
+					// Through a copy, dst may hold the last reference to the object being read.
+					Variant cached_value;
+					cached = _get_named_cached(_named_caches_ptr[cachepos], obj, *index, cached_value);
+					if (cached) {
+						*dst = cached_value;
+					}
+				}
+
+				if (likely(cached)) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -674,7 +1231,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1041,10 +1598,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_CALL_RETURN)
-			OPCODE(OPCODE_CALL) {
+			OPCODE(OPCODE_CALL)
+			OPCODE(OPCODE_CALL_METHOD_BIND_RET)
+			OPCODE(OPCODE_CALL_METHOD_BIND) {
 
 				CHECK_SPACE(4);
-				bool call_ret = _code_ptr[ip] == OPCODE_CALL_RETURN;
+				int call_op = _code_ptr[ip];
+				bool call_ret = call_op == OPCODE_CALL_RETURN || call_op == OPCODE_CALL_METHOD_BIND_RET;
 
 				int argc = _code_ptr[ip + 1];
 				GET_VARIANT_PTR(base, 2);
@@ -1055,6 +1615,49 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GD_ERR_BREAK(argc < 0);
 				ip += 4;
+
+				MethodBind *method = NULL;
+				GDScriptFunction *function = NULL;
+				if (call_op == OPCODE_CALL_METHOD_BIND || call_op == OPCODE_CALL_METHOD_BIND_RET) {
+
+					CHECK_SPACE(1);
+					int bindg = _code_ptr[ip];
+					GD_ERR_BREAK(bindg < 0 || bindg >= _method_bind_count);
+					ip += 1;
+
+					// The compiler knew the native type of the base, so skip Variant and Object dispatch
+					// and call the bind directly, unless a script may be overriding the method.
+					Object *obj = base->get_type() == Variant::OBJECT ? base->operator Object *() : NULL;
+#ifdef DEBUG_ENABLED
+					if (obj && ScriptDebugger::get_singleton() && !base->is_ref() && !ObjectDB::instance_validate(obj)) {
+						obj = NULL; //let the regular call report it
+					}
+#endif
+					if (obj && !obj->get_script_instance()) {
+						const MethodBindCall &mbc = _method_binds_ptr[bindg];
+						if (obj->get_class_name() == mbc.class_name) {
+							method = mbc.method;
+						} else {
+							method = ClassDB::get_method(obj->get_class_name(), *methodname);
+						}
+					}
+				} else {
+
+					CHECK_SPACE(1);
+					int cachepos = _code_ptr[ip];
+					GD_ERR_BREAK(cachepos < 0 || cachepos >= _call_cache_count);
+					ip += 1;
+
+					Object *obj = _get_cache_receiver(*base);
+					if (obj) {
+						const CallCacheEntry *entry = _get_call_cached(_call_caches_ptr[cachepos], obj, *methodname);
+						if (entry) {
+							function = entry->function;
+							method = entry->method;
+						}
+					}
+				}
+
 				CHECK_SPACE(argc + 1);
 				Variant **argptrs = call_args;
 
@@ -1072,7 +1675,25 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #endif
 				Variant::CallError err;
-				if (call_ret) {
+				if (function || method) {
+
+					Object *obj = base->operator Object *();
+					Variant ret_value;
+					if (function) {
+						// Same as Object::call() on the instance, minus the lookups.
+#ifdef DEBUG_ENABLED
+						_ObjectDebugLock debug_lock(obj);
+#endif
+						err.error = Variant::CallError::CALL_OK;
+						ret_value = function->call(static_cast<GDScriptInstance *>(obj->get_script_instance()), (const Variant **)argptrs, argc, err);
+					} else {
+						ret_value = obj->call_method_bind(method, (const Variant **)argptrs, argc, err);
+					}
+					if (call_ret && err.error == Variant::CallError::CALL_OK) {
+						GET_VARIANT_PTR(ret, argc);
+						*ret = ret_value;
+					}
+				} else if (call_ret) {
 
 					GET_VARIANT_PTR(ret, argc);
 					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
@@ -1256,12 +1877,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 				gdfs->function = this;
 
-				gdfs->state.stack.resize(alloca_size);
-				//copy variant stack
-				for (int i = 0; i < _stack_size; i++) {
-					memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-				}
-				gdfs->state.stack_size = _stack_size;
 				gdfs->state.self = self;
 				gdfs->state.alloca_size = alloca_size;
 				gdfs->state.script = Ref<GDScript>(_script);
@@ -1321,9 +1936,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				}
 
+				// Hand the stack over to the state instead of copying it. Variants don't point to
+				// themselves, so they can be moved bitwise, and this call won't destroy them on exit.
+				if (p_state) {
+					gdfs->state.stack = p_state->stack;
+					p_state->stack = NULL;
+					p_state->stack_size = 0;
+				} else {
+					gdfs->state.stack = GDScriptLanguage::get_singleton()->alloc_yield_frame(alloca_size);
+					if (_stack_size) {
+						memcpy((void *)gdfs->state.stack, (const void *)stack, sizeof(Variant) * _stack_size);
+					}
+				}
+				gdfs->state.stack_size = _stack_size;
+				yielded = true;
+
 #ifdef DEBUG_ENABLED
 				exit_ok = true;
-				yielded = true;
 #endif
 				OPCODE_BREAK;
 			}
@@ -1389,6 +2018,63 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// Comparison fused with a conditional jump, falls through to the float version
+			// (which also handles the generic case) when the operands aren't both ints.
+			OPCODE(OPCODE_JUMP_IF_NOT_INT) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+
+				bool result;
+				if (likely(_is_int_operation(*a, *b) && _compare_num<int64_t>((Variant::Operator)_code_ptr[ip + 1], *a, *b, result))) {
+					if (!result) {
+						int to = _code_ptr[ip + 4];
+						GD_ERR_BREAK(to < 0 || to > _code_size);
+						ip = to;
+					} else {
+						ip += 5;
+					}
+					DISPATCH_OPCODE;
+				}
+			}
+
+			OPCODE(OPCODE_JUMP_IF_NOT_REAL) {
+
+				CHECK_SPACE(5);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+				GD_ERR_BREAK(op >= Variant::OP_MAX);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+
+				bool result;
+				if (unlikely(!_is_real_operation(*a, *b) || !_compare_num<double>(op, *a, *b, result))) {
+					bool valid;
+					Variant ret;
+					Variant::evaluate(op, *a, *b, ret, valid);
+#ifdef DEBUG_ENABLED
+					if (!valid) {
+
+						err_text = _get_operator_error(op, *a, *b, ret);
+						OPCODE_BREAK;
+					}
+#endif
+					result = ret.booleanize();
+				}
+
+				if (!result) {
+					int to = _code_ptr[ip + 4];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 5;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 
 				CHECK_SPACE(2);
@@ -1509,10 +2195,16 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+				// Taken before the line changes, so the time is counted for the line that was running.
+				if (unlikely(sample_lines && GDScriptLanguage::get_singleton()->is_sample_pending())) {
+					GDScriptLanguage::get_singleton()->take_sample();
+				}
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
-				if (ScriptDebugger::get_singleton()) {
+				// Stepping and polling the debugger are only done for the main thread.
+				if (debug_lines) {
 					// line
 					bool do_break = false;
 
@@ -1600,11 +2292,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	// When it's the last resume it will postpone the exit from stack,
 	// so the debugger knows which function triggered the resume of the next function (if any)
 	if (!p_state || yielded) {
-		if (ScriptDebugger::get_singleton())
+		if (GDScriptLanguage::get_singleton()->is_tracking_calls())
 			GDScriptLanguage::get_singleton()->exit_function();
 #endif
 
-		if (_stack_size) {
+		if (_stack_size && !yielded) {
 			//free stack
 			for (int i = 0; i < _stack_size; i++)
 				stack[i].~Variant();
@@ -1638,6 +2330,12 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+GDScriptFunction::MethodBindCall GDScriptFunction::get_method_bind(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, method_binds.size(), MethodBindCall());
+	return method_binds[p_idx];
+}
+
 int GDScriptFunction::get_default_argument_count() const {
 
 	return _default_arg_count;
@@ -1742,6 +2440,12 @@ GDScriptFunction::GDScriptFunction() :
 
 	_stack_size = 0;
 	_call_size = 0;
+	_method_binds_ptr = NULL;
+	_method_bind_count = 0;
+	_named_caches_ptr = NULL;
+	_named_cache_count = 0;
+	_call_caches_ptr = NULL;
+	_call_cache_count = 0;
 	rpc_mode = MultiplayerAPI::RPC_MODE_DISABLED;
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -1765,11 +2469,23 @@ GDScriptFunction::GDScriptFunction() :
 	profile.last_frame_call_count = 0;
 	profile.last_frame_self_time = 0;
 	profile.last_frame_total_time = 0;
+	profile.named_cache_hits = 0;
+	profile.named_cache_misses = 0;
+	profile.call_cache_hits = 0;
+	profile.call_cache_misses = 0;
 
 #endif
 }
 
 GDScriptFunction::~GDScriptFunction() {
+
+	for (List<NamedCacheEntry *>::Element *E = named_cache_entries.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+	for (List<CallCacheEntry *>::Element *E = call_cache_entries.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->lock) {
 		GDScriptLanguage::get_singleton()->lock->lock();
@@ -1869,17 +2585,22 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		}
 
 #ifdef DEBUG_ENABLED
-		if (ScriptDebugger::get_singleton())
+		if (GDScriptLanguage::get_singleton()->is_tracking_calls())
 			GDScriptLanguage::get_singleton()->exit_function();
 		if (state.stack_size) {
 			//free stack
-			Variant *stack = (Variant *)state.stack.ptr();
+			Variant *stack = (Variant *)state.stack;
 			for (int i = 0; i < state.stack_size; i++)
 				stack[i].~Variant();
 		}
 #endif
 	}
 
+	// Unless a new yield took the frame over, it can be used by the next one.
+	GDScriptLanguage::get_singleton()->free_yield_frame(state.stack, state.alloca_size);
+	state.stack = NULL;
+	state.stack_size = 0;
+
 	return ret;
 }
 
@@ -1895,6 +2616,9 @@ void GDScriptFunctionState::_bind_methods() {
 GDScriptFunctionState::GDScriptFunctionState() {
 
 	function = NULL;
+	state.stack = NULL;
+	state.stack_size = 0;
+	state.alloca_size = 0;
 }
 
 GDScriptFunctionState::~GDScriptFunctionState() {
@@ -1906,4 +2630,12 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 			v->~Variant();
 		}
 	}
+
+	if (state.stack) {
+		if (GDScriptLanguage::get_singleton()) {
+			GDScriptLanguage::get_singleton()->free_yield_frame(state.stack, state.alloca_size);
+		} else {
+			memfree(state.stack);
+		}
+	}
 }
@@ -148,6 +148,10 @@ class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
+		OPCODE_OPERATOR_INT,
+		OPCODE_OPERATOR_REAL,
+		OPCODE_OPERATOR_VECTOR2,
+		OPCODE_OPERATOR_VECTOR3,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET,
@@ -170,6 +174,8 @@ public:
 		OPCODE_CONSTRUCT_DICTIONARY,
 		OPCODE_CALL,
 		OPCODE_CALL_RETURN,
+		OPCODE_CALL_METHOD_BIND,
+		OPCODE_CALL_METHOD_BIND_RET,
 		OPCODE_CALL_BUILT_IN,
 		OPCODE_CALL_SELF,
 		OPCODE_CALL_SELF_BASE,
@@ -179,6 +185,8 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_NOT_INT,
+		OPCODE_JUMP_IF_NOT_REAL,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_RETURN,
 		OPCODE_ITERATE_BEGIN,
@@ -213,8 +221,57 @@ public:
 		StringName identifier;
 	};
 
+	struct MethodBindCall {
+
+		StringName class_name; //static type of the base, as known by the compiler
+		MethodBind *method; //resolved for class_name, used directly when the receiver is exactly of that class
+	};
+
 private:
 	friend class GDScriptCompiler;
+	friend class GDScriptSerializer;
+
+	enum {
+		CACHE_MAX_RESOLVES = 4 // a site that keeps seeing new kinds of receivers stops caching
+	};
+
+	// How the name of a GET_NAMED/SET_NAMED site resolved for a kind of receiver: the layout of its
+	// script members (0 if it has no script) and, for native properties, its class. Entries are never
+	// modified once published, so threads running the same function can only miss the cache.
+	struct NamedCacheEntry {
+
+		uint32_t layout;
+		StringName native_class;
+		int member; //script member index, -1 for native properties
+		Variant::Type member_type; //NIL if any value can be assigned to the member directly
+		MethodBind *method; //setter or getter of the native property
+		int property_index;
+	};
+
+	struct NamedCache {
+
+		NamedCacheEntry *volatile entry;
+		uint32_t resolves;
+	};
+
+	// How the method of a CALL/CALL_RETURN site resolved for a kind of receiver, keyed like the named
+	// caches. A script function also remembers the layout its script had, as that script may be a base
+	// of the receiver's one and get recompiled on its own, deleting the function.
+	struct CallCacheEntry {
+
+		uint32_t layout;
+		StringName native_class;
+		GDScriptFunction *function; //NULL for native methods
+		GDScript *function_script;
+		uint32_t function_layout;
+		MethodBind *method;
+	};
+
+	struct CallCache {
+
+		CallCacheEntry *volatile entry;
+		uint32_t resolves;
+	};
 
 	StringName source;
 
@@ -227,6 +284,12 @@ private:
 	const StringName *_named_globals_ptr;
 	int _named_globals_count;
 #endif
+	const MethodBindCall *_method_binds_ptr;
+	int _method_bind_count;
+	NamedCache *_named_caches_ptr;
+	int _named_cache_count;
+	CallCache *_call_caches_ptr;
+	int _call_cache_count;
 	const int *_default_arg_ptr;
 	int _default_arg_count;
 	const int *_code_ptr;
@@ -246,6 +309,11 @@ private:
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
 #endif
+	Vector<MethodBindCall> method_binds;
+	Vector<NamedCache> named_caches;
+	List<NamedCacheEntry *> named_cache_entries;
+	Vector<CallCache> call_caches;
+	List<CallCacheEntry *> call_cache_entries;
 	Vector<int> default_arguments;
 	Vector<int> code;
 	Vector<GDScriptDataType> argument_types;
@@ -260,6 +328,13 @@ private:
 	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const;
 	_FORCE_INLINE_ String _get_call_error(const Variant::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
+	_FORCE_INLINE_ static bool _get_cache_key(Object *p_object, GDScriptInstance *&r_instance, uint32_t &r_layout);
+	const NamedCacheEntry *_resolve_named_cache(NamedCache &p_cache, Object *p_object, GDScriptInstance *p_instance, uint32_t p_layout, const StringName &p_name, bool p_set);
+	bool _get_named_cached(NamedCache &p_cache, Object *p_object, const StringName &p_name, Variant &r_ret);
+	bool _set_named_cached(NamedCache &p_cache, Object *p_object, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	const CallCacheEntry *_resolve_call_cache(CallCache &p_cache, Object *p_object, GDScriptInstance *p_instance, uint32_t p_layout, const StringName &p_method);
+	_FORCE_INLINE_ const CallCacheEntry *_get_call_cached(CallCache &p_cache, Object *p_object, const StringName &p_method);
+
 	friend class GDScriptLanguage;
 
 	SelfList<GDScriptFunction> function_list;
@@ -278,6 +353,10 @@ private:
 		uint64_t last_frame_call_count;
 		uint64_t last_frame_self_time;
 		uint64_t last_frame_total_time;
+		uint64_t named_cache_hits;
+		uint64_t named_cache_misses;
+		uint64_t call_cache_hits;
+		uint64_t call_cache_misses;
 	} profile;
 
 #endif
@@ -287,7 +366,7 @@ public:
 
 		ObjectID instance_id;
 		GDScriptInstance *instance;
-		Vector<uint8_t> stack;
+		uint8_t *stack; //frame from GDScriptLanguage::alloc_yield_frame(), alloca_size bytes
 		int stack_size;
 		Variant self;
 		uint32_t alloca_size;
@@ -304,6 +383,7 @@ public:
 	int get_code_size() const;
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
+	MethodBindCall get_method_bind(int p_idx) const;
 	StringName get_name() const;
 	int get_max_stack_size() const;
 	int get_default_argument_count() const;
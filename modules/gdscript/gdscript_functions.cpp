@@ -36,6 +36,7 @@
 #include "core/io/marshalls.h"
 #include "core/math/math_funcs.h"
 #include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/reference.h"
 #include "core/variant_parser.h"
 #include "gdscript.h"
@@ -135,11 +136,50 @@ const char *GDScriptFunctions::get_func_name(Function p_func) {
 		"instance_from_id",
 		"len",
 		"is_instance_valid",
+		"parallel_for",
 	};
 
 	return _names[p_func];
 }
 
+// Frames of the calling thread, the debugger only keeps track of the main one's.
+static Vector<ScriptLanguage::StackInfo> _get_script_stack() {
+
+	GDScriptLanguage *script = GDScriptLanguage::get_singleton();
+	if (Thread::get_caller_id() != Thread::get_main_id()) {
+		return script->debug_get_current_stack_info();
+	}
+
+	Vector<ScriptLanguage::StackInfo> stack;
+	stack.resize(script->debug_get_stack_level_count());
+	for (int i = 0; i < stack.size(); i++) {
+		stack.write[i].file = script->debug_get_stack_level_source(i);
+		stack.write[i].func = script->debug_get_stack_level_function(i);
+		stack.write[i].line = script->debug_get_stack_level_line(i);
+	}
+	return stack;
+}
+
+// Runs a static script function over the chunks of an array, see parallel_for().
+struct GDScriptParallelFor {
+
+	GDScriptFunction *function;
+	int argcount;
+	Vector<Array> chunks;
+	Vector<int> offsets;
+	Variant *results;
+	Variant::CallError *errors;
+
+	void process(uint32_t p_index, void *p_userdata) {
+
+		Variant chunk = chunks[p_index];
+		Variant offset = offsets[p_index];
+		const Variant *args[2] = { &chunk, &offset };
+
+		results[p_index] = function->call(NULL, args, argcount, errors[p_index]);
+	}
+};
+
 void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_count, Variant &r_ret, Variant::CallError &r_error) {
 
 	r_error.error = Variant::CallError::CALL_OK;
@@ -1340,24 +1380,24 @@ void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_
 		case PRINT_STACK: {
 			VALIDATE_ARG_COUNT(0);
 
-			ScriptLanguage *script = GDScriptLanguage::get_singleton();
-			for (int i = 0; i < script->debug_get_stack_level_count(); i++) {
+			Vector<ScriptLanguage::StackInfo> stack = _get_script_stack();
+			for (int i = 0; i < stack.size(); i++) {
 
-				print_line("Frame " + itos(i) + " - " + script->debug_get_stack_level_source(i) + ":" + itos(script->debug_get_stack_level_line(i)) + " in function '" + script->debug_get_stack_level_function(i) + "'");
+				print_line("Frame " + itos(i) + " - " + stack[i].file + ":" + itos(stack[i].line) + " in function '" + stack[i].func + "'");
 			};
 		} break;
 
 		case GET_STACK: {
 			VALIDATE_ARG_COUNT(0);
 
-			ScriptLanguage *script = GDScriptLanguage::get_singleton();
+			Vector<ScriptLanguage::StackInfo> stack = _get_script_stack();
 			Array ret;
-			for (int i = 0; i < script->debug_get_stack_level_count(); i++) {
+			for (int i = 0; i < stack.size(); i++) {
 
 				Dictionary frame;
-				frame["source"] = script->debug_get_stack_level_source(i);
-				frame["function"] = script->debug_get_stack_level_function(i);
-				frame["line"] = script->debug_get_stack_level_line(i);
+				frame["source"] = stack[i].file;
+				frame["function"] = stack[i].func;
+				frame["line"] = stack[i].line;
 				ret.push_back(frame);
 			};
 			r_ret = ret;
@@ -1453,6 +1493,114 @@ void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_
 			}
 
 		} break;
+		case PARALLEL_FOR: {
+
+			if (p_arg_count < 3) {
+				r_error.error = Variant::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+				r_error.argument = 3;
+				r_ret = Variant();
+				return;
+			}
+			if (p_arg_count > 4) {
+				r_error.error = Variant::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS;
+				r_error.argument = 4;
+				r_ret = Variant();
+				return;
+			}
+
+			Ref<GDScript> script = *p_args[0];
+			if (script.is_null() || !script->is_valid()) {
+				r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+				r_error.argument = 0;
+				r_error.expected = Variant::OBJECT;
+				r_ret = Variant();
+				return;
+			}
+			if (p_args[1]->get_type() != Variant::STRING) {
+				r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+				r_error.argument = 1;
+				r_error.expected = Variant::STRING;
+				r_ret = Variant();
+				return;
+			}
+			if (p_args[2]->get_type() != Variant::ARRAY) {
+				r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+				r_error.argument = 2;
+				r_error.expected = Variant::ARRAY;
+				r_ret = Variant();
+				return;
+			}
+			int chunk_size = 0;
+			if (p_arg_count == 4) {
+				VALIDATE_ARG_NUM(3);
+				chunk_size = *p_args[3];
+			}
+
+			StringName name = *p_args[1];
+			GDScriptFunction *function = NULL;
+			for (const GDScript *E = script.ptr(); E && !function; E = E->_base) {
+				const Map<StringName, GDScriptFunction *>::Element *F = E->member_functions.find(name);
+				if (F) {
+					function = F->get();
+				}
+			}
+
+			// Only static functions can run on several threads at once, as they can't touch members.
+			if (!function || !function->is_static() || function->get_argument_count() < 1 || function->get_argument_count() - function->get_default_argument_count() > 2) {
+				r_ret = RTR("parallel_for() needs a static function taking the chunk and optionally its offset.");
+				r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+				r_error.argument = 1;
+				r_error.expected = Variant::STRING;
+				return;
+			}
+
+			Array data = *p_args[2];
+			if (chunk_size <= 0) {
+				int threads = OS::get_singleton()->get_processor_count();
+				chunk_size = MAX(1, (data.size() + threads - 1) / threads);
+			}
+
+			GDScriptParallelFor pf;
+			pf.function = function;
+			pf.argcount = function->get_argument_count() >= 2 ? 2 : 1;
+			for (int from = 0; from < data.size(); from += chunk_size) {
+				Array chunk;
+				chunk.resize(MIN(chunk_size, data.size() - from));
+				for (int i = 0; i < chunk.size(); i++) {
+					chunk[i] = data[from + i];
+				}
+				pf.chunks.push_back(chunk);
+				pf.offsets.push_back(from);
+			}
+
+			Array results;
+			results.resize(pf.chunks.size());
+			Vector<Variant::CallError> errors;
+			errors.resize(pf.chunks.size());
+			if (pf.chunks.size()) {
+				pf.results = &results[0];
+				pf.errors = errors.ptrw();
+				thread_process_array(pf.chunks.size(), &pf, &GDScriptParallelFor::process, (void *)NULL);
+			}
+
+			// A failed call leaves null in its chunk's result, so don't return partial results.
+			for (int i = 0; i < errors.size(); i++) {
+
+				if (errors[i].error != Variant::CallError::CALL_OK) {
+					Variant chunk = pf.chunks[i];
+					Variant offset = pf.offsets[i];
+					const Variant *args[2] = { &chunk, &offset };
+					String err_text = Variant::get_call_error_text(script.ptr(), name, args, pf.argcount, errors[i]);
+					ERR_PRINTS("parallel_for() failed on the chunk at offset " + itos(pf.offsets[i]) + ": " + err_text);
+
+					r_ret = RTR("Calling the function failed on a chunk:") + " " + err_text;
+					r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
+					return;
+				}
+			}
+
+			r_ret = results;
+		} break;
 		case FUNC_MAX: {
 
 			ERR_FAIL();
@@ -2057,6 +2205,12 @@ MethodInfo GDScriptFunctions::get_info(Function p_func) {
 			mi.return_val.type = Variant::BOOL;
 			return mi;
 		} break;
+		case PARALLEL_FOR: {
+			MethodInfo mi("parallel_for", PropertyInfo(Variant::OBJECT, "script", PROPERTY_HINT_RESOURCE_TYPE, "GDScript"), PropertyInfo(Variant::STRING, "function"), PropertyInfo(Variant::ARRAY, "data"), PropertyInfo(Variant::INT, "chunk_size"));
+			mi.default_arguments.push_back(0);
+			mi.return_val.type = Variant::ARRAY;
+			return mi;
+		} break;
 		case FUNC_MAX: {
 
 			ERR_FAIL_V(MethodInfo());
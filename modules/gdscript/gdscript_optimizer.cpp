@@ -0,0 +1,819 @@
+/*************************************************************************/
+/*  gdscript_optimizer.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_optimizer.h"
+
+#include "gdscript_function.h"
+
+void GDScriptOptimizer::Stats::add(const Stats &p_stats) {
+
+	instructions_before += p_stats.instructions_before;
+	instructions_after += p_stats.instructions_after;
+	code_size_before += p_stats.code_size_before;
+	code_size_after += p_stats.code_size_after;
+	constants_folded += p_stats.constants_folded;
+	copies_propagated += p_stats.copies_propagated;
+	jumps_fused += p_stats.jumps_fused;
+	jumps_threaded += p_stats.jumps_threaded;
+	lines_removed += p_stats.lines_removed;
+	dead_code_removed += p_stats.dead_code_removed;
+}
+
+String GDScriptOptimizer::Stats::to_string() const {
+
+	String s = "instructions: " + itos(instructions_before) + " -> " + itos(instructions_after);
+	s += ", code size: " + itos(code_size_before) + " -> " + itos(code_size_after);
+	s += " (folded: " + itos(constants_folded);
+	s += ", propagated: " + itos(copies_propagated);
+	s += ", fused: " + itos(jumps_fused);
+	s += ", threaded: " + itos(jumps_threaded);
+	s += ", lines: " + itos(lines_removed);
+	s += ", dead: " + itos(dead_code_removed) + ")";
+	return s;
+}
+
+GDScriptOptimizer::Stats::Stats() {
+
+	instructions_before = 0;
+	instructions_after = 0;
+	code_size_before = 0;
+	code_size_after = 0;
+	constants_folded = 0;
+	copies_propagated = 0;
+	jumps_fused = 0;
+	jumps_threaded = 0;
+	lines_removed = 0;
+	dead_code_removed = 0;
+}
+
+// Must match the way the VM advances ip for every opcode.
+int GDScriptOptimizer::_get_instruction_size(const int *p_code, int p_ip, int p_code_size) {
+
+#define ARGC(m_ofs) (p_ip + (m_ofs) < p_code_size ? p_code[p_ip + (m_ofs)] : -1)
+
+	switch (p_code[p_ip]) {
+
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_OPERATOR_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_REAL:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR3:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+			return 5;
+		case GDScriptFunction::OPCODE_EXTENDS_TEST:
+		case GDScriptFunction::OPCODE_IS_BUILTIN:
+		case GDScriptFunction::OPCODE_SET:
+		case GDScriptFunction::OPCODE_GET:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT:
+			return 4;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_YIELD_SIGNAL:
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_ASSERT:
+			return 3;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_YIELD_RESUME:
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_LINE:
+			return 2;
+		case GDScriptFunction::OPCODE_YIELD:
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END:
+			return 1;
+		case GDScriptFunction::OPCODE_CONSTRUCT: {
+			int argc = ARGC(2);
+			return argc < 0 ? -1 : 4 + argc;
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+			int argc = ARGC(1);
+			return argc < 0 ? -1 : 3 + argc;
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			int argc = ARGC(1);
+			return argc < 0 ? -1 : 3 + argc * 2;
+		}
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET: {
+			int argc = ARGC(1);
+			return argc < 0 ? -1 : 6 + argc;
+		}
+		case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			int argc = ARGC(2);
+			return argc < 0 ? -1 : 4 + argc;
+		}
+		default: {
+			return -1; // Not emitted by the compiler, don't touch this code.
+		}
+	}
+
+#undef ARGC
+}
+
+int GDScriptOptimizer::_get_jump_operand(int p_opcode) {
+
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_JUMP: return 1;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: return 2;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: return 3;
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL: return 4;
+		default: return -1;
+	}
+}
+
+// Operand holding the destination of the instructions whose result can be redirected.
+static int _get_result_operand(int p_opcode) {
+
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_OPERATOR_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_REAL:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR3:
+		case GDScriptFunction::OPCODE_GET_NAMED: return 4;
+		case GDScriptFunction::OPCODE_GET: return 3;
+		case GDScriptFunction::OPCODE_GET_MEMBER: return 2;
+		case GDScriptFunction::OPCODE_ASSIGN: return 1;
+		default: return -1;
+	}
+}
+
+bool GDScriptOptimizer::_is_comparison(int p_op) {
+
+	switch (p_op) {
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+		case Variant::OP_LESS:
+		case Variant::OP_LESS_EQUAL:
+		case Variant::OP_GREATER:
+		case Variant::OP_GREATER_EQUAL: return true;
+		default: return false;
+	}
+}
+
+int GDScriptOptimizer::get_address_operands(const int *p_code, int p_ip, int p_code_size, Vector<int> &r_operands) {
+
+	r_operands.clear();
+
+	int size = _get_instruction_size(p_code, p_ip, p_code_size);
+	if (size <= 0 || p_ip + size > p_code_size) {
+		return -1;
+	}
+
+	int first = 0;
+	int last = -1;
+
+	switch (p_code[p_ip]) {
+
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_OPERATOR_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_REAL:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
+			first = 2;
+			last = 4;
+		} break;
+		case GDScriptFunction::OPCODE_EXTENDS_TEST:
+		case GDScriptFunction::OPCODE_SET:
+		case GDScriptFunction::OPCODE_GET:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+			first = 1;
+			last = 3;
+		} break;
+		case GDScriptFunction::OPCODE_IS_BUILTIN: {
+			r_operands.push_back(1);
+			r_operands.push_back(3);
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED: {
+			r_operands.push_back(1);
+			r_operands.push_back(4);
+		} break;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER: {
+			first = 2;
+			last = 2;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_YIELD_SIGNAL:
+		case GDScriptFunction::OPCODE_ASSERT: {
+			first = 1;
+			last = 2;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_YIELD_RESUME:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			first = 1;
+			last = 1;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL: {
+			first = 2;
+			last = 3;
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: {
+			r_operands.push_back(1);
+			r_operands.push_back(2);
+			r_operands.push_back(4);
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			first = 3;
+			last = size - 1;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			first = 2;
+			last = size - 1;
+		} break;
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET: {
+			r_operands.push_back(2);
+			first = 5;
+			last = size - 1;
+		} break;
+		default: {
+			// No addresses.
+		} break;
+	}
+
+	for (int i = first; i <= last; i++) {
+		r_operands.push_back(i);
+	}
+
+	return size;
+}
+
+bool GDScriptOptimizer::_decode() {
+
+	int code_size = code.size();
+	const int *c = code.ptr();
+
+	instruction_at.resize(code_size + 1);
+	for (int i = 0; i <= code_size; i++) {
+		instruction_at.write[i] = -1;
+	}
+
+	int ip = 0;
+	while (ip < code_size) {
+
+		int size = _get_instruction_size(c, ip, code_size);
+		if (size <= 0 || ip + size > code_size) {
+			return false;
+		}
+		instruction_at.write[ip] = instructions.size();
+		instructions.push_back(ip);
+		sizes.push_back(size);
+		ip += size;
+	}
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		int operand = _get_jump_operand(c[instructions[i]]);
+		if (operand >= 0) {
+			int to = c[instructions[i] + operand];
+			if (to < 0 || to > code_size || (to < code_size && instruction_at[to] < 0)) {
+				return false;
+			}
+		}
+	}
+
+	for (int i = 0; i < default_args.size(); i++) {
+		int to = default_args[i];
+		if (to < 0 || to > code_size || (to < code_size && instruction_at[to] < 0)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GDScriptOptimizer::_mark_targets() {
+
+	const int *c = code.ptr();
+
+	jump_target.resize(code.size() + 1);
+	for (int i = 0; i <= code.size(); i++) {
+		jump_target.write[i] = false;
+	}
+
+	for (int i = 0; i < default_args.size(); i++) {
+		jump_target.write[default_args[i]] = true;
+	}
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (!sizes[i]) {
+			continue;
+		}
+
+		int opcode = c[instructions[i]];
+		int operand = _get_jump_operand(opcode);
+		if (operand >= 0) {
+			jump_target.write[c[instructions[i] + operand]] = true;
+		}
+
+		if (opcode == GDScriptFunction::OPCODE_YIELD || opcode == GDScriptFunction::OPCODE_YIELD_SIGNAL) {
+			// Resumed functions continue right after the yield.
+			jump_target.write[instructions[i] + sizes[i]] = true;
+		}
+	}
+}
+
+int GDScriptOptimizer::_next(int p_instruction) const {
+
+	for (int i = p_instruction + 1; i < instructions.size(); i++) {
+		if (sizes[i]) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+int GDScriptOptimizer::_resolve(int p_pos) const {
+
+	// Jumping to a removed instruction lands on the next one that is left.
+	if (p_pos >= code.size()) {
+		return -1;
+	}
+	int instruction = instruction_at[p_pos];
+	return sizes[instruction] ? instruction : _next(instruction);
+}
+
+bool GDScriptOptimizer::_is_temporary(int p_address) const {
+
+	return ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_STACK;
+}
+
+bool GDScriptOptimizer::_get_constant(int p_address, Variant &r_value) const {
+
+	int address = p_address & GDScriptFunction::ADDR_MASK;
+
+	switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+		case GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT: {
+			if (address >= constants->size()) {
+				return false;
+			}
+			r_value = (*constants)[address];
+		} break;
+		case GDScriptFunction::ADDR_TYPE_NIL: {
+			r_value = Variant();
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	// Objects and containers are shared by reference, never bake results from them.
+	return r_value.get_type() < Variant::OBJECT;
+}
+
+int GDScriptOptimizer::_add_constant(const Variant &p_value) {
+
+	int pos = -1;
+	for (int i = 0; i < constants->size(); i++) {
+		const Variant &v = (*constants)[i];
+		if (v.get_type() == p_value.get_type() && v.hash_compare(p_value)) {
+			pos = i;
+			break;
+		}
+	}
+
+	if (pos < 0) {
+		pos = constants->size();
+		constants->push_back(p_value);
+	}
+
+	return pos | (GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT << GDScriptFunction::ADDR_BITS);
+}
+
+bool GDScriptOptimizer::_has_target_between(int p_from, int p_to) const {
+
+	for (int i = p_from + 1; i <= p_to; i++) {
+		if (jump_target[instructions[i]]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GDScriptOptimizer::_fold_constants() {
+
+	bool changed = false;
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (!sizes[i]) {
+			continue;
+		}
+
+		int *c = code.ptrw() + instructions[i];
+
+		switch (c[0]) {
+
+			case GDScriptFunction::OPCODE_OPERATOR:
+			case GDScriptFunction::OPCODE_OPERATOR_INT:
+			case GDScriptFunction::OPCODE_OPERATOR_REAL:
+			case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+			case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
+
+				Variant a, b;
+				if (!_get_constant(c[2], a) || !_get_constant(c[3], b)) {
+					break;
+				}
+
+				Variant ret;
+				bool valid;
+				Variant::evaluate((Variant::Operator)c[1], a, b, ret, valid);
+				if (!valid || ret.get_type() >= Variant::OBJECT) {
+					break; // Keep the runtime error.
+				}
+
+				int dst = c[4];
+				c[0] = GDScriptFunction::OPCODE_ASSIGN;
+				c[1] = dst;
+				c[2] = _add_constant(ret);
+				sizes.write[i] = 3;
+				stats.constants_folded++;
+				changed = true;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+
+				Variant test;
+				if (!_get_constant(c[1], test)) {
+					break;
+				}
+
+				if (test.booleanize() == (c[0] == GDScriptFunction::OPCODE_JUMP_IF)) {
+					int to = c[2];
+					c[0] = GDScriptFunction::OPCODE_JUMP;
+					c[1] = to;
+					sizes.write[i] = 2;
+				} else {
+					sizes.write[i] = 0;
+				}
+				stats.constants_folded++;
+				changed = true;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL: {
+
+				Variant a, b;
+				if (!_get_constant(c[2], a) || !_get_constant(c[3], b)) {
+					break;
+				}
+
+				Variant ret;
+				bool valid;
+				Variant::evaluate((Variant::Operator)c[1], a, b, ret, valid);
+				if (!valid) {
+					break;
+				}
+
+				if (!ret.booleanize()) {
+					int to = c[4];
+					c[0] = GDScriptFunction::OPCODE_JUMP;
+					c[1] = to;
+					sizes.write[i] = 2;
+				} else {
+					sizes.write[i] = 0;
+				}
+				stats.constants_folded++;
+				changed = true;
+			} break;
+		}
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_propagate_copies() {
+
+	bool changed = false;
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (!sizes[i]) {
+			continue;
+		}
+
+		int *c = code.ptrw() + instructions[i];
+
+		if (c[0] == GDScriptFunction::OPCODE_ASSIGN && c[1] == c[2]) {
+			sizes.write[i] = 0;
+			stats.copies_propagated++;
+			changed = true;
+			continue;
+		}
+
+		// The compiler writes every expression result to a temporary and copies it over to
+		// the variable being assigned, which never reads it again. Write to the variable directly.
+		int result = _get_result_operand(c[0]);
+		if (result < 0 || !_is_temporary(c[result])) {
+			continue;
+		}
+
+		int next = _next(i);
+		if (next < 0 || _has_target_between(i, next)) {
+			continue;
+		}
+
+		const int *n = code.ptr() + instructions[next];
+		if (n[0] != GDScriptFunction::OPCODE_ASSIGN || n[2] != c[result] || n[1] == c[result]) {
+			continue;
+		}
+
+		c[result] = n[1];
+		sizes.write[next] = 0;
+		stats.copies_propagated++;
+		changed = true;
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_fuse_jumps() {
+
+	bool changed = false;
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (!sizes[i]) {
+			continue;
+		}
+
+		int *c = code.ptrw() + instructions[i];
+
+		if (c[0] != GDScriptFunction::OPCODE_OPERATOR && c[0] != GDScriptFunction::OPCODE_OPERATOR_INT && c[0] != GDScriptFunction::OPCODE_OPERATOR_REAL) {
+			continue;
+		}
+		if (!_is_comparison(c[1]) || !_is_temporary(c[4])) {
+			continue;
+		}
+
+		int next = _next(i);
+		if (next < 0 || _has_target_between(i, next)) {
+			continue;
+		}
+
+		const int *n = code.ptr() + instructions[next];
+		if (n[0] != GDScriptFunction::OPCODE_JUMP_IF_NOT || n[1] != c[4]) {
+			continue;
+		}
+
+		// The int version falls back to the float and generic ones, so it's fine for untyped code too.
+		c[0] = c[0] == GDScriptFunction::OPCODE_OPERATOR_REAL ? GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL : GDScriptFunction::OPCODE_JUMP_IF_NOT_INT;
+		c[4] = n[2];
+		sizes.write[next] = 0;
+		stats.jumps_fused++;
+		changed = true;
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_thread_jumps() {
+
+	bool changed = false;
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (!sizes[i]) {
+			continue;
+		}
+
+		int *c = code.ptrw() + instructions[i];
+		int operand = _get_jump_operand(c[0]);
+		if (operand < 0) {
+			continue;
+		}
+
+		// Jumping to a jump goes straight to its target. Bounded, so empty infinite loops are left alone.
+		int to = c[operand];
+		for (int depth = 0; depth < 16; depth++) {
+			int target = _resolve(to);
+			if (target < 0 || target == i) {
+				break;
+			}
+			const int *t = code.ptr() + instructions[target];
+			if (t[0] != GDScriptFunction::OPCODE_JUMP || t[1] == to) {
+				break;
+			}
+			to = t[1];
+		}
+
+		if (to != c[operand]) {
+			c[operand] = to;
+			jump_target.write[to] = true;
+			stats.jumps_threaded++;
+			changed = true;
+		}
+
+		// Plain jumps to the next instruction do nothing.
+		if (c[0] == GDScriptFunction::OPCODE_JUMP || c[0] == GDScriptFunction::OPCODE_JUMP_IF || c[0] == GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+			if (_resolve(to) == _next(i)) {
+				sizes.write[i] = 0;
+				stats.jumps_threaded++;
+				changed = true;
+			}
+		}
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_remove_lines() {
+
+	bool changed = false;
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (!sizes[i] || code[instructions[i]] != GDScriptFunction::OPCODE_LINE) {
+			continue;
+		}
+
+		// Without a debugger the line is only read when something fails, so one that is
+		// immediately replaced by the next can go, even if it was jumped to.
+		int next = _next(i);
+		if (next >= 0 && code[instructions[next]] == GDScriptFunction::OPCODE_LINE) {
+			sizes.write[i] = 0;
+			stats.lines_removed++;
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_remove_dead_code() {
+
+	bool changed = false;
+	bool reachable = true;
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (jump_target[instructions[i]]) {
+			reachable = true;
+		}
+
+		if (!sizes[i]) {
+			continue;
+		}
+
+		int opcode = code[instructions[i]];
+
+		if (!reachable && opcode != GDScriptFunction::OPCODE_END) {
+			sizes.write[i] = 0;
+			stats.dead_code_removed++;
+			changed = true;
+			continue;
+		}
+
+		reachable = opcode != GDScriptFunction::OPCODE_JUMP && opcode != GDScriptFunction::OPCODE_RETURN && opcode != GDScriptFunction::OPCODE_END;
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::optimize(Vector<int> &r_code, Vector<int> &r_default_args, Vector<Variant> &r_constants, bool p_keep_lines) {
+
+	code = r_code;
+	default_args = r_default_args;
+	constants = &r_constants;
+	instructions.clear();
+	sizes.clear();
+	stats = Stats();
+
+	if (!_decode()) {
+		return false;
+	}
+
+	stats.instructions_before = instructions.size();
+	stats.code_size_before = code.size();
+
+	bool changed = true;
+	for (int pass = 0; changed && pass < 8; pass++) {
+
+		_mark_targets();
+
+		changed = _fold_constants();
+		changed = _propagate_copies() || changed;
+		changed = _fuse_jumps() || changed;
+		changed = _thread_jumps() || changed;
+		if (!p_keep_lines) {
+			changed = _remove_lines() || changed;
+		}
+		changed = _remove_dead_code() || changed;
+	}
+
+	// Lay out what's left and relocate the jumps.
+
+	Vector<int> new_pos;
+	new_pos.resize(code.size() + 1);
+
+	int new_size = 0;
+	for (int i = 0; i < instructions.size(); i++) {
+		new_pos.write[instructions[i]] = new_size;
+		new_size += sizes[i];
+	}
+	new_pos.write[code.size()] = new_size;
+
+	Vector<int> new_code;
+	new_code.resize(new_size);
+	int *w = new_code.ptrw();
+
+	for (int i = 0; i < instructions.size(); i++) {
+
+		if (!sizes[i]) {
+			continue;
+		}
+
+		const int *c = code.ptr() + instructions[i];
+		int *d = w + new_pos[instructions[i]];
+		for (int j = 0; j < sizes[i]; j++) {
+			d[j] = c[j];
+		}
+
+		int operand = _get_jump_operand(c[0]);
+		if (operand >= 0) {
+			d[operand] = new_pos[c[operand]];
+		}
+
+		stats.instructions_after++;
+	}
+
+	for (int i = 0; i < r_default_args.size(); i++) {
+		r_default_args.write[i] = new_pos[r_default_args[i]];
+	}
+
+	stats.code_size_after = new_size;
+	r_code = new_code;
+
+	return true;
+}
+
+GDScriptOptimizer::GDScriptOptimizer() {
+
+	constants = NULL;
+}
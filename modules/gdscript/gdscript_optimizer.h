@@ -0,0 +1,107 @@
+/*************************************************************************/
+/*  gdscript_optimizer.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_OPTIMIZER_H
+#define GDSCRIPT_OPTIMIZER_H
+
+#include "core/variant.h"
+#include "core/vector.h"
+
+// Peephole optimizer run by the compiler on the finished bytecode of every function.
+// It only rewrites patterns the compiler is known to emit, so the VM sees the same kind of code.
+class GDScriptOptimizer {
+public:
+	struct Stats {
+
+		int instructions_before;
+		int instructions_after;
+		int code_size_before;
+		int code_size_after;
+
+		int constants_folded;
+		int copies_propagated;
+		int jumps_fused;
+		int jumps_threaded;
+		int lines_removed;
+		int dead_code_removed;
+
+		void add(const Stats &p_stats);
+		String to_string() const;
+
+		Stats();
+	};
+
+private:
+	Vector<int> code;
+	Vector<int> instructions; // start of every instruction in the code
+	Vector<int> sizes; // size of every instruction, 0 once removed
+	Vector<int> instruction_at; // code position -> instruction index, -1 if not the start of one
+	Vector<bool> jump_target; // code position is the target of a jump (or a resume point)
+	Vector<int> default_args;
+
+	Vector<Variant> *constants;
+	Stats stats;
+
+	static int _get_instruction_size(const int *p_code, int p_ip, int p_code_size);
+	static int _get_jump_operand(int p_opcode);
+	static bool _is_comparison(int p_op);
+
+	bool _decode();
+	void _mark_targets();
+	int _next(int p_instruction) const;
+	int _resolve(int p_pos) const;
+	bool _is_temporary(int p_address) const;
+	bool _get_constant(int p_address, Variant &r_value) const;
+	int _add_constant(const Variant &p_value);
+	bool _has_target_between(int p_from, int p_to) const;
+
+	bool _fold_constants();
+	bool _propagate_copies();
+	bool _fuse_jumps();
+	bool _thread_jumps();
+	bool _remove_lines();
+	bool _remove_dead_code();
+
+public:
+	// Rewrites r_code in place, fixing up the jump addresses in it and in r_default_args.
+	// Folded values are appended to r_constants. Returns false (leaving everything untouched)
+	// if the code could not be decoded.
+	bool optimize(Vector<int> &r_code, Vector<int> &r_default_args, Vector<Variant> &r_constants, bool p_keep_lines);
+
+	const Stats &get_stats() const { return stats; }
+
+	// Fills r_operands with the offsets (from p_ip) of the operands of the instruction at p_ip
+	// that hold addresses. Returns the size of the instruction, or -1 if it can't be decoded.
+	static int get_address_operands(const int *p_code, int p_ip, int p_code_size, Vector<int> &r_operands);
+
+	GDScriptOptimizer();
+};
+
+#endif // GDSCRIPT_OPTIMIZER_H
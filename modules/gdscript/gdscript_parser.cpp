@@ -40,10 +40,31 @@
 #include "core/script_language.h"
 #include "gdscript.h"
 
+void *GDScriptParser::_alloc_node_memory(uint32_t p_size) {
+
+	p_size = (p_size + NODE_ALIGN - 1) & ~(NODE_ALIGN - 1);
+
+	if (p_size > NODE_BLOCK_SIZE) {
+		// Keep the block being filled last.
+		uint8_t *mem = (uint8_t *)memalloc(p_size);
+		node_blocks.insert(0, mem);
+		return mem;
+	}
+
+	if (node_blocks.empty() || node_block_pos + p_size > NODE_BLOCK_SIZE) {
+		node_blocks.push_back((uint8_t *)memalloc(NODE_BLOCK_SIZE));
+		node_block_pos = 0;
+	}
+
+	uint8_t *mem = node_blocks[node_blocks.size() - 1] + node_block_pos;
+	node_block_pos += p_size;
+	return mem;
+}
+
 template <class T>
 T *GDScriptParser::alloc_node() {
 
-	T *t = memnew(T);
+	T *t = memnew_placement(_alloc_node_memory(sizeof(T)), T);
 
 	t->next = list;
 	list = t;
@@ -8581,8 +8602,14 @@ void GDScriptParser::clear() {
 
 		Node *l = list;
 		list = list->next;
-		memdelete(l);
+		l->~Node();
+	}
+
+	for (int i = 0; i < node_blocks.size(); i++) {
+		memfree(node_blocks[i]);
 	}
+	node_blocks.clear();
+	node_block_pos = 0;
 
 	head = NULL;
 	list = NULL;
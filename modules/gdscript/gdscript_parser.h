@@ -529,6 +529,16 @@ private:
 
 	Node *head;
 	Node *list;
+
+	// Nodes are placed in large blocks and all freed at once by clear(), instead of one allocation each.
+	enum {
+		NODE_BLOCK_SIZE = 64 * 1024,
+		NODE_ALIGN = 16
+	};
+	Vector<uint8_t *> node_blocks;
+	uint32_t node_block_pos;
+	void *_alloc_node_memory(uint32_t p_size);
+
 	template <class T>
 	T *alloc_node();
 
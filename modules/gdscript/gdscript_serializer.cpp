@@ -0,0 +1,1268 @@
+/*************************************************************************/
+/*  gdscript_serializer.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_serializer.h"
+
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+#include "gdscript_compiler.h"
+#include "gdscript_functions.h"
+#include "gdscript_optimizer.h"
+
+// GDScriptFunction::call() allocates the stack and call arguments with alloca(), the compiler never
+// gets close to this. Cache slots are only bounded so a broken file can't request huge allocations.
+#define MAX_STACK_SIZE (1 << 16)
+#define MAX_CACHE_COUNT (1 << 20)
+
+void GDScriptSerializer::_put_u32(uint32_t p_value) {
+
+	int at = buffer.size();
+	buffer.resize(at + 4);
+	encode_uint32(p_value, &buffer.write[at]);
+}
+
+void GDScriptSerializer::_put_string(const String &p_string) {
+
+	CharString cs = p_string.utf8();
+	_put_u32(cs.length());
+	int at = buffer.size();
+	buffer.resize(at + cs.length());
+	for (int i = 0; i < cs.length(); i++) {
+		buffer.write[at + i] = cs[i];
+	}
+}
+
+bool GDScriptSerializer::_put_variant(const Variant &p_variant) {
+
+	switch (p_variant.get_type()) {
+
+		case Variant::OBJECT: {
+
+			Object *obj = p_variant;
+			if (!obj) {
+				_put_u32(VARIANT_NULL_OBJECT);
+				return true;
+			}
+
+			GDScriptNativeClass *native = Object::cast_to<GDScriptNativeClass>(obj);
+			if (native) {
+				_put_u32(VARIANT_NATIVE_CLASS);
+				_put_string(native->get_name());
+				return true;
+			}
+
+			Script *script = Object::cast_to<Script>(obj);
+			if (script) {
+				_put_u32(VARIANT_SCRIPT);
+				return _put_script(Ref<Script>(script));
+			}
+
+			Resource *res = Object::cast_to<Resource>(obj);
+			if (res && res->get_path() != String() && res->get_path().find("::") == -1) {
+				_put_u32(VARIANT_RESOURCE);
+				_put_string(res->get_path());
+				return true;
+			}
+
+			error = "Constant of type '" + obj->get_class() + "' can't be saved.";
+			return false;
+		} break;
+		case Variant::ARRAY: {
+
+			Array array = p_variant;
+			_put_u32(VARIANT_ARRAY);
+			_put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				if (!_put_variant(array[i])) {
+					return false;
+				}
+			}
+			return true;
+		} break;
+		case Variant::DICTIONARY: {
+
+			Dictionary dict = p_variant;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			_put_u32(VARIANT_DICTIONARY);
+			_put_u32(keys.size());
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				if (!_put_variant(E->get()) || !_put_variant(dict[E->get()])) {
+					return false;
+				}
+			}
+			return true;
+		} break;
+		default: {
+
+			int len;
+			Error err = encode_variant(p_variant, NULL, len);
+			if (err != OK) {
+				error = "Constant of type '" + Variant::get_type_name(p_variant.get_type()) + "' can't be saved.";
+				return false;
+			}
+			_put_u32(VARIANT_VALUE);
+			_put_u32(len);
+			int at = buffer.size();
+			buffer.resize(at + len);
+			encode_variant(p_variant, &buffer.write[at], len);
+			return true;
+		} break;
+	}
+}
+
+bool GDScriptSerializer::_put_script(const Ref<Script> &p_script) {
+
+	if (p_script.is_null()) {
+		_put_u32(SCRIPT_NONE);
+		return true;
+	}
+
+	// Inner classes are saved as their outermost script plus the names leading to them.
+	Vector<String> names;
+	const Script *outer = p_script.ptr();
+	const GDScript *gds = Object::cast_to<GDScript>(outer);
+	if (gds) {
+		while (gds->_owner) {
+			const GDScript *owner = gds->_owner;
+			const Map<StringName, Ref<GDScript> >::Element *E = owner->subclasses.front();
+			while (E && E->get().ptr() != gds) {
+				E = E->next();
+			}
+			if (!E) {
+				error = "Inner class not found in its owner.";
+				return false;
+			}
+			names.insert(0, E->key());
+			gds = owner;
+		}
+		outer = gds;
+	}
+
+	// The editor may hand out its own instance of the script being saved.
+	String path = outer->get_path();
+	if (outer == root || path == root_path) {
+		_put_u32(SCRIPT_OWN);
+	} else {
+		if (path == String() || path.find("::") != -1) {
+			error = "Reference to a built-in script can't be saved.";
+			return false;
+		}
+		_put_u32(SCRIPT_EXTERNAL);
+		_put_string(path);
+	}
+
+	_put_u32(names.size());
+	for (int i = 0; i < names.size(); i++) {
+		_put_string(names[i]);
+	}
+
+	return true;
+}
+
+bool GDScriptSerializer::_put_data_type(const GDScriptDataType &p_type) {
+
+	_put_u32(p_type.has_type);
+	_put_u32(p_type.kind);
+	_put_u32(p_type.builtin_type);
+	_put_string(p_type.native_type);
+	return _put_script(p_type.script_type);
+}
+
+void GDScriptSerializer::_put_property_info(const PropertyInfo &p_info) {
+
+	_put_u32(p_info.type);
+	_put_string(p_info.name);
+	_put_string(p_info.class_name);
+	_put_u32(p_info.hint);
+	_put_string(p_info.hint_string);
+	_put_u32(p_info.usage);
+}
+
+bool GDScriptSerializer::_put_function(const GDScriptFunction *p_function) {
+
+	_put_string(p_function->name);
+	_put_u32(p_function->_static);
+	_put_u32(p_function->rpc_mode);
+	_put_u32(p_function->_initial_line);
+	_put_u32(p_function->_argument_count);
+	_put_u32(p_function->_stack_size);
+	_put_u32(p_function->_call_size);
+
+	_put_u32(p_function->argument_types.size());
+	for (int i = 0; i < p_function->argument_types.size(); i++) {
+		if (!_put_data_type(p_function->argument_types[i])) {
+			return false;
+		}
+	}
+	if (!_put_data_type(p_function->return_type)) {
+		return false;
+	}
+
+#ifdef TOOLS_ENABLED
+	_put_u32(p_function->arg_names.size());
+	for (int i = 0; i < p_function->arg_names.size(); i++) {
+		_put_string(p_function->arg_names[i]);
+	}
+#else
+	_put_u32(0);
+#endif
+
+	_put_u32(p_function->default_arguments.size());
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		_put_u32(p_function->default_arguments[i]);
+	}
+
+	_put_u32(p_function->constants.size());
+	for (int i = 0; i < p_function->constants.size(); i++) {
+		if (!_put_variant(p_function->constants[i])) {
+			return false;
+		}
+	}
+
+	_put_u32(p_function->global_names.size());
+	for (int i = 0; i < p_function->global_names.size(); i++) {
+		_put_string(p_function->global_names[i]);
+	}
+
+	_put_u32(p_function->method_binds.size());
+	for (int i = 0; i < p_function->method_binds.size(); i++) {
+		_put_string(p_function->method_binds[i].class_name);
+		_put_string(p_function->method_binds[i].method->get_name());
+	}
+
+	_put_u32(p_function->named_caches.size());
+	_put_u32(p_function->call_caches.size());
+
+	// Global indices depend on what was registered before the script got compiled, so global
+	// addresses are saved as indices into a table of names that is resolved again on load.
+	Vector<int> code = p_function->code;
+	Vector<StringName> globals;
+	Vector<int> operands;
+	int *c = code.ptrw();
+	int ip = 0;
+	while (ip < code.size()) {
+
+		int size = GDScriptOptimizer::get_address_operands(c, ip, code.size(), operands);
+		if (size < 0) {
+			error = "Can't decode the bytecode of function '" + String(p_function->name) + "'.";
+			return false;
+		}
+
+		for (int i = 0; i < operands.size(); i++) {
+
+			int address = c[ip + operands[i]];
+			int address_index = address & GDScriptFunction::ADDR_MASK;
+			StringName name;
+
+			switch ((address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+				case GDScriptFunction::ADDR_TYPE_GLOBAL: {
+					ERR_FAIL_COND_V(!global_names.has(address_index), false);
+					name = global_names[address_index];
+				} break;
+				case GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL: {
+#ifdef TOOLS_ENABLED
+					ERR_FAIL_INDEX_V(address_index, p_function->named_globals.size(), false);
+					name = p_function->named_globals[address_index];
+#else
+					ERR_FAIL_V(false);
+#endif
+				} break;
+				default: {
+					continue;
+				}
+			}
+
+			int global = globals.find(name);
+			if (global < 0) {
+				global = globals.size();
+				globals.push_back(name);
+			}
+			c[ip + operands[i]] = (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS) | global;
+		}
+
+		ip += size;
+	}
+
+	_put_u32(globals.size());
+	for (int i = 0; i < globals.size(); i++) {
+		_put_string(globals[i]);
+	}
+
+	_put_u32(code.size());
+	for (int i = 0; i < code.size(); i++) {
+		_put_u32(code[i]);
+	}
+
+	_put_u32(p_function->stack_debug.size());
+	for (const List<GDScriptFunction::StackDebug>::Element *E = p_function->stack_debug.front(); E; E = E->next()) {
+		_put_u32(E->get().line);
+		_put_u32(E->get().pos);
+		_put_u32(E->get().added);
+		_put_string(E->get().identifier);
+	}
+
+	return true;
+}
+
+void GDScriptSerializer::_put_class_tree(const GDScript *p_script) {
+
+	_put_u32(p_script->subclasses.size());
+	for (const Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		_put_string(E->key());
+		_put_class_tree(E->get().ptr());
+	}
+}
+
+bool GDScriptSerializer::_put_class(const GDScript *p_script) {
+
+	_put_string(p_script->name);
+	_put_u32(p_script->tool);
+
+	if (p_script->base.is_valid()) {
+		_put_u32(1);
+		if (!_put_script(p_script->base)) {
+			return false;
+		}
+	} else {
+		ERR_FAIL_COND_V(p_script->native.is_null(), false);
+		_put_u32(0);
+		_put_string(p_script->native->get_name());
+	}
+
+	_put_u32(p_script->members.size());
+	for (const Set<StringName>::Element *E = p_script->members.front(); E; E = E->next()) {
+		_put_string(E->get());
+	}
+
+	_put_u32(p_script->member_indices.size());
+	for (const Map<StringName, GDScript::MemberInfo>::Element *E = p_script->member_indices.front(); E; E = E->next()) {
+		_put_string(E->key());
+		_put_u32(E->get().index);
+		_put_string(E->get().setter);
+		_put_string(E->get().getter);
+		_put_u32(E->get().rpc_mode);
+		if (!_put_data_type(E->get().data_type)) {
+			return false;
+		}
+	}
+
+	_put_u32(p_script->member_info.size());
+	for (const Map<StringName, PropertyInfo>::Element *E = p_script->member_info.front(); E; E = E->next()) {
+		_put_string(E->key());
+		_put_property_info(E->get());
+	}
+
+#ifdef TOOLS_ENABLED
+	_put_u32(p_script->member_default_values.size());
+	for (const Map<StringName, Variant>::Element *E = p_script->member_default_values.front(); E; E = E->next()) {
+		_put_string(E->key());
+		if (!_put_variant(E->get())) {
+			return false;
+		}
+	}
+
+	_put_u32(p_script->member_lines.size());
+	for (const Map<StringName, int>::Element *E = p_script->member_lines.front(); E; E = E->next()) {
+		_put_string(E->key());
+		_put_u32(E->get());
+	}
+#else
+	_put_u32(0);
+	_put_u32(0);
+#endif
+
+	_put_u32(p_script->constants.size());
+	for (const Map<StringName, Variant>::Element *E = p_script->constants.front(); E; E = E->next()) {
+		_put_string(E->key());
+		if (!_put_variant(E->get())) {
+			return false;
+		}
+	}
+
+	_put_u32(p_script->_signals.size());
+	for (const Map<StringName, Vector<StringName> >::Element *E = p_script->_signals.front(); E; E = E->next()) {
+		_put_string(E->key());
+		_put_u32(E->get().size());
+		for (int i = 0; i < E->get().size(); i++) {
+			_put_string(E->get()[i]);
+		}
+	}
+
+	_put_u32(p_script->member_functions.size());
+	for (const Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		if (!_put_function(E->get())) {
+			return false;
+		}
+	}
+
+	_put_u32(p_script->subclasses.size());
+	for (const Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		_put_string(E->key());
+		if (!_put_class(E->get().ptr())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32_t GDScriptSerializer::_get_u32() {
+
+	if (failed || pos + 4 > data_size) {
+		failed = true;
+		return 0;
+	}
+
+	uint32_t value = decode_uint32(&data[pos]);
+	pos += 4;
+	return value;
+}
+
+String GDScriptSerializer::_get_string() {
+
+	uint32_t len = _get_u32();
+	if (failed || len > uint32_t(data_size - pos)) {
+		failed = true;
+		return String();
+	}
+
+	String s;
+	s.parse_utf8((const char *)&data[pos], len);
+	pos += len;
+	return s;
+}
+
+bool GDScriptSerializer::_get_variant(Variant &r_variant) {
+
+	switch (_get_u32()) {
+
+		case VARIANT_VALUE: {
+
+			uint32_t len = _get_u32();
+			if (failed || len > uint32_t(data_size - pos)) {
+				failed = true;
+				return false;
+			}
+			Error err = decode_variant(r_variant, &data[pos], len);
+			if (err != OK) {
+				failed = true;
+				return false;
+			}
+			pos += len;
+		} break;
+		case VARIANT_ARRAY: {
+
+			uint32_t count = _get_u32();
+			Array array;
+			for (uint32_t i = 0; i < count && !failed; i++) {
+				Variant value;
+				if (!_get_variant(value)) {
+					return false;
+				}
+				array.push_back(value);
+			}
+			r_variant = array;
+		} break;
+		case VARIANT_DICTIONARY: {
+
+			uint32_t count = _get_u32();
+			Dictionary dict;
+			for (uint32_t i = 0; i < count && !failed; i++) {
+				Variant key;
+				Variant value;
+				if (!_get_variant(key) || !_get_variant(value)) {
+					return false;
+				}
+				dict[key] = value;
+			}
+			r_variant = dict;
+		} break;
+		case VARIANT_NULL_OBJECT: {
+
+			r_variant = (Object *)NULL;
+		} break;
+		case VARIANT_NATIVE_CLASS: {
+
+			StringName name = _get_string();
+			const Map<StringName, int> &globals = GDScriptLanguage::get_singleton()->get_global_map();
+			if (failed || !globals.has(name)) {
+				error = "Native class '" + String(name) + "' not found.";
+				return false;
+			}
+			r_variant = GDScriptLanguage::get_singleton()->get_global_array()[globals[name]];
+		} break;
+		case VARIANT_SCRIPT: {
+
+			Ref<Script> script;
+			if (!_get_script(script)) {
+				return false;
+			}
+			r_variant = script;
+		} break;
+		case VARIANT_RESOURCE: {
+
+			String path = _get_string();
+			if (failed) {
+				return false;
+			}
+			RES res = ResourceLoader::load(path);
+			if (res.is_null()) {
+				error = "Can't load resource '" + path + "'.";
+				return false;
+			}
+			r_variant = res;
+		} break;
+		default: {
+
+			failed = true;
+		} break;
+	}
+
+	return !failed;
+}
+
+bool GDScriptSerializer::_get_script(Ref<Script> &r_script) {
+
+	Ref<Script> script;
+
+	switch (_get_u32()) {
+
+		case SCRIPT_NONE: {
+
+			r_script = Ref<Script>();
+			return !failed;
+		} break;
+		case SCRIPT_OWN: {
+
+			script = Ref<Script>(root);
+		} break;
+		case SCRIPT_EXTERNAL: {
+
+			String path = _get_string();
+			if (failed) {
+				return false;
+			}
+			script = ResourceLoader::load(path);
+			if (script.is_null()) {
+				error = "Can't load script '" + path + "'.";
+				return false;
+			}
+		} break;
+		default: {
+
+			failed = true;
+			return false;
+		} break;
+	}
+
+	uint32_t count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+
+		StringName name = _get_string();
+		Ref<GDScript> outer = script;
+		if (failed || outer.is_null() || !outer->subclasses.has(name)) {
+			error = "Inner class '" + String(name) + "' not found.";
+			return false;
+		}
+		script = outer->subclasses[name];
+	}
+
+	r_script = script;
+	return !failed;
+}
+
+bool GDScriptSerializer::_get_data_type(GDScriptDataType &r_type) {
+
+	r_type.has_type = _get_u32();
+	switch (_get_u32()) {
+		case GDScriptDataType::UNINITIALIZED: r_type.kind = GDScriptDataType::UNINITIALIZED; break;
+		case GDScriptDataType::BUILTIN: r_type.kind = GDScriptDataType::BUILTIN; break;
+		case GDScriptDataType::NATIVE: r_type.kind = GDScriptDataType::NATIVE; break;
+		case GDScriptDataType::SCRIPT: r_type.kind = GDScriptDataType::SCRIPT; break;
+		case GDScriptDataType::GDSCRIPT: r_type.kind = GDScriptDataType::GDSCRIPT; break;
+		default: {
+			failed = true;
+			return false;
+		}
+	}
+	uint32_t builtin_type = _get_u32();
+	if (builtin_type >= Variant::VARIANT_MAX) {
+		failed = true;
+		return false;
+	}
+	r_type.builtin_type = Variant::Type(builtin_type);
+	r_type.native_type = _get_string();
+	return _get_script(r_type.script_type);
+}
+
+PropertyInfo GDScriptSerializer::_get_property_info() {
+
+	PropertyInfo info;
+	info.type = Variant::Type(_get_u32());
+	info.name = _get_string();
+	info.class_name = _get_string();
+	info.hint = PropertyHint(_get_u32());
+	info.hint_string = _get_string();
+	info.usage = _get_u32();
+	if (info.type >= Variant::VARIANT_MAX) {
+		failed = true;
+	}
+	return info;
+}
+
+// Checks the operands of the instruction at p_code that are neither addresses nor jumps against the
+// tables of p_function. Sets r_jump to the jump target (-1 if none) and r_argc to the amount of
+// arguments the instruction passes in the call arguments of the function.
+bool GDScriptSerializer::_check_operands(const GDScriptFunction *p_function, const int *p_code, int p_named_cache_count, int p_call_cache_count, int &r_jump, int &r_argc) {
+
+	int global_count = p_function->global_names.size();
+	r_jump = -1;
+	r_argc = 0;
+
+#define CHECK_INDEX(m_ofs, m_size) (p_code[m_ofs] >= 0 && p_code[m_ofs] < (m_size))
+
+	switch (p_code[0]) {
+
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_OPERATOR_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_REAL:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
+			return CHECK_INDEX(1, Variant::OP_MAX);
+		}
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_REAL: {
+			r_jump = p_code[4];
+			return CHECK_INDEX(1, Variant::OP_MAX);
+		}
+		case GDScriptFunction::OPCODE_IS_BUILTIN: {
+			return CHECK_INDEX(2, Variant::VARIANT_MAX);
+		}
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+			return CHECK_INDEX(1, Variant::VARIANT_MAX);
+		}
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED: {
+			return CHECK_INDEX(2, global_count) && CHECK_INDEX(3, p_named_cache_count);
+		}
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER: {
+			return CHECK_INDEX(1, global_count);
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT: {
+			r_argc = p_code[2];
+			return CHECK_INDEX(1, Variant::VARIANT_MAX);
+		}
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN: {
+			r_argc = p_code[1];
+			return CHECK_INDEX(3, global_count) && CHECK_INDEX(4, p_call_cache_count);
+		}
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET: {
+			r_argc = p_code[1];
+			return CHECK_INDEX(3, global_count) && CHECK_INDEX(4, p_function->method_binds.size());
+		}
+		case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
+			r_argc = p_code[2];
+			return CHECK_INDEX(1, GDScriptFunctions::FUNC_MAX);
+		}
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			r_argc = p_code[2];
+			return CHECK_INDEX(1, global_count);
+		}
+		case GDScriptFunction::OPCODE_JUMP: {
+			r_jump = p_code[1];
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			r_jump = p_code[2];
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: {
+			r_jump = p_code[3];
+		} break;
+		default: {
+		} break;
+	}
+
+#undef CHECK_INDEX
+
+	return true;
+}
+
+bool GDScriptSerializer::_get_function(GDScript *p_script) {
+
+	StringName name = _get_string();
+	if (failed || p_script->member_functions.has(name)) {
+		failed = true;
+		return false;
+	}
+
+	// Owned by the script from now on, so it's freed along with it if loading fails.
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	p_script->member_functions[name] = function;
+
+	function->name = name;
+	function->_static = _get_u32();
+	function->rpc_mode = MultiplayerAPI::RPCMode(_get_u32());
+	function->_initial_line = _get_u32();
+	uint32_t argument_count = _get_u32();
+	uint32_t stack_size = _get_u32();
+	uint32_t call_size = _get_u32();
+	if (failed || stack_size > MAX_STACK_SIZE || call_size > MAX_STACK_SIZE || argument_count > stack_size) {
+		failed = true;
+		return false;
+	}
+	function->_argument_count = argument_count;
+	function->_stack_size = stack_size;
+	function->_call_size = call_size;
+
+	uint32_t count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		GDScriptDataType type;
+		if (!_get_data_type(type)) {
+			return false;
+		}
+		function->argument_types.push_back(type);
+	}
+	if (failed || function->argument_types.size() != function->_argument_count) {
+		failed = true;
+		return false;
+	}
+	if (!_get_data_type(function->return_type)) {
+		return false;
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName arg_name = _get_string();
+#ifdef TOOLS_ENABLED
+		function->arg_names.push_back(arg_name);
+#endif
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		function->default_arguments.push_back(_get_u32());
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		Variant constant;
+		if (!_get_variant(constant)) {
+			return false;
+		}
+		function->constants.push_back(constant);
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		function->global_names.push_back(_get_string());
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		GDScriptFunction::MethodBindCall mbc;
+		mbc.class_name = _get_string();
+		StringName method = _get_string();
+		mbc.method = ClassDB::get_method(mbc.class_name, method);
+		if (failed || !mbc.method) {
+			error = "Method '" + String(mbc.class_name) + "::" + String(method) + "' not found.";
+			return false;
+		}
+		function->method_binds.push_back(mbc);
+	}
+
+	uint32_t named_cache_count = _get_u32();
+	uint32_t call_cache_count = _get_u32();
+	if (failed || named_cache_count > MAX_CACHE_COUNT || call_cache_count > MAX_CACHE_COUNT) {
+		failed = true;
+		return false;
+	}
+
+	// Resolve the table of global names to the addresses they have in this run.
+	const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	Vector<int> globals;
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+
+		StringName global = _get_string();
+		if (global_map.has(global)) {
+			globals.push_back((GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS) | global_map[global]);
+			continue;
+		}
+#ifdef TOOLS_ENABLED
+		if (GDScriptLanguage::get_singleton()->get_named_globals_map().has(global)) {
+			globals.push_back((GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL << GDScriptFunction::ADDR_BITS) | function->named_globals.size());
+			function->named_globals.push_back(global);
+			continue;
+		}
+#endif
+		error = "Identifier '" + String(global) + "' not declared in the current scope.";
+		return false;
+	}
+
+	count = _get_u32();
+	if (failed || count > uint32_t(data_size - pos) / 4) {
+		failed = true;
+		return false;
+	}
+	function->code.resize(count);
+	int *c = function->code.ptrw();
+	for (uint32_t i = 0; i < count; i++) {
+		c[i] = _get_u32();
+	}
+
+	// The VM only checks indices in debug builds, so everything it indexes with is checked here.
+	int code_size = function->code.size();
+	int member_count = p_script->member_indices.size();
+	Vector<bool> instruction_start;
+	instruction_start.resize(code_size + 1);
+	for (int i = 0; i < code_size; i++) {
+		instruction_start.write[i] = false;
+	}
+	instruction_start.write[code_size] = true; // Jumping to the end returns.
+
+	Vector<int> jumps;
+	Vector<int> operands;
+	int ip = 0;
+	while (ip < code_size) {
+
+		int size = GDScriptOptimizer::get_address_operands(c, ip, code_size, operands);
+		if (size < 0) {
+			failed = true;
+			return false;
+		}
+		instruction_start.write[ip] = true;
+
+		for (int i = 0; i < operands.size(); i++) {
+
+			int address = c[ip + operands[i]];
+			int index = address & GDScriptFunction::ADDR_MASK;
+			bool valid = true;
+
+			switch ((address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+				case GDScriptFunction::ADDR_TYPE_SELF:
+				case GDScriptFunction::ADDR_TYPE_CLASS:
+				case GDScriptFunction::ADDR_TYPE_NIL: {
+				} break;
+				case GDScriptFunction::ADDR_TYPE_MEMBER: {
+					valid = index < member_count;
+				} break;
+				case GDScriptFunction::ADDR_TYPE_CLASS_CONSTANT: {
+					valid = index < function->global_names.size();
+				} break;
+				case GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT: {
+					valid = index < function->constants.size();
+				} break;
+				case GDScriptFunction::ADDR_TYPE_STACK:
+				case GDScriptFunction::ADDR_TYPE_STACK_VARIABLE: {
+					valid = index < function->_stack_size;
+				} break;
+				case GDScriptFunction::ADDR_TYPE_GLOBAL: {
+					valid = index < globals.size();
+					if (valid) {
+						c[ip + operands[i]] = globals[index];
+					}
+				} break;
+				default: {
+					valid = false; // Named globals are saved as globals.
+				} break;
+			}
+
+			if (!valid) {
+				failed = true;
+				return false;
+			}
+		}
+
+		int jump, argc;
+		if (!_check_operands(function, &c[ip], named_cache_count, call_cache_count, jump, argc) || argc > function->_call_size) {
+			failed = true;
+			return false;
+		}
+		if (jump != -1) {
+			jumps.push_back(jump);
+		}
+
+		ip += size;
+	}
+
+	for (int i = 0; i < function->default_arguments.size(); i++) {
+		jumps.push_back(function->default_arguments[i]);
+	}
+	for (int i = 0; i < jumps.size(); i++) {
+		if (jumps[i] < 0 || jumps[i] > code_size || !instruction_start[jumps[i]]) {
+			failed = true;
+			return false;
+		}
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		GDScriptFunction::StackDebug sd;
+		sd.line = _get_u32();
+		sd.pos = _get_u32();
+		sd.added = _get_u32();
+		sd.identifier = _get_string();
+		if (sd.pos < 0 || sd.pos >= function->_stack_size) {
+			failed = true;
+			return false;
+		}
+		function->stack_debug.push_back(sd);
+	}
+
+	if (failed) {
+		return false;
+	}
+
+	// Line info is only worth its cost with the debugger, the code is optimized again without it.
+	if (!ScriptDebugger::get_singleton()) {
+		GDScriptOptimizer optimizer;
+		optimizer.optimize(function->code, function->default_arguments, function->constants, false);
+		function->stack_debug.clear();
+	}
+
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.size() ? function->constants.ptrw() : NULL;
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.size() ? function->global_names.ptr() : NULL;
+#ifdef TOOLS_ENABLED
+	function->_named_globals_count = function->named_globals.size();
+	function->_named_globals_ptr = function->named_globals.size() ? function->named_globals.ptr() : NULL;
+#endif
+	function->_method_bind_count = function->method_binds.size();
+	function->_method_binds_ptr = function->method_binds.size() ? function->method_binds.ptr() : NULL;
+
+	function->named_caches.resize(named_cache_count);
+	for (int i = 0; i < function->named_caches.size(); i++) {
+		function->named_caches.write[i].entry = NULL;
+		function->named_caches.write[i].resolves = 0;
+	}
+	function->_named_cache_count = function->named_caches.size();
+	function->_named_caches_ptr = function->named_caches.size() ? function->named_caches.ptrw() : NULL;
+
+	function->call_caches.resize(call_cache_count);
+	for (int i = 0; i < function->call_caches.size(); i++) {
+		function->call_caches.write[i].entry = NULL;
+		function->call_caches.write[i].resolves = 0;
+	}
+	function->_call_cache_count = function->call_caches.size();
+	function->_call_caches_ptr = function->call_caches.size() ? function->call_caches.ptrw() : NULL;
+
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->code.size() ? function->code.ptr() : NULL;
+	function->_default_arg_count = function->default_arguments.size() ? function->default_arguments.size() - 1 : 0;
+	function->_default_arg_ptr = function->default_arguments.size() ? function->default_arguments.ptr() : NULL;
+
+	function->_script = p_script;
+	function->source = root_path;
+
+#ifdef DEBUG_ENABLED
+	if (ScriptDebugger::get_singleton()) {
+		String signature = root_path + "::" + itos(function->_initial_line);
+		if (p_script->name != String()) {
+			signature += "::" + String(p_script->name) + "." + String(name);
+		} else {
+			signature += "::" + String(name);
+		}
+		function->profile.signature = signature;
+	}
+
+	function->func_cname = (root_path + " - " + String(name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	return true;
+}
+
+bool GDScriptSerializer::_get_class_tree(GDScript *p_script) {
+
+	uint32_t count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+
+		StringName name = _get_string();
+		Ref<GDScript> subclass;
+		subclass.instance();
+		subclass->_owner = p_script;
+		p_script->subclasses.insert(name, subclass);
+
+		if (!_get_class_tree(subclass.ptr())) {
+			return false;
+		}
+	}
+
+	return !failed;
+}
+
+bool GDScriptSerializer::_get_class(GDScript *p_script) {
+
+	p_script->name = _get_string();
+	p_script->tool = _get_u32();
+
+	if (_get_u32()) {
+		Ref<Script> base;
+		if (!_get_script(base)) {
+			return false;
+		}
+		Ref<GDScript> gdbase = base;
+		if (gdbase.is_null()) {
+			error = "Base script is not a GDScript.";
+			return false;
+		}
+		p_script->base = gdbase;
+		p_script->_base = gdbase.ptr();
+	} else {
+		StringName native = _get_string();
+		const Map<StringName, int> &globals = GDScriptLanguage::get_singleton()->get_global_map();
+		if (failed || !globals.has(native)) {
+			error = "Native class '" + String(native) + "' not found.";
+			return false;
+		}
+		p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[globals[native]];
+		if (p_script->native.is_null()) {
+			error = "'" + String(native) + "' is not a native class.";
+			return false;
+		}
+	}
+
+	uint32_t count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		p_script->members.insert(_get_string());
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName name = _get_string();
+		GDScript::MemberInfo minfo;
+		minfo.index = _get_u32();
+		if (minfo.index < 0 || uint32_t(minfo.index) >= count) {
+			// Instances have exactly one member per index, function code relies on that.
+			failed = true;
+			return false;
+		}
+		minfo.setter = _get_string();
+		minfo.getter = _get_string();
+		minfo.rpc_mode = MultiplayerAPI::RPCMode(_get_u32());
+		if (!_get_data_type(minfo.data_type)) {
+			return false;
+		}
+		p_script->member_indices[name] = minfo;
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName name = _get_string();
+		p_script->member_info[name] = _get_property_info();
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName name = _get_string();
+		Variant value;
+		if (!_get_variant(value)) {
+			return false;
+		}
+#ifdef TOOLS_ENABLED
+		p_script->member_default_values[name] = value;
+#endif
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName name = _get_string();
+		int line = _get_u32();
+#ifdef TOOLS_ENABLED
+		p_script->member_lines[name] = line;
+#else
+		(void)line;
+#endif
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName name = _get_string();
+		Variant value;
+		if (!_get_variant(value)) {
+			return false;
+		}
+		p_script->constants[name] = value;
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName name = _get_string();
+		Vector<StringName> arguments;
+		uint32_t argc = _get_u32();
+		for (uint32_t j = 0; j < argc && !failed; j++) {
+			arguments.push_back(_get_string());
+		}
+		p_script->_signals[name] = arguments;
+	}
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		if (!_get_function(p_script)) {
+			return false;
+		}
+	}
+
+	p_script->initializer = p_script->member_functions.has("_init") ? p_script->member_functions["_init"] : NULL;
+
+	count = _get_u32();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		StringName name = _get_string();
+		if (failed || !p_script->subclasses.has(name)) {
+			failed = true;
+			return false;
+		}
+		if (!_get_class(p_script->subclasses[name].ptr())) {
+			return false;
+		}
+	}
+
+	if (failed) {
+		return false;
+	}
+
+	p_script->valid = true;
+	return true;
+}
+
+static const uint8_t serializer_magic[4] = { 'G', 'D', 'S', 'O' };
+
+Vector<uint8_t> GDScriptSerializer::compile_and_save(const String &p_path, const String &p_source, String *r_error) {
+
+	GDScript *script = memnew(GDScript);
+	Ref<GDScript> scriptres(script);
+	script->set_script_path(p_path);
+
+	GDScriptParser parser;
+	Error err = parser.parse(p_source, p_path.get_base_dir(), false, p_path);
+	if (err) {
+		if (r_error) {
+			*r_error = "Parse Error: " + parser.get_error() + " (line " + itos(parser.get_error_line()) + ").";
+		}
+		return Vector<uint8_t>();
+	}
+
+	GDScriptCompiler compiler;
+	compiler.set_keep_debug_info(true);
+	err = compiler.compile(&parser, script);
+	if (err) {
+		if (r_error) {
+			*r_error = "Compile Error: " + compiler.get_error() + " (line " + itos(compiler.get_error_line()) + ").";
+		}
+		return Vector<uint8_t>();
+	}
+
+	return save(script, r_error);
+}
+
+Vector<uint8_t> GDScriptSerializer::save(GDScript *p_script, String *r_error) {
+
+	ERR_FAIL_COND_V(!p_script || !p_script->is_valid(), Vector<uint8_t>());
+
+	GDScriptSerializer s;
+	s.root = p_script;
+	s.root_path = p_script->path;
+
+	const Map<StringName, int> &globals = GDScriptLanguage::get_singleton()->get_global_map();
+	for (const Map<StringName, int>::Element *E = globals.front(); E; E = E->next()) {
+		s.global_names[E->get()] = E->key();
+	}
+
+	for (int i = 0; i < 4; i++) {
+		s.buffer.push_back(serializer_magic[i]);
+	}
+	s._put_u32(FORMAT_VERSION);
+	s._put_string(VERSION_FULL_BUILD);
+	s._put_u32(GDScriptFunction::OPCODE_END);
+	s._put_u32(GDScriptFunction::ADDR_BITS);
+	s._put_u32(Variant::VARIANT_MAX);
+
+	s._put_class_tree(s.root);
+	if (!s._put_class(s.root)) {
+		if (r_error) {
+			*r_error = s.error;
+		}
+		return Vector<uint8_t>();
+	}
+
+	return s.buffer;
+}
+
+Error GDScriptSerializer::load(const Vector<uint8_t> &p_buffer, GDScript *p_script, String *r_error) {
+
+	ERR_FAIL_COND_V(!p_script, ERR_INVALID_PARAMETER);
+
+	GDScriptSerializer s;
+	s.root = p_script;
+	s.root_path = p_script->path;
+	s.data = p_buffer.ptr();
+	s.data_size = p_buffer.size();
+
+	ERR_FAIL_COND_V(s.data_size < 4, ERR_FILE_CORRUPT);
+	for (int i = 0; i < 4; i++) {
+		ERR_FAIL_COND_V(s.data[i] != serializer_magic[i], ERR_FILE_UNRECOGNIZED);
+	}
+	s.pos = 4;
+
+	uint32_t version = s._get_u32();
+	String build = s._get_string();
+	uint32_t opcode_end = s._get_u32();
+	uint32_t addr_bits = s._get_u32();
+	uint32_t variant_max = s._get_u32();
+	ERR_FAIL_COND_V(s.failed, ERR_FILE_CORRUPT);
+	ERR_FAIL_COND_V_MSG(version != FORMAT_VERSION || build != VERSION_FULL_BUILD || opcode_end != GDScriptFunction::OPCODE_END || addr_bits != GDScriptFunction::ADDR_BITS || variant_max != Variant::VARIANT_MAX, ERR_FILE_UNRECOGNIZED,
+			"Compiled script was exported by a different engine build (" + build + "), export the project again.");
+
+	if (!s._get_class_tree(p_script) || !s._get_class(p_script)) {
+		if (r_error) {
+			*r_error = s.error != String() ? s.error : String("Compiled script is corrupt.");
+		}
+		return ERR_FILE_CORRUPT;
+	}
+
+	return OK;
+}
+
+GDScriptSerializer::GDScriptSerializer() {
+
+	root = NULL;
+	data = NULL;
+	data_size = 0;
+	pos = 0;
+	failed = false;
+}
@@ -0,0 +1,107 @@
+/*************************************************************************/
+/*  gdscript_serializer.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_SERIALIZER_H
+#define GDSCRIPT_SERIALIZER_H
+
+#include "gdscript.h"
+
+// Saves fully compiled scripts (bytecode, constants, name tables and class layout) to a binary
+// format that loads without parsing or compiling. Exports use it for the .gdo files. The format
+// is tied to the engine build that wrote it, as it embeds opcode numbers and global indices.
+class GDScriptSerializer {
+
+	enum {
+		FORMAT_VERSION = 1
+	};
+
+	enum VariantKind {
+		VARIANT_VALUE,
+		VARIANT_ARRAY,
+		VARIANT_DICTIONARY,
+		VARIANT_NULL_OBJECT,
+		VARIANT_NATIVE_CLASS,
+		VARIANT_SCRIPT,
+		VARIANT_RESOURCE,
+	};
+
+	enum ScriptKind {
+		SCRIPT_NONE,
+		SCRIPT_OWN, // the script being saved or one of its inner classes
+		SCRIPT_EXTERNAL,
+	};
+
+	GDScript *root;
+	String root_path;
+	String error;
+
+	// Saving.
+	Vector<uint8_t> buffer;
+	Map<int, StringName> global_names; // global array index -> name
+
+	void _put_u32(uint32_t p_value);
+	void _put_string(const String &p_string);
+	bool _put_variant(const Variant &p_variant);
+	bool _put_script(const Ref<Script> &p_script);
+	bool _put_data_type(const GDScriptDataType &p_type);
+	void _put_property_info(const PropertyInfo &p_info);
+	bool _put_function(const GDScriptFunction *p_function);
+	void _put_class_tree(const GDScript *p_script);
+	bool _put_class(const GDScript *p_script);
+
+	// Loading.
+	const uint8_t *data;
+	int data_size;
+	int pos;
+	bool failed;
+
+	uint32_t _get_u32();
+	String _get_string();
+	bool _get_variant(Variant &r_variant);
+	bool _get_script(Ref<Script> &r_script);
+	bool _get_data_type(GDScriptDataType &r_type);
+	PropertyInfo _get_property_info();
+	static bool _check_operands(const GDScriptFunction *p_function, const int *p_code, int p_named_cache_count, int p_call_cache_count, int &r_jump, int &r_argc);
+	bool _get_function(GDScript *p_script);
+	bool _get_class_tree(GDScript *p_script);
+	bool _get_class(GDScript *p_script);
+
+	GDScriptSerializer();
+
+public:
+	// Compiles the source of the script at p_path (keeping debug info) and saves the result.
+	// Returns an empty buffer and sets r_error if the script can't be saved in this format.
+	static Vector<uint8_t> compile_and_save(const String &p_path, const String &p_source, String *r_error = NULL);
+	static Vector<uint8_t> save(GDScript *p_script, String *r_error = NULL);
+	// Fills p_script (a new script with its path set) and its inner classes.
+	static Error load(const Vector<uint8_t> &p_buffer, GDScript *p_script, String *r_error = NULL);
+};
+
+#endif // GDSCRIPT_SERIALIZER_H
@@ -380,6 +380,17 @@ static bool _is_bin(CharType c) {
 	return (c == '0' || c == '1');
 }
 
+// Compares a word of the source with a reserved word, without making a String out of it.
+static _FORCE_INLINE_ bool _is_word(const CharType *p_src, int p_len, const char *p_word) {
+
+	for (int i = 0; i < p_len; i++) {
+		if (p_src[i] != (CharType)p_word[i]) {
+			return false; // also stops at the end of a shorter word
+		}
+	}
+	return p_word[p_len] == 0;
+}
+
 void GDScriptTokenizerText::_make_token(Token p_type) {
 
 	TokenData &tk = tk_rb[tk_rb_pos];
@@ -513,12 +524,9 @@ void GDScriptTokenizerText::_advance() {
 				continue;
 			case '#': { // line comment skip
 #ifdef DEBUG_ENABLED
-				String comment;
+				int comment_from = code_pos;
 #endif // DEBUG_ENABLED
 				while (GETCHAR(0) != '\n') {
-#ifdef DEBUG_ENABLED
-					comment += GETCHAR(0);
-#endif // DEBUG_ENABLED
 					code_pos++;
 					if (GETCHAR(0) == 0) { //end of file
 						//_make_error("Unterminated Comment");
@@ -527,15 +535,23 @@ void GDScriptTokenizerText::_advance() {
 					}
 				}
 #ifdef DEBUG_ENABLED
-				String comment_content = comment.trim_prefix("#").trim_prefix(" ");
-				if (comment_content.begins_with("warning-ignore:")) {
-					String code = comment_content.get_slice(":", 1);
-					warning_skips.push_back(Pair<int, String>(line, code.strip_edges().to_lower()));
-				} else if (comment_content.begins_with("warning-ignore-all:")) {
-					String code = comment_content.get_slice(":", 1);
-					warning_global_skips.insert(code.strip_edges().to_lower());
-				} else if (comment_content.strip_edges() == "warnings-disable") {
-					ignore_warnings = true;
+				// Only comments that can be warning directives are copied out of the code.
+				int word_from = comment_from + 1;
+				while (word_from < code_pos && (_code[word_from] == ' ' || _code[word_from] == '\t')) {
+					word_from++;
+				}
+				if (word_from < code_pos && _code[word_from] == 'w') {
+					String comment = String(&_code[comment_from], code_pos - comment_from);
+					String comment_content = comment.trim_prefix("#").trim_prefix(" ");
+					if (comment_content.begins_with("warning-ignore:")) {
+						String code = comment_content.get_slice(":", 1);
+						warning_skips.push_back(Pair<int, String>(line, code.strip_edges().to_lower()));
+					} else if (comment_content.begins_with("warning-ignore-all:")) {
+						String code = comment_content.get_slice(":", 1);
+						warning_global_skips.insert(code.strip_edges().to_lower());
+					} else if (comment_content.strip_edges() == "warnings-disable") {
+						ignore_warnings = true;
+					}
 				}
 #endif // DEBUG_ENABLED
 				FALLTHROUGH;
@@ -769,16 +785,21 @@ void GDScriptTokenizerText::_advance() {
 				}
 
 				String str;
+				int segment_from = i; // characters without escapes are copied in runs
+				int segment_to = i;
 				while (true) {
 					if (CharType(GETCHAR(i)) == 0) {
 
 						_make_error("Unterminated String");
 						return;
 					} else if (string_mode == STRING_DOUBLE_QUOTE && CharType(GETCHAR(i)) == '"') {
+						segment_to = i;
 						break;
 					} else if (string_mode == STRING_SINGLE_QUOTE && CharType(GETCHAR(i)) == '\'') {
+						segment_to = i;
 						break;
 					} else if (string_mode == STRING_MULTILINE && CharType(GETCHAR(i)) == '\"' && CharType(GETCHAR(i + 1)) == '\"' && CharType(GETCHAR(i + 2)) == '\"') {
+						segment_to = i;
 						i += 2;
 						break;
 					} else if (string_mode != STRING_MULTILINE && CharType(GETCHAR(i)) == '\n') {
@@ -786,10 +807,14 @@ void GDScriptTokenizerText::_advance() {
 						return;
 					} else if (CharType(GETCHAR(i)) == 0xFFFF) {
 						//string ends here, next will be TK
+						segment_to = i;
 						i--;
 						break;
 					} else if (CharType(GETCHAR(i)) == '\\') {
 						//escaped characters...
+						if (i > segment_from) {
+							str += String(&_code[code_pos + segment_from], i - segment_from);
+						}
 						i++;
 						CharType next = GETCHAR(i);
 						if (next == 0) {
@@ -852,17 +877,17 @@ void GDScriptTokenizerText::_advance() {
 						}
 
 						str += res;
+						segment_from = i + 1;
 
-					} else {
-						if (CharType(GETCHAR(i)) == '\n') {
-							line++;
-							column = 1;
-						}
-
-						str += CharType(GETCHAR(i));
+					} else if (CharType(GETCHAR(i)) == '\n') {
+						line++;
+						column = 1;
 					}
 					i++;
 				}
+				if (segment_to > segment_from) {
+					str += String(&_code[code_pos + segment_from], segment_to - segment_from);
+				}
 				INCPOS(i);
 
 				if (is_node_path) {
@@ -885,7 +910,8 @@ void GDScriptTokenizerText::_advance() {
 					bool bin_found = false;
 					bool sign_found = false;
 
-					String str;
+					int digits = 0; // characters of the constant, without the '_' separators
+					CharType last = 0;
 					int i = 0;
 
 					while (true) {
@@ -902,7 +928,7 @@ void GDScriptTokenizerText::_advance() {
 							}
 							period_found = true;
 						} else if (GETCHAR(i) == 'x') {
-							if (hexa_found || bin_found || str.length() != 1 || !((i == 1 && str[0] == '0') || (i == 2 && str[1] == '0' && str[0] == '-'))) {
+							if (hexa_found || bin_found || digits != 1 || i != 1 || GETCHAR(0) != '0') {
 								_make_error("Invalid numeric constant at 'x'");
 								return;
 							}
@@ -910,7 +936,7 @@ void GDScriptTokenizerText::_advance() {
 						} else if (hexa_found && _is_hex(GETCHAR(i))) {
 
 						} else if (!hexa_found && GETCHAR(i) == 'b') {
-							if (bin_found || str.length() != 1 || !((i == 1 && str[0] == '0') || (i == 2 && str[1] == '0' && str[0] == '-'))) {
+							if (bin_found || digits != 1 || i != 1 || GETCHAR(0) != '0') {
 								_make_error("Invalid numeric constant at 'b'");
 								return;
 							}
@@ -938,11 +964,26 @@ void GDScriptTokenizerText::_advance() {
 						} else
 							break;
 
-						str += CharType(GETCHAR(i));
+						last = GETCHAR(i);
+						digits++;
 						i++;
 					}
 
-					if (!(_is_number(str[str.length() - 1]) || (hexa_found && _is_hex(str[str.length() - 1])))) {
+					String str;
+					if (digits == i) {
+						str = String(&_code[code_pos], i);
+					} else {
+						str.resize(digits + 1);
+						CharType *w = str.ptrw();
+						for (int j = 0; j < i; j++) {
+							if (_code[code_pos + j] != '_') {
+								*w++ = _code[code_pos + j];
+							}
+						}
+						*w = 0;
+					}
+
+					if (!(_is_number(last) || (hexa_found && _is_hex(last)))) {
 						_make_error("Invalid numeric constant: " + str);
 						return;
 					}
@@ -973,24 +1014,22 @@ void GDScriptTokenizerText::_advance() {
 
 				if (_is_text_char(GETCHAR(0))) {
 					// parse identifier
-					String str;
-					str += CharType(GETCHAR(0));
-
 					int i = 1;
 					while (_is_text_char(GETCHAR(i))) {
-						str += CharType(GETCHAR(i));
 						i++;
 					}
 
+					// Reserved words are matched in place, only identifiers are copied.
+					const CharType *word = &_code[code_pos];
 					bool identifier = false;
 
-					if (str == "null") {
+					if (_is_word(word, i, "null")) {
 						_make_constant(Variant());
 
-					} else if (str == "true") {
+					} else if (_is_word(word, i, "true")) {
 						_make_constant(true);
 
-					} else if (str == "false") {
+					} else if (_is_word(word, i, "false")) {
 						_make_constant(false);
 					} else {
 
@@ -1002,7 +1041,7 @@ void GDScriptTokenizerText::_advance() {
 
 							while (_type_list[idx].text) {
 
-								if (str == _type_list[idx].text) {
+								if (_is_word(word, i, _type_list[idx].text)) {
 									_make_type(_type_list[idx].type);
 									found = true;
 									break;
@@ -1017,7 +1056,7 @@ void GDScriptTokenizerText::_advance() {
 
 							for (int j = 0; j < GDScriptFunctions::FUNC_MAX; j++) {
 
-								if (str == GDScriptFunctions::get_func_name(GDScriptFunctions::Function(j))) {
+								if (_is_word(word, i, GDScriptFunctions::get_func_name(GDScriptFunctions::Function(j)))) {
 
 									_make_built_in_func(GDScriptFunctions::Function(j));
 									found = true;
@@ -1034,7 +1073,7 @@ void GDScriptTokenizerText::_advance() {
 
 							while (_keyword_list[idx].text) {
 
-								if (str == _keyword_list[idx].text) {
+								if (_is_word(word, i, _keyword_list[idx].text)) {
 									_make_token(_keyword_list[idx].token);
 									found = true;
 									break;
@@ -1048,9 +1087,9 @@ void GDScriptTokenizerText::_advance() {
 					}
 
 					if (identifier) {
-						_make_identifier(str);
+						_make_identifier(String(word, i));
 					}
-					INCPOS(str.length());
+					INCPOS(i);
 					return;
 				}
 
@@ -58,6 +58,8 @@ void GDScriptLanguageServer::thread_main(void *p_userdata) {
 	while (!self->thread_exit) {
 		// Poll 20 times per second
 		self->protocol.poll();
+		// Analyze the documents the client stopped editing, between two polls.
+		self->protocol.get_workspace()->process_queued_scripts(20000);
 		OS::get_singleton()->delay_usec(50000);
 	}
 }
@@ -31,6 +31,7 @@
 #include "gdscript_workspace.h"
 #include "../gdscript.h"
 #include "../gdscript_parser.h"
+#include "core/os/os.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 #include "editor/editor_help.h"
@@ -44,6 +45,7 @@ void GDScriptWorkspace::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_file_uri", "p_path"), &GDScriptWorkspace::get_file_uri);
 	ClassDB::bind_method(D_METHOD("publish_diagnostics", "p_path"), &GDScriptWorkspace::publish_diagnostics);
 	ClassDB::bind_method(D_METHOD("generate_script_api", "p_path"), &GDScriptWorkspace::generate_script_api);
+	ClassDB::bind_method(D_METHOD("get_analysis_stats"), &GDScriptWorkspace::get_analysis_stats);
 }
 
 void GDScriptWorkspace::remove_cache_parser(const String &p_path) {
@@ -141,6 +143,7 @@ void GDScriptWorkspace::list_script_files(const String &p_root_dir, List<String>
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String &p_path) {
+	flush_script(p_path);
 	const Map<String, ExtendGDScriptParser *>::Element *S = scripts.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -153,6 +156,7 @@ ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_result(const String &p_path) {
+	flush_script(p_path);
 	const Map<String, ExtendGDScriptParser *>::Element *S = parse_results.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -304,11 +308,21 @@ Error GDScriptWorkspace::initialize() {
 
 Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_content) {
 
-	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
-	Error err = parser->parse(p_content, p_path);
+	uint32_t hash = p_content.hash();
 	Map<String, ExtendGDScriptParser *>::Element *last_parser = parse_results.find(p_path);
 	Map<String, ExtendGDScriptParser *>::Element *last_script = scripts.find(p_path);
 
+	const Map<String, ParsedContent>::Element *C = parsed_contents.find(p_path);
+	if (C && C->get().hash == hash && last_parser && C->get().text == p_content) {
+		// Same text as the last time, e.g. the document being opened after the workspace scan.
+		parse_skip_count++;
+		return (last_script && last_script->get() == last_parser->get()) ? OK : ERR_PARSE_ERROR;
+	}
+
+	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
+	Error err = parser->parse(p_content, p_path);
+	parse_count++;
+
 	if (err == OK) {
 
 		remove_cache_parser(p_path);
@@ -321,12 +335,124 @@ Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_cont
 		}
 		parse_results[p_path] = parser;
 	}
+	ParsedContent &parsed = parsed_contents[p_path];
+	parsed.text = p_content;
+	parsed.hash = hash;
 
 	publish_diagnostics(p_path);
 
+	if (err == OK) {
+		update_dependencies(p_path, parser);
+	}
+
 	return err;
 }
 
+void GDScriptWorkspace::update_dependencies(const String &p_path, const ExtendGDScriptParser *p_parser) {
+
+	Map<String, List<String> >::Element *D = dependencies.find(p_path);
+	if (D) {
+		for (List<String>::Element *E = D->get().front(); E; E = E->next()) {
+			if (Map<String, Set<String> >::Element *S = dependents.find(E->get())) {
+				S->get().erase(p_path);
+			}
+		}
+	}
+
+	List<String> &script_dependencies = dependencies[p_path];
+	script_dependencies.clear();
+	for (const List<String>::Element *E = p_parser->get_dependencies().front(); E; E = E->next()) {
+		if (E->get().get_extension() == "gd" && E->get() != p_path) {
+			script_dependencies.push_back(E->get());
+			dependents[E->get()].insert(p_path);
+		}
+	}
+
+	// Order independent, the members are in a hash map.
+	uint32_t members_hash = 0;
+	const ClassMembers &members = p_parser->get_members();
+	for (const String *name = members.next(NULL); name; name = members.next(name)) {
+		members_hash += hash_djb2_one_32(members.get(*name)->detail.hash(), name->hash());
+	}
+
+	Map<String, uint32_t>::Element *H = symbol_hashes.find(p_path);
+	bool changed = H && H->get() != members_hash;
+	symbol_hashes[p_path] = members_hash;
+
+	Map<String, Set<String> >::Element *S = dependents.find(p_path);
+	if (!changed || !S) {
+		return;
+	}
+
+	// Analyze again the scripts using this one, from the text they were last analyzed with.
+	for (Set<String>::Element *E = S->get().front(); E; E = E->next()) {
+		Map<String, ExtendGDScriptParser *>::Element *P = parse_results.find(E->get());
+		if (P && !queued_scripts.has(E->get())) {
+			parsed_contents.erase(E->get());
+			queue_script(E->get(), String("\n").join(P->get()->get_lines()));
+		}
+	}
+}
+
+void GDScriptWorkspace::queue_script(const String &p_path, const String &p_content) {
+
+	QueuedScript &queued = queued_scripts[p_path];
+	queued.content = p_content;
+	queued.changed_usec = OS::get_singleton()->get_ticks_usec();
+}
+
+void GDScriptWorkspace::flush_script(const String &p_path) {
+
+	Map<String, QueuedScript>::Element *E = queued_scripts.find(p_path);
+	if (E) {
+		String content = E->get().content;
+		queued_scripts.erase(E);
+		parse_script(p_path, content);
+	}
+}
+
+void GDScriptWorkspace::process_queued_scripts(uint64_t p_max_usec) {
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+
+	List<String> ready;
+	for (Map<String, QueuedScript>::Element *E = queued_scripts.front(); E; E = E->next()) {
+		if (from - E->get().changed_usec >= ANALYSIS_DELAY_USEC) {
+			ready.push_back(E->key());
+		}
+	}
+
+	for (List<String>::Element *E = ready.front(); E; E = E->next()) {
+		flush_script(E->get());
+		if (OS::get_singleton()->get_ticks_usec() - from >= p_max_usec) {
+			break; // let the next poll answer the client first
+		}
+	}
+}
+
+void GDScriptWorkspace::add_completion_time(uint64_t p_usec, uint64_t p_analysis_usec) {
+
+	completion_count++;
+	completion_usec += p_usec;
+	completion_analysis_usec += p_analysis_usec;
+	completion_max_usec = MAX(completion_max_usec, p_usec);
+
+	print_verbose("GDScript LSP: Completion took " + rtos(p_usec / 1000.0) + " msec, " + rtos(p_analysis_usec / 1000.0) + " msec of it analyzing pending changes.");
+}
+
+Dictionary GDScriptWorkspace::get_analysis_stats() const {
+
+	Dictionary stats;
+	stats["parses"] = parse_count;
+	stats["parses_skipped"] = parse_skip_count;
+	stats["queued_scripts"] = queued_scripts.size();
+	stats["completions"] = completion_count;
+	stats["completion_avg_msec"] = completion_count ? completion_usec / 1000.0 / completion_count : 0.0;
+	stats["completion_max_msec"] = completion_max_usec / 1000.0;
+	stats["completion_analysis_avg_msec"] = completion_count ? completion_analysis_usec / 1000.0 / completion_count : 0.0;
+	return stats;
+}
+
 Error GDScriptWorkspace::parse_local_script(const String &p_path) {
 	Error err;
 	String content = FileAccess::get_file_as_string(p_path, &err);
@@ -371,10 +497,16 @@ void GDScriptWorkspace::completion(const lsp::CompletionParams &p_params, List<S
 	String call_hint;
 	bool forced = false;
 
-	if (const ExtendGDScriptParser *parser = get_parse_result(path)) {
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	const ExtendGDScriptParser *parser = get_parse_result(path);
+	uint64_t analysis_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	if (parser) {
 		String code = parser->get_text_for_completion(p_params.position);
 		GDScriptLanguage::get_singleton()->complete_code(code, path, NULL, r_options, forced, call_hint);
 	}
+
+	add_completion_time(OS::get_singleton()->get_ticks_usec() - from, analysis_usec);
 }
 
 const lsp::DocumentSymbol *GDScriptWorkspace::resolve_symbol(const lsp::TextDocumentPositionParams &p_doc_pos, const String &p_symbol_name, bool p_func_requred) {
@@ -515,6 +647,13 @@ Dictionary GDScriptWorkspace::generate_script_api(const String &p_path) {
 
 GDScriptWorkspace::GDScriptWorkspace() {
 	ProjectSettings::get_singleton()->get_resource_path();
+
+	parse_count = 0;
+	parse_skip_count = 0;
+	completion_count = 0;
+	completion_usec = 0;
+	completion_max_usec = 0;
+	completion_analysis_usec = 0;
 }
 
 GDScriptWorkspace::~GDScriptWorkspace() {
@@ -55,6 +55,38 @@ protected:
 
 	void list_script_files(const String &p_root_dir, List<String> &r_files);
 
+	// Changed documents are analyzed once the client leaves them alone for a moment, or right away
+	// when a request needs them, so a burst of edits costs a single parse.
+	enum {
+		ANALYSIS_DELAY_USEC = 300000
+	};
+
+	struct QueuedScript {
+		String content;
+		uint64_t changed_usec;
+	};
+
+	// The content each cached parse result comes from. The hash only saves comparing texts that differ.
+	struct ParsedContent {
+		String text;
+		uint32_t hash;
+	};
+
+	Map<String, QueuedScript> queued_scripts;
+	Map<String, ParsedContent> parsed_contents;
+	Map<String, uint32_t> symbol_hashes; // of the members of each script, to know when dependents need updating
+	Map<String, List<String> > dependencies; // scripts each script extends or preloads
+	Map<String, Set<String> > dependents;
+
+	uint64_t parse_count;
+	uint64_t parse_skip_count;
+	uint64_t completion_count;
+	uint64_t completion_usec;
+	uint64_t completion_max_usec;
+	uint64_t completion_analysis_usec;
+
+	void update_dependencies(const String &p_path, const ExtendGDScriptParser *p_parser);
+
 public:
 	String root;
 	String root_uri;
@@ -72,6 +104,13 @@ public:
 	Error parse_script(const String &p_path, const String &p_content);
 	Error parse_local_script(const String &p_path);
 
+	void queue_script(const String &p_path, const String &p_content);
+	void flush_script(const String &p_path);
+	void process_queued_scripts(uint64_t p_max_usec);
+
+	void add_completion_time(uint64_t p_usec, uint64_t p_analysis_usec);
+	Dictionary get_analysis_stats() const;
+
 	String get_file_path(const String &p_uri) const;
 	String get_file_uri(const String &p_path) const;
 
@@ -35,6 +35,7 @@
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "gdscript.h"
+#include "gdscript_serializer.h"
 #include "gdscript_tokenizer.h"
 
 GDScriptLanguage *script_language_gd = NULL;
@@ -79,6 +80,20 @@ public:
 
 		String txt;
 		txt.parse_utf8((const char *)file.ptr(), file.size());
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_PRECOMPILED) {
+
+			String error;
+			Vector<uint8_t> compiled = GDScriptSerializer::compile_and_save(p_path, txt, &error);
+			if (!compiled.empty()) {
+				add_file(p_path.get_basename() + ".gdo", compiled, true);
+				return;
+			}
+
+			// Scripts holding constants that can't be saved fall back to compiled tokens.
+			WARN_PRINTS("Cannot precompile script '" + p_path + "', exporting it as compiled tokens: " + error);
+		}
+
 		file = GDScriptTokenizerBuffer::parse_code_string(txt);
 
 		if (!file.empty()) {
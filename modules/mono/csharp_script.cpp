@@ -36,6 +36,7 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/os/thread.h"
+#include "core/os/thread_local.h"
 #include "core/project_settings.h"
 
 #ifdef TOOLS_ENABLED
@@ -58,7 +59,6 @@
 #include "utils/macros.h"
 #include "utils/mutex_utils.h"
 #include "utils/string_utils.h"
-#include "utils/thread_local.h"
 
 #define CACHED_STRING_NAME(m_var) (CSharpLanguage::get_singleton()->get_string_names().m_var)
 
@@ -33,11 +33,12 @@
 #include "../csharp_script.h"
 #include "../mono_gc_handle.h"
 #include "../utils/macros.h"
-#include "../utils/thread_local.h"
 #include "gd_mono_class.h"
 #include "gd_mono_marshal.h"
 #include "gd_mono_utils.h"
 
+#include "core/os/thread_local.h"
+
 #include <mono/metadata/exception.h>
 
 namespace GDMonoInternals {
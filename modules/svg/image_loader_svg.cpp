@@ -45,8 +45,6 @@ SVGRasterizer::~SVGRasterizer() {
 	nsvgDeleteRasterizer(rasterizer);
 }
 
-SVGRasterizer ImageLoaderSVG::rasterizer;
-
 inline void change_nsvg_paint_color(NSVGpaint *p_paint, const uint32_t p_old, const uint32_t p_new) {
 
 	if (p_paint->type == NSVG_PAINT_COLOR) {
@@ -119,6 +117,9 @@ Error ImageLoaderSVG::_create_image(Ref<Image> p_image, const PoolVector<uint8_t
 
 	PoolVector<uint8_t>::Write dw = dst_image.write();
 
+	// nsvgRasterize() keeps its work buffers in the rasterizer, so each image gets its own
+	// rasterizer and textures can be imported on several threads at once.
+	SVGRasterizer rasterizer;
 	rasterizer.rasterize(svg_image, 0, 0, p_scale * upscale, (unsigned char *)dw.ptr(), w, h, w * 4);
 
 	dw.release();
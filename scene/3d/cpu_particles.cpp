@@ -30,6 +30,7 @@
 
 #include "cpu_particles.h"
 
+#include "core/math/math_batch.h"
 #include "scene/3d/camera.h"
 #include "scene/3d/particles.h"
 #include "scene/resources/particles_material.h"
@@ -1066,13 +1067,10 @@ void CPUParticles::_update_particle_data_buffer() {
 
 			int idx = order ? order[i] : i;
 
-			Transform t = r[idx].transform;
-
-			if (!local_coords) {
-				t = inv_emission_transform * t;
-			}
-
-			if (r[idx].active) {
+			if (r[idx].active && !local_coords) {
+				MathBatch::xform_to_rows(inv_emission_transform, r[idx].transform, ptr);
+			} else if (r[idx].active) {
+				const Transform &t = r[idx].transform;
 				ptr[0] = t.basis.elements[0][0];
 				ptr[1] = t.basis.elements[0][1];
 				ptr[2] = t.basis.elements[0][2];
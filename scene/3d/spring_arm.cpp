@@ -138,8 +138,8 @@ float SpringArm::get_hit_length() {
 
 void SpringArm::process_spring() {
 	// From
-	real_t motion_delta(1);
-	real_t motion_delta_unsafe(1);
+	float motion_delta(1);
+	float motion_delta_unsafe(1);
 
 	Vector3 motion;
 	const Vector3 cast_direction(get_global_transform().basis.xform(Vector3(0, 0, 1)));
@@ -311,6 +311,7 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 				TrackNodeCache::PropertyAnim pa;
 				pa.subpath = leftover_path;
 				pa.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
+				pa.handle = pa.object->get_property_handle(leftover_path);
 				pa.special = SP_NONE;
 				pa.owner = p_anim->node_cache[i];
 				if (false && p_anim->node_cache[i]->node_2d) {
@@ -333,6 +334,7 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 				TrackNodeCache::BezierAnim ba;
 				ba.bezier_property = leftover_path;
 				ba.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
+				ba.handle = ba.object->get_property_handle(leftover_path);
 				ba.owner = p_anim->node_cache[i];
 
 				p_anim->node_cache[i]->bezier_anim[a->track_get_path(i).get_concatenated_subnames()] = ba;
@@ -418,7 +420,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				if (update_mode == Animation::UPDATE_CAPTURE) {
 
 					if (p_started) {
-						pa->capture = pa->object->get_indexed(pa->subpath);
+						pa->capture = pa->object->get_by_handle(pa->handle);
 					}
 
 					int key_count = a->track_get_key_count(i);
@@ -490,7 +492,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 							case SP_NONE: {
 								bool valid;
-								pa->object->set_indexed(pa->subpath, value, &valid); //you are not speshul
+								pa->object->set_by_handle(pa->handle, value, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
 								if (!valid) {
 									ERR_PRINTS("Failed setting track value '" + String(pa->owner->path) + "'. Check if property exists or the type of key is valid. Animation '" + a->get_name() + "' at node '" + get_path() + "'.");
@@ -881,7 +883,7 @@ void AnimationPlayer::_animation_update_transforms() {
 
 			case SP_NONE: {
 				bool valid;
-				pa->object->set_indexed(pa->subpath, pa->value_accum, &valid); //you are not speshul
+				pa->object->set_by_handle(pa->handle, pa->value_accum, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					ERR_PRINTS("Failed setting key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "'. Check if property exists or the type of key is right for the property");
@@ -925,7 +927,7 @@ void AnimationPlayer::_animation_update_transforms() {
 		TrackNodeCache::BezierAnim *ba = cache_update_bezier[i];
 
 		ERR_CONTINUE(ba->accum_pass != accum_pass);
-		ba->object->set_indexed(ba->bezier_property, ba->bezier_accum);
+		ba->object->set_by_handle(ba->handle, ba->bezier_accum);
 	}
 
 	cache_update_bezier_size = 0;
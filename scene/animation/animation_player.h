@@ -112,6 +112,7 @@ private:
 			TrackNodeCache *owner;
 			SpecialProperty special; //small optimization
 			Vector<StringName> subpath;
+			Object::PropertyHandle handle;
 			Object *object;
 			Variant value_accum;
 			uint64_t accum_pass;
@@ -129,6 +130,7 @@ private:
 		struct BezierAnim {
 
 			Vector<StringName> bezier_property;
+			Object::PropertyHandle handle;
 			TrackNodeCache *owner;
 			float bezier_accum;
 			Object *object;
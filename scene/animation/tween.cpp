@@ -599,7 +599,7 @@ bool Tween::_apply_tween_value(InterpolateData &p_data, Variant &value) {
 		case TARGETING_PROPERTY: {
 			// Simply set the property on the object
 			bool valid = false;
-			object->set_indexed(p_data.key, value, &valid);
+			object->set_by_handle(p_data.key_handle, value, &valid);
 			return valid;
 		}
 
@@ -1258,6 +1258,7 @@ bool Tween::_build_interpolation(InterpolateType p_interpolation_type, Object *p
 		ERR_FAIL_COND_V_MSG(!prop_valid, false, "Tween target object has no property named: " + p_property->get_concatenated_subnames() + ".");
 
 		data.key = p_property->get_subnames();
+		data.key_handle = p_object->get_property_handle(data.key);
 		data.concatenated_key = p_property->get_concatenated_subnames();
 	}
 
@@ -1495,6 +1496,7 @@ bool Tween::follow_property(Object *p_object, NodePath p_property, Variant p_ini
 	// Give the InterpolateData it's configuration
 	data.id = p_object->get_instance_id();
 	data.key = p_property.get_subnames();
+	data.key_handle = p_object->get_property_handle(data.key);
 	data.concatenated_key = p_property.get_concatenated_subnames();
 	data.initial_val = p_initial_val;
 	data.target_id = p_target->get_instance_id();
@@ -1623,6 +1625,7 @@ bool Tween::targeting_property(Object *p_object, NodePath p_property, Object *p_
 	// Give the data it's configuration
 	data.id = p_object->get_instance_id();
 	data.key = p_property.get_subnames();
+	data.key_handle = p_object->get_property_handle(data.key);
 	data.concatenated_key = p_property.get_concatenated_subnames();
 	data.target_id = p_initial->get_instance_id();
 	data.target_key = p_initial_property.get_subnames();
@@ -88,6 +88,7 @@ private:
 		real_t elapsed;
 		ObjectID id;
 		Vector<StringName> key;
+		Object::PropertyHandle key_handle;
 		StringName concatenated_key;
 		Variant initial_val;
 		Variant delta_val;
@@ -584,18 +584,24 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 				size = f->get_32();
 			}
 
-			PoolVector<uint8_t> pv;
-			pv.resize(size);
-			{
-				PoolVector<uint8_t>::Write w = pv.write();
-				f->get_buffer(w.ptr(), size);
-			}
-
 			Ref<Image> img;
-			if (df & FORMAT_BIT_LOSSLESS) {
-				img = Image::lossless_unpacker(pv);
+			const uint8_t *view = f->get_buffer_view(size);
+			if (view) {
+				//decode in place, no need to copy
+				img = Image::unpack_from_memory(view, size);
 			} else {
-				img = Image::lossy_unpacker(pv);
+				PoolVector<uint8_t> pv;
+				pv.resize(size);
+				{
+					PoolVector<uint8_t>::Write w = pv.write();
+					f->get_buffer(w.ptr(), size);
+				}
+
+				if (df & FORMAT_BIT_LOSSLESS) {
+					img = Image::lossless_unpacker(pv);
+				} else {
+					img = Image::lossy_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->empty()) {
@@ -2410,14 +2416,21 @@ RES ResourceFormatLoaderTextureLayered::load(const String &p_path, const String
 			for (int i = 0; i < mipmaps; i++) {
 				uint32_t size = f->get_32();
 
-				PoolVector<uint8_t> pv;
-				pv.resize(size);
-				{
-					PoolVector<uint8_t>::Write w = pv.write();
-					f->get_buffer(w.ptr(), size);
-				}
+				Ref<Image> img;
+				const uint8_t *view = f->get_buffer_view(size);
+				if (view) {
+					//decode in place, no need to copy
+					img = Image::unpack_from_memory(view, size);
+				} else {
+					PoolVector<uint8_t> pv;
+					pv.resize(size);
+					{
+						PoolVector<uint8_t>::Write w = pv.write();
+						f->get_buffer(w.ptr(), size);
+					}
 
-				Ref<Image> img = Image::lossless_unpacker(pv);
+					img = Image::lossless_unpacker(pv);
+				}
 
 				if (img.is_null() || img->empty() || format != img->get_format()) {
 					if (r_error) {
@@ -395,13 +395,13 @@ public:
 	real_t step;
 
 	virtual Vector3 get_total_gravity() const { return body->gravity; } // get gravity vector working on this body space/area
-	virtual real_t get_total_angular_damp() const { return body->area_angular_damp; } // get density of this body space/area
-	virtual real_t get_total_linear_damp() const { return body->area_linear_damp; } // get density of this body space/area
+	virtual float get_total_angular_damp() const { return body->area_angular_damp; } // get density of this body space/area
+	virtual float get_total_linear_damp() const { return body->area_linear_damp; } // get density of this body space/area
 
 	virtual Vector3 get_center_of_mass() const { return body->get_center_of_mass(); }
 	virtual Basis get_principal_inertia_axes() const { return body->get_principal_inertia_axes(); }
 
-	virtual real_t get_inverse_mass() const { return body->get_inv_mass(); } // get the mass
+	virtual float get_inverse_mass() const { return body->get_inv_mass(); } // get the mass
 	virtual Vector3 get_inverse_inertia() const { return body->get_inv_inertia(); } // get density of this body space
 	virtual Basis get_inverse_inertia_tensor() const { return body->get_inv_inertia_tensor(); } // get density of this body space
 
@@ -695,7 +695,7 @@ uint32_t PhysicsServerSW::body_get_user_flags(RID p_body) const {
 	return 0;
 };
 
-void PhysicsServerSW::body_set_param(RID p_body, BodyParameter p_param, real_t p_value) {
+void PhysicsServerSW::body_set_param(RID p_body, BodyParameter p_param, float p_value) {
 
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -703,7 +703,7 @@ void PhysicsServerSW::body_set_param(RID p_body, BodyParameter p_param, real_t p
 	body->set_param(p_param, p_value);
 };
 
-real_t PhysicsServerSW::body_get_param(RID p_body, BodyParameter p_param) const {
+float PhysicsServerSW::body_get_param(RID p_body, BodyParameter p_param) const {
 
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -888,13 +888,13 @@ void PhysicsServerSW::body_get_collision_exceptions(RID p_body, List<RID> *p_exc
 	}
 };
 
-void PhysicsServerSW::body_set_contacts_reported_depth_threshold(RID p_body, real_t p_threshold) {
+void PhysicsServerSW::body_set_contacts_reported_depth_threshold(RID p_body, float p_threshold) {
 
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
 };
 
-real_t PhysicsServerSW::body_get_contacts_reported_depth_threshold(RID p_body) const {
+float PhysicsServerSW::body_get_contacts_reported_depth_threshold(RID p_body) const {
 
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -1008,7 +1008,7 @@ RID PhysicsServerSW::joint_create_pin(RID p_body_A, const Vector3 &p_local_A, RI
 	return rid;
 }
 
-void PhysicsServerSW::pin_joint_set_param(RID p_joint, PinJointParam p_param, real_t p_value) {
+void PhysicsServerSW::pin_joint_set_param(RID p_joint, PinJointParam p_param, float p_value) {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND(!joint);
@@ -1016,7 +1016,7 @@ void PhysicsServerSW::pin_joint_set_param(RID p_joint, PinJointParam p_param, re
 	PinJointSW *pin_joint = static_cast<PinJointSW *>(joint);
 	pin_joint->set_param(p_param, p_value);
 }
-real_t PhysicsServerSW::pin_joint_get_param(RID p_joint, PinJointParam p_param) const {
+float PhysicsServerSW::pin_joint_get_param(RID p_joint, PinJointParam p_param) const {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND_V(!joint, 0);
@@ -1101,7 +1101,7 @@ RID PhysicsServerSW::joint_create_hinge_simple(RID p_body_A, const Vector3 &p_pi
 	return rid;
 }
 
-void PhysicsServerSW::hinge_joint_set_param(RID p_joint, HingeJointParam p_param, real_t p_value) {
+void PhysicsServerSW::hinge_joint_set_param(RID p_joint, HingeJointParam p_param, float p_value) {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND(!joint);
@@ -1109,7 +1109,7 @@ void PhysicsServerSW::hinge_joint_set_param(RID p_joint, HingeJointParam p_param
 	HingeJointSW *hinge_joint = static_cast<HingeJointSW *>(joint);
 	hinge_joint->set_param(p_param, p_value);
 }
-real_t PhysicsServerSW::hinge_joint_get_param(RID p_joint, HingeJointParam p_param) const {
+float PhysicsServerSW::hinge_joint_get_param(RID p_joint, HingeJointParam p_param) const {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND_V(!joint, 0);
@@ -1204,7 +1204,7 @@ RID PhysicsServerSW::joint_create_slider(RID p_body_A, const Transform &p_local_
 	return rid;
 }
 
-void PhysicsServerSW::slider_joint_set_param(RID p_joint, SliderJointParam p_param, real_t p_value) {
+void PhysicsServerSW::slider_joint_set_param(RID p_joint, SliderJointParam p_param, float p_value) {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND(!joint);
@@ -1212,7 +1212,7 @@ void PhysicsServerSW::slider_joint_set_param(RID p_joint, SliderJointParam p_par
 	SliderJointSW *slider_joint = static_cast<SliderJointSW *>(joint);
 	slider_joint->set_param(p_param, p_value);
 }
-real_t PhysicsServerSW::slider_joint_get_param(RID p_joint, SliderJointParam p_param) const {
+float PhysicsServerSW::slider_joint_get_param(RID p_joint, SliderJointParam p_param) const {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND_V(!joint, 0);
@@ -1242,7 +1242,7 @@ RID PhysicsServerSW::joint_create_cone_twist(RID p_body_A, const Transform &p_lo
 	return rid;
 }
 
-void PhysicsServerSW::cone_twist_joint_set_param(RID p_joint, ConeTwistJointParam p_param, real_t p_value) {
+void PhysicsServerSW::cone_twist_joint_set_param(RID p_joint, ConeTwistJointParam p_param, float p_value) {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND(!joint);
@@ -1250,7 +1250,7 @@ void PhysicsServerSW::cone_twist_joint_set_param(RID p_joint, ConeTwistJointPara
 	ConeTwistJointSW *cone_twist_joint = static_cast<ConeTwistJointSW *>(joint);
 	cone_twist_joint->set_param(p_param, p_value);
 }
-real_t PhysicsServerSW::cone_twist_joint_get_param(RID p_joint, ConeTwistJointParam p_param) const {
+float PhysicsServerSW::cone_twist_joint_get_param(RID p_joint, ConeTwistJointParam p_param) const {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND_V(!joint, 0);
@@ -1280,7 +1280,7 @@ RID PhysicsServerSW::joint_create_generic_6dof(RID p_body_A, const Transform &p_
 	return rid;
 }
 
-void PhysicsServerSW::generic_6dof_joint_set_param(RID p_joint, Vector3::Axis p_axis, G6DOFJointAxisParam p_param, real_t p_value) {
+void PhysicsServerSW::generic_6dof_joint_set_param(RID p_joint, Vector3::Axis p_axis, G6DOFJointAxisParam p_param, float p_value) {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND(!joint);
@@ -1288,7 +1288,7 @@ void PhysicsServerSW::generic_6dof_joint_set_param(RID p_joint, Vector3::Axis p_
 	Generic6DOFJointSW *generic_6dof_joint = static_cast<Generic6DOFJointSW *>(joint);
 	generic_6dof_joint->set_param(p_axis, p_param, p_value);
 }
-real_t PhysicsServerSW::generic_6dof_joint_get_param(RID p_joint, Vector3::Axis p_axis, G6DOFJointAxisParam p_param) {
+float PhysicsServerSW::generic_6dof_joint_get_param(RID p_joint, Vector3::Axis p_axis, G6DOFJointAxisParam p_param) {
 
 	JointSW *joint = joint_owner.get(p_joint);
 	ERR_FAIL_COND_V(!joint, 0);
@@ -1415,7 +1415,7 @@ void PhysicsServerSW::init() {
 	direct_state = memnew(PhysicsDirectBodyStateSW);
 };
 
-void PhysicsServerSW::step(real_t p_step) {
+void PhysicsServerSW::step(float p_step) {
 
 #ifndef _3D_DISABLED
 
@@ -818,7 +818,7 @@ uint32_t Physics2DServerSW::body_get_collision_mask(RID p_body) const {
 	return body->get_collision_mask();
 };
 
-void Physics2DServerSW::body_set_param(RID p_body, BodyParameter p_param, real_t p_value) {
+void Physics2DServerSW::body_set_param(RID p_body, BodyParameter p_param, float p_value) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -826,7 +826,7 @@ void Physics2DServerSW::body_set_param(RID p_body, BodyParameter p_param, real_t
 	body->set_param(p_param, p_value);
 };
 
-real_t Physics2DServerSW::body_get_param(RID p_body, BodyParameter p_param) const {
+float Physics2DServerSW::body_get_param(RID p_body, BodyParameter p_param) const {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -866,7 +866,7 @@ Vector2 Physics2DServerSW::body_get_applied_force(RID p_body) const {
 	return body->get_applied_force();
 };
 
-void Physics2DServerSW::body_set_applied_torque(RID p_body, real_t p_torque) {
+void Physics2DServerSW::body_set_applied_torque(RID p_body, float p_torque) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -875,7 +875,7 @@ void Physics2DServerSW::body_set_applied_torque(RID p_body, real_t p_torque) {
 	body->wakeup();
 };
 
-real_t Physics2DServerSW::body_get_applied_torque(RID p_body) const {
+float Physics2DServerSW::body_get_applied_torque(RID p_body) const {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -891,7 +891,7 @@ void Physics2DServerSW::body_apply_central_impulse(RID p_body, const Vector2 &p_
 	body->wakeup();
 }
 
-void Physics2DServerSW::body_apply_torque_impulse(RID p_body, real_t p_torque) {
+void Physics2DServerSW::body_apply_torque_impulse(RID p_body, float p_torque) {
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
 
@@ -928,7 +928,7 @@ void Physics2DServerSW::body_add_force(RID p_body, const Vector2 &p_offset, cons
 	body->wakeup();
 };
 
-void Physics2DServerSW::body_add_torque(RID p_body, real_t p_torque) {
+void Physics2DServerSW::body_add_torque(RID p_body, float p_torque) {
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
 
@@ -979,13 +979,13 @@ void Physics2DServerSW::body_get_collision_exceptions(RID p_body, List<RID> *p_e
 	}
 };
 
-void Physics2DServerSW::body_set_contacts_reported_depth_threshold(RID p_body, real_t p_threshold) {
+void Physics2DServerSW::body_set_contacts_reported_depth_threshold(RID p_body, float p_threshold) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
 };
 
-real_t Physics2DServerSW::body_get_contacts_reported_depth_threshold(RID p_body) const {
+float Physics2DServerSW::body_get_contacts_reported_depth_threshold(RID p_body) const {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -1044,7 +1044,7 @@ void Physics2DServerSW::body_set_pickable(RID p_body, bool p_pickable) {
 	body->set_pickable(p_pickable);
 }
 
-bool Physics2DServerSW::body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, MotionResult *r_result, bool p_exclude_raycast_shapes) {
+bool Physics2DServerSW::body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, float p_margin, MotionResult *r_result, bool p_exclude_raycast_shapes) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, false);
@@ -1324,7 +1324,7 @@ void Physics2DServerSW::init() {
 	direct_state = memnew(Physics2DDirectBodyStateSW);
 };
 
-void Physics2DServerSW::step(real_t p_step) {
+void Physics2DServerSW::step(float p_step) {
 
 	if (!active)
 		return;
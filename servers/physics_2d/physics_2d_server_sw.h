@@ -209,8 +209,8 @@ public:
 	virtual void body_set_collision_mask(RID p_body, uint32_t p_mask);
 	virtual uint32_t body_get_collision_mask(RID p_body) const;
 
-	virtual void body_set_param(RID p_body, BodyParameter p_param, real_t p_value);
-	virtual real_t body_get_param(RID p_body, BodyParameter p_param) const;
+	virtual void body_set_param(RID p_body, BodyParameter p_param, float p_value);
+	virtual float body_get_param(RID p_body, BodyParameter p_param) const;
 
 	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant);
 	virtual Variant body_get_state(RID p_body, BodyState p_state) const;
@@ -218,15 +218,15 @@ public:
 	virtual void body_set_applied_force(RID p_body, const Vector2 &p_force);
 	virtual Vector2 body_get_applied_force(RID p_body) const;
 
-	virtual void body_set_applied_torque(RID p_body, real_t p_torque);
-	virtual real_t body_get_applied_torque(RID p_body) const;
+	virtual void body_set_applied_torque(RID p_body, float p_torque);
+	virtual float body_get_applied_torque(RID p_body) const;
 
 	virtual void body_add_central_force(RID p_body, const Vector2 &p_force);
 	virtual void body_add_force(RID p_body, const Vector2 &p_offset, const Vector2 &p_force);
-	virtual void body_add_torque(RID p_body, real_t p_torque);
+	virtual void body_add_torque(RID p_body, float p_torque);
 
 	virtual void body_apply_central_impulse(RID p_body, const Vector2 &p_impulse);
-	virtual void body_apply_torque_impulse(RID p_body, real_t p_torque);
+	virtual void body_apply_torque_impulse(RID p_body, float p_torque);
 	virtual void body_apply_impulse(RID p_body, const Vector2 &p_pos, const Vector2 &p_impulse);
 	virtual void body_set_axis_velocity(RID p_body, const Vector2 &p_axis_velocity);
 
@@ -234,8 +234,8 @@ public:
 	virtual void body_remove_collision_exception(RID p_body, RID p_body_b);
 	virtual void body_get_collision_exceptions(RID p_body, List<RID> *p_exceptions);
 
-	virtual void body_set_contacts_reported_depth_threshold(RID p_body, real_t p_threshold);
-	virtual real_t body_get_contacts_reported_depth_threshold(RID p_body) const;
+	virtual void body_set_contacts_reported_depth_threshold(RID p_body, float p_threshold);
+	virtual float body_get_contacts_reported_depth_threshold(RID p_body) const;
 
 	virtual void body_set_omit_force_integration(RID p_body, bool p_omit);
 	virtual bool body_is_omitting_force_integration(RID p_body) const;
@@ -248,7 +248,7 @@ public:
 
 	virtual void body_set_pickable(RID p_body, bool p_pickable);
 
-	virtual bool body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin = 0.001, MotionResult *r_result = NULL, bool p_exclude_raycast_shapes = true);
+	virtual bool body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, float p_margin = 0.001, MotionResult *r_result = NULL, bool p_exclude_raycast_shapes = true);
 	virtual int body_test_ray_separation(RID p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin = 0.001);
 
 	// this function only works on physics process, errors and returns null otherwise
@@ -278,7 +278,7 @@ public:
 
 	virtual void set_active(bool p_active);
 	virtual void init();
-	virtual void step(real_t p_step);
+	virtual void step(float p_step);
 	virtual void sync();
 	virtual void flush_queries();
 	virtual void end_sync();
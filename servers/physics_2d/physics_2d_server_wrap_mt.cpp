@@ -70,7 +70,7 @@ void Physics2DServerWrapMT::thread_loop() {
 
 /* EVENT QUEUING */
 
-void Physics2DServerWrapMT::step(real_t p_step) {
+void Physics2DServerWrapMT::step(float p_step) {
 
 	if (create_thread) {
 
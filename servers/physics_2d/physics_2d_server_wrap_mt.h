@@ -214,8 +214,8 @@ public:
 	FUNC2(body_set_collision_mask, RID, uint32_t);
 	FUNC1RC(uint32_t, body_get_collision_mask, RID);
 
-	FUNC3(body_set_param, RID, BodyParameter, real_t);
-	FUNC2RC(real_t, body_get_param, RID, BodyParameter);
+	FUNC3(body_set_param, RID, BodyParameter, float);
+	FUNC2RC(float, body_get_param, RID, BodyParameter);
 
 	FUNC3(body_set_state, RID, BodyState, const Variant &);
 	FUNC2RC(Variant, body_get_state, RID, BodyState);
@@ -223,14 +223,14 @@ public:
 	FUNC2(body_set_applied_force, RID, const Vector2 &);
 	FUNC1RC(Vector2, body_get_applied_force, RID);
 
-	FUNC2(body_set_applied_torque, RID, real_t);
-	FUNC1RC(real_t, body_get_applied_torque, RID);
+	FUNC2(body_set_applied_torque, RID, float);
+	FUNC1RC(float, body_get_applied_torque, RID);
 
 	FUNC2(body_add_central_force, RID, const Vector2 &);
 	FUNC3(body_add_force, RID, const Vector2 &, const Vector2 &);
-	FUNC2(body_add_torque, RID, real_t);
+	FUNC2(body_add_torque, RID, float);
 	FUNC2(body_apply_central_impulse, RID, const Vector2 &);
-	FUNC2(body_apply_torque_impulse, RID, real_t);
+	FUNC2(body_apply_torque_impulse, RID, float);
 	FUNC3(body_apply_impulse, RID, const Vector2 &, const Vector2 &);
 	FUNC2(body_set_axis_velocity, RID, const Vector2 &);
 
@@ -241,8 +241,8 @@ public:
 	FUNC2(body_set_max_contacts_reported, RID, int);
 	FUNC1RC(int, body_get_max_contacts_reported, RID);
 
-	FUNC2(body_set_contacts_reported_depth_threshold, RID, real_t);
-	FUNC1RC(real_t, body_get_contacts_reported_depth_threshold, RID);
+	FUNC2(body_set_contacts_reported_depth_threshold, RID, float);
+	FUNC1RC(float, body_get_contacts_reported_depth_threshold, RID);
 
 	FUNC2(body_set_omit_force_integration, RID, bool);
 	FUNC1RC(bool, body_is_omitting_force_integration, RID);
@@ -255,7 +255,7 @@ public:
 
 	FUNC2(body_set_pickable, RID, bool);
 
-	bool body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin = 0.001, MotionResult *r_result = NULL, bool p_exclude_raycast_shapes = true) {
+	bool body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, float p_margin = 0.001, MotionResult *r_result = NULL, bool p_exclude_raycast_shapes = true) {
 
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), false);
 		return physics_2d_server->body_test_motion(p_body, p_from, p_motion, p_infinite_inertia, p_margin, r_result, p_exclude_raycast_shapes);
@@ -306,7 +306,7 @@ public:
 	FUNC1(set_active, bool);
 
 	virtual void init();
-	virtual void step(real_t p_step);
+	virtual void step(float p_step);
 	virtual void sync();
 	virtual void end_sync();
 	virtual void flush_queries();